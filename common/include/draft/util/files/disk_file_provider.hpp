@@ -28,6 +28,7 @@ namespace Draft {
 
         std::vector<std::byte> read_bytes(const std::filesystem::path& path, std::size_t offset) const override;
         void write_bytes(const std::filesystem::path& path, const void* data, std::size_t size) const override;
+        void append_bytes(const std::filesystem::path& path, const void* data, std::size_t size) const override;
 
         std::vector<std::filesystem::path> list(const std::filesystem::path& path) const override;
 
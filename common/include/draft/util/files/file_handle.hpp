@@ -138,6 +138,11 @@ namespace Draft {
          */
         void write_bytes(const void* data, std::size_t size) const;
 
+        /**
+         * @brief Appends raw data to the end of the file, creating it if needed.
+         */
+        void append_bytes(const void* data, std::size_t size) const;
+
         /**
          * @brief Lists all files and directories in this directory.
          */
@@ -95,6 +95,13 @@ namespace Draft {
          */
         virtual void write_bytes(const std::filesystem::path& path, const void* data, std::size_t size) const = 0;
 
+        /**
+         * @brief Appends @p size bytes from @p data to the end of @p path, creating it if it
+         * doesn't exist yet, if this provider supports mutation. Lets a large file be written a
+         * piece at a time instead of being assembled in memory first.
+         */
+        virtual void append_bytes(const std::filesystem::path& path, const void* data, std::size_t size) const = 0;
+
         /**
          * @brief Lists the entries directly inside the directory at @p path.
          * @return Paths of each entry, or an empty vector if @p path is not a directory.
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "draft/util/files/file_handle.hpp"
+#include "draft/util/json.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Draft {
+    /**
+     * @brief Writes one JSON document to a file piece by piece, so a document too large to want
+     * as a single JSON value (e.g. a whole scene) never exists in memory all at once. Structure
+     * is written with begin_object()/key()/end_object() and friends, anything small enough to
+     * hold whole is written with value().
+     *
+     * Text is buffered and appended to the file every few dozen KiB, the first write truncating
+     * it. A writer that throws or is destroyed before finish() leaves a partial file behind.
+     */
+    class JSONStreamWriter {
+    public:
+        /**
+         * @param indent Spaces per nesting level, matching JSON::dump(indent). Negative writes
+         * compact output with no whitespace at all.
+         */
+        explicit JSONStreamWriter(const FileHandle& file, int indent = 4);
+
+        JSONStreamWriter(const JSONStreamWriter&) = delete;
+        JSONStreamWriter& operator=(const JSONStreamWriter&) = delete;
+
+        void begin_object();
+        void end_object();
+        void begin_array();
+        void end_array();
+
+        /**
+         * @brief Names the next member of the current object.
+         */
+        void key(std::string_view name);
+
+        /**
+         * @brief Writes @p json whole, as the next array element or as the value of the last key().
+         */
+        void value(const JSON& json);
+
+        /**
+         * @brief Writes out whatever is still buffered. The document must be complete.
+         * @throws std::logic_error if a container is still open.
+         */
+        void finish();
+
+    private:
+        struct Level {
+            bool isObject = false;
+            std::size_t count = 0;
+        };
+
+        FileHandle m_file;
+        int m_indent;
+        std::string m_buffer;
+        std::vector<Level> m_levels;
+        bool m_afterKey = false;
+        bool m_written = false;
+
+        void separate();
+        void newline(std::size_t depth);
+        void close(bool isObject);
+        void flush_if_full();
+        void flush();
+    };
+
+    /**
+     * @brief Reads a JSON document without building it whole: only the pieces handed to the
+     * callback exist as JSON values, one at a time.
+     *
+     * The root must be an object. Each of its members whose value is an array is split into its
+     * elements, @p onElement being called once per element in document order with the member's
+     * key. Any other member is passed to @p onElement whole. The JSON passed in may be moved from.
+     * @return The root's keys in document order, including any whose (empty) array produced no
+     * call at all.
+     * @throws nlohmann::json::parse_error on malformed text.
+     * @throws std::runtime_error if the root isn't an object.
+     */
+    std::vector<std::string> read_json_stream(std::string_view text, const std::function<void(const std::string& key, JSON& element)>& onElement);
+}
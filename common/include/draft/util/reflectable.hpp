@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <tuple>
 #include <typeindex>
@@ -62,26 +66,122 @@ namespace Draft {
         }, T::reflect());
     }
 
+    /**
+     * @brief How many fields T's DRAFT_REFLECTABLE(...) lists.
+     */
+    template<Reflectable T>
+    constexpr std::size_t field_count(){
+        return std::tuple_size_v<decltype(T::reflect())>;
+    }
+
+    namespace Detail {
+        // FNV-1a, constexpr so each type's name table is built at compile time
+        constexpr std::uint64_t hash_field_name(std::string_view name){
+            std::uint64_t hash = 14695981039346656037ull;
+            for(char c : name){
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+        // Field names in declaration order, plus an open-addressed hash table over them that's
+        // at most half full, each slot holding a field index + 1 (0 being empty)
+        template<std::size_t Count>
+        struct FieldNameTable {
+            std::array<std::string_view, Count> names{};
+            std::array<std::size_t, std::bit_ceil(Count * 2 + 1)> slots{};
+        };
+
+        template<Reflectable T>
+        constexpr auto build_field_name_table(){
+            FieldNameTable<field_count<T>()> table{};
+            const std::size_t mask = table.slots.size() - 1;
+
+            std::size_t next = 0;
+            std::apply([&](const auto&... field){ ((table.names[next++] = field.name), ...); }, T::reflect());
+
+            for(std::size_t i = 0; i < table.names.size(); i++){
+                std::size_t slot = hash_field_name(table.names[i]) & mask;
+                while(table.slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+
+                table.slots[slot] = i + 1;
+            }
+
+            return table;
+        }
+
+        template<Reflectable T>
+        inline constexpr auto fieldNameTable = build_field_name_table<T>();
+
+        template<Reflectable T>
+        inline constexpr auto reflectedFields = T::reflect();
+
+        // One function per field, indexed by field index, so picking a field is a single call
+        template<typename Instance, typename Visitor, std::size_t... I>
+        constexpr void visit_field_at(Instance& instance, std::size_t index, Visitor& visitor, std::index_sequence<I...>){
+            using T = std::remove_const_t<Instance>;
+            using Thunk = void(*)(Instance&, Visitor&);
+
+            if constexpr(sizeof...(I) > 0){
+                constexpr Thunk thunks[] = {
+                    [](Instance& instance, Visitor& visitor){ visitor(std::get<I>(reflectedFields<T>).get(instance)); }...
+                };
+
+                thunks[index](instance, visitor);
+            }
+        }
+    }
+
+    /**
+     * @brief Declaration-order index of T's reflected field named @p name, or field_count<T>()
+     * if T has none. A hash lookup, so its cost doesn't grow with the number of fields.
+     */
+    template<Reflectable T>
+    constexpr std::size_t field_index(std::string_view name){
+        const auto& table = Detail::fieldNameTable<T>;
+        const std::size_t mask = table.slots.size() - 1;
+
+        for(std::size_t slot = Detail::hash_field_name(name) & mask; table.slots[slot] != 0; slot = (slot + 1) & mask){
+            std::size_t index = table.slots[slot] - 1;
+            if(table.names[index] == name)
+                return index;
+        }
+
+        return field_count<T>();
+    }
+
+    /**
+     * @brief Calls `visitor(valueRef)` for the reflected field of @p instance at declaration-order
+     * @p index, which must be below field_count<T>() (see field_index()).
+     */
+    template<Reflectable T, typename Visitor>
+    constexpr void visit_field_at(T& instance, std::size_t index, Visitor&& visitor){
+        Detail::visit_field_at(instance, index, visitor, std::make_index_sequence<field_count<T>()>{});
+    }
+
+    /**
+     * @brief Const-instance overload of visit_field_at().
+     */
+    template<Reflectable T, typename Visitor>
+    constexpr void visit_field_at(const T& instance, std::size_t index, Visitor&& visitor){
+        Detail::visit_field_at(instance, index, visitor, std::make_index_sequence<field_count<T>()>{});
+    }
+
     /**
      * @brief Calls `visitor(valueRef)` for the reflected field of @p instance named @p name.
      * @return True if a field named @p name was found (and visited), false otherwise.
      */
     template<Reflectable T, typename Visitor>
     constexpr bool visit_field(T& instance, std::string_view name, Visitor&& visitor){
-        bool found = false;
-
-        std::apply([&](auto&&... field){
-            auto try_visit = [&](const auto& f){
-                if(f.name == name){
-                    visitor(f.get(instance));
-                    found = true;
-                }
-            };
-
-            (try_visit(field), ...);
-        }, T::reflect());
+        std::size_t index = field_index<T>(name);
+        if(index == field_count<T>())
+            return false;
 
-        return found;
+        visit_field_at(instance, index, visitor);
+        return true;
     }
 
     /**
@@ -89,20 +189,12 @@ namespace Draft {
      */
     template<Reflectable T, typename Visitor>
     constexpr bool visit_field(const T& instance, std::string_view name, Visitor&& visitor){
-        bool found = false;
-
-        std::apply([&](auto&&... field){
-            auto try_visit = [&](const auto& f){
-                if(f.name == name){
-                    visitor(f.get(instance));
-                    found = true;
-                }
-            };
-
-            (try_visit(field), ...);
-        }, T::reflect());
+        std::size_t index = field_index<T>(name);
+        if(index == field_count<T>())
+            return false;
 
-        return found;
+        visit_field_at(instance, index, visitor);
+        return true;
     }
 
     /**
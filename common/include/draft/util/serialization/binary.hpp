@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
+#include <cstddef>
 #include <cstring>
 #include <span>
 #include <stdexcept>
@@ -97,5 +99,168 @@ namespace Draft {
             // Advance the span for ease of use if its modifiable
             span = span.subspan(sizeof(T));
         }
+
+        /**
+         * @brief Appends to a caller-owned ByteArray, growing it geometrically and never
+         * shrinking it, so one arena can be clear()ed and reused across many writes.
+         *
+         * A length that's only known once what it measures has been written is reserved as a
+         * placeholder() first and back-patched afterwards, instead of writing the contents into
+         * a temporary buffer just to measure and copy them.
+         */
+        class Writer {
+        public:
+            explicit Writer(ByteArray& arena) : m_arena(arena) {}
+
+            /**
+             * @brief The arena itself, for anything that appends to a ByteArray directly (e.g.
+             * Serializer::serialize()).
+             */
+            ByteArray& buffer(){ return m_arena; }
+
+            std::size_t size() const { return m_arena.size(); }
+
+            /**
+             * @brief Makes room for at least @p extra more bytes without giving up geometric
+             * growth, so calling this before every small write stays amortized O(1).
+             */
+            void reserve(std::size_t extra){
+                std::size_t needed = m_arena.size() + extra;
+                if(needed > m_arena.capacity())
+                    m_arena.reserve(std::max(needed, m_arena.capacity() * 2));
+            }
+
+            /**
+             * @brief Grows the arena by @p count bytes and returns them, to be filled in place.
+             * The span is only valid until the arena next grows.
+             */
+            ByteSpan extend(std::size_t count){
+                std::size_t offset = m_arena.size();
+                reserve(count);
+                m_arena.resize(offset + count);
+                return ByteSpan(m_arena).subspan(offset, count);
+            }
+
+            /**
+             * @brief Appends @p value in little-endian byte order, same encoding as write().
+             */
+            template<typename T>
+            void write(const T& value){
+                static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+                T littleEndian = to_little_endian(value);
+                std::memcpy(extend(sizeof(T)).data(), &littleEndian, sizeof(T));
+            }
+
+            void write_bytes(ByteView bytes){
+                if(!bytes.empty())
+                    std::memcpy(extend(bytes.size()).data(), bytes.data(), bytes.size());
+            }
+
+            /**
+             * @brief Writes a zeroed T to be filled in later by patch() or patch_size().
+             * @return Its offset into the arena.
+             */
+            template<typename T>
+            std::size_t placeholder(){
+                std::size_t offset = m_arena.size();
+                write(T{});
+                return offset;
+            }
+
+            /**
+             * @brief Overwrites the T at @p offset (see placeholder()) with @p value.
+             * @throws std::out_of_range if it would run past the end of the arena.
+             */
+            template<typename T>
+            void patch(std::size_t offset, T value){
+                static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+                if(offset + sizeof(T) > m_arena.size())
+                    throw std::out_of_range("Writer::patch() out of bounds");
+
+                value = to_little_endian(value);
+                std::memcpy(m_arena.data() + offset, &value, sizeof(T));
+            }
+
+            /**
+             * @brief Patches the placeholder<T>() at @p offset with the number of bytes written
+             * since it, making it the length prefix of everything after it.
+             */
+            template<typename T>
+            void patch_size(std::size_t offset){
+                patch(offset, static_cast<T>(m_arena.size() - offset - sizeof(T)));
+            }
+
+        private:
+            ByteArray& m_arena;
+        };
+
+        /**
+         * @brief Reads front to back through bytes it doesn't own, handing out sub-views of them
+         * rather than copies. Every read is bounds-checked.
+         */
+        class Reader {
+        public:
+            explicit Reader(ByteView bytes) : m_span(bytes) {}
+
+            /**
+             * @brief What's left to read, advanced by everything else here. Anything taking a
+             * ByteView& to read and advance through (e.g. Serializer::deserialize_and_advance())
+             * can be handed this directly.
+             */
+            ByteView& view(){ return m_span; }
+
+            std::size_t remaining() const { return m_span.size(); }
+            bool empty() const { return m_span.empty(); }
+
+            /**
+             * @brief Reads a little-endian @p T, see read().
+             * @throws std::runtime_error if fewer than sizeof(T) bytes are left.
+             */
+            template<typename T>
+            T read(){
+                T value{};
+                read_and_advance(m_span, value);
+                return value;
+            }
+
+            template<typename T>
+            void read(T& value){
+                read_and_advance(m_span, value);
+            }
+
+            /**
+             * @brief The next @p count bytes, without copying them.
+             * @throws std::runtime_error if fewer than @p count bytes are left.
+             */
+            ByteView bytes(std::size_t count){
+                if(count > m_span.size())
+                    throw std::runtime_error("Reader::bytes() out of bounds");
+
+                ByteView result = m_span.subspan(0, count);
+                m_span = m_span.subspan(count);
+                return result;
+            }
+
+            /**
+             * @brief Reads a @p Size length prefix, then that many bytes, the counterpart of a
+             * Writer::placeholder<Size>() filled in by Writer::patch_size<Size>().
+             */
+            template<typename Size>
+            ByteView sized(){
+                Size size = read<Size>();
+                if(size > m_span.size())
+                    throw std::runtime_error("Reader::sized() out of bounds");
+
+                return bytes(static_cast<std::size_t>(size));
+            }
+
+            void skip(std::size_t count){
+                bytes(count);
+            }
+
+        private:
+            ByteView m_span;
+        };
     }
 }
\ No newline at end of file
@@ -7,7 +7,10 @@
 #include "draft/util/serialization/binary.hpp"
 
 #include <concepts>
+#include <cstddef>
+#include <span>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 namespace Draft {
@@ -300,12 +303,22 @@ namespace Draft {
 
         template<typename T, JsonLike J> requires Reflectable<T> && (!JsonSerializable<T>) && (!CustomJsonSerializable<T>)
         inline void deserialize(T& value, J&& json){
-            for_each_field(value, [&](std::string_view name, auto& field){
-                std::string key(name);
-                
-                if(json.contains(key))
-                    deserialize(field, json.at(key));
-            });
+            using Element = std::conditional_t<std::is_const_v<std::remove_reference_t<J>>, const JSON, JSON>;
+
+            if(!json.is_object())
+                return;
+
+            // Walks the keys present rather than the fields, each found through T's hashed name
+            // table, instead of a lookup into json per field
+            for(auto it = json.begin(); it != json.end(); ++it){
+                std::size_t index = field_index<T>(it.key());
+                if(index == field_count<T>())
+                    continue;
+
+                visit_field_at(value, index, [&](auto& field){
+                    deserialize(field, static_cast<Element&>(*it));
+                });
+            }
         }
 
 
@@ -338,9 +351,7 @@ namespace Draft {
 
             std::string text = json.dump();
             serialize(text.size(), out);
-            out.insert(out.end(),
-                reinterpret_cast<const std::byte*>(text.data()),
-                reinterpret_cast<const std::byte*>(text.data()) + text.size());
+            Binary::Writer(out).write_bytes(std::as_bytes(std::span(text)));
         }
 
         template<JsonBinaryFallback T>
@@ -375,6 +386,55 @@ namespace Draft {
             Binary::ByteArray bytes = base64_decode(json.template get<std::string>());
             deserialize(value, Binary::ByteView(bytes));
         }
+
+        namespace Detail {
+            // Whether T's Binary encoding is exactly its object representation, recursing
+            // through reflected fields. A reflectable T only qualifies if its fields are reflected
+            // in declaration order with no padding in between, checked against a probe instance
+            // since member offsets aren't available at compile time.
+            template<typename T>
+            bool matches_object_layout(){
+                if constexpr(BinarySerializable<T> || CustomBinarySerializable<T>){
+                    return false;
+                } else if constexpr(Reflectable<T>){
+                    if constexpr(!std::is_trivially_copyable_v<T> || !std::is_default_constructible_v<T>){
+                        return false;
+                    } else {
+                        T probe{};
+                        const auto* base = reinterpret_cast<const std::byte*>(&probe);
+                        std::size_t expected = 0;
+                        bool packed = true;
+
+                        std::apply([&](const auto&... field){
+                            auto check = [&](const auto& f){
+                                using Value = typename std::remove_cvref_t<decltype(f)>::ValueType;
+                                auto offset = static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&f.get(probe)) - base);
+
+                                packed = packed && offset == expected && matches_object_layout<Value>();
+                                expected += sizeof(Value);
+                            };
+
+                            (check(field), ...);
+                        }, T::reflect());
+
+                        return packed && expected == sizeof(T);
+                    }
+                } else {
+                    return TriviallySerializable<T>;
+                }
+            }
+        }
+
+        /**
+         * @brief True if serialize(value, out) on a T is byte-for-byte a copy of value's own
+         * memory, so an array of T can be encoded and decoded with a single memcpy. Only ever
+         * true on little-endian hosts, since the trivial tier byte-swaps integers elsewhere.
+         */
+        template<typename T>
+        bool is_bulk_copyable(){
+            static const bool result = Binary::IS_LITTLE_ENDIAN && Detail::matches_object_layout<T>();
+            return result;
+        }
     };
 };
 
@@ -3,9 +3,12 @@
 #include "draft/util/serialization/custom.hpp"
 #include "draft/util/serialization/serializer.hpp"
 #include <cstddef>
+#include <cstring>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -16,9 +19,7 @@ struct Draft::Serializer::CustomSerializer<std::string> {
     // via JsonTrivial, no specialization needed there).
     static void serialize(const std::string& value, Binary::ByteArray& out){
         Serializer::serialize(value.size(), out);
-        out.insert(out.end(),
-            reinterpret_cast<const std::byte*>(value.data()),
-            reinterpret_cast<const std::byte*>(value.data()) + value.size());
+        Binary::Writer(out).write_bytes(std::as_bytes(std::span(value)));
     }
 
     static void deserialize(std::string& value, Binary::ByteView span){
@@ -43,6 +44,16 @@ struct Draft::Serializer::CustomSerializer<std::vector<K>> {
         // Serialize a vector array, starting with the size
         Serializer::serialize(array.size(), out);
 
+        // Elements encoded as their own memory go out in one copy (vector<bool> has no memory to copy)
+        if constexpr(!std::is_same_v<K, bool>){
+            if(Serializer::is_bulk_copyable<K>()){
+                Binary::Writer(out).write_bytes(std::as_bytes(std::span(array)));
+                return;
+            }
+        }
+
+        Binary::Writer(out).reserve(array.size() * sizeof(K));
+
         for(auto& val : array){
             Serializer::serialize(val, out);
         }
@@ -57,6 +68,18 @@ struct Draft::Serializer::CustomSerializer<std::vector<K>> {
         size_t size = 0;
         Serializer::deserialize_and_advance(size, span);
 
+        if constexpr(!std::is_same_v<K, bool>){
+            if(Serializer::is_bulk_copyable<K>()){
+                if(size > span.size() / sizeof(K))
+                    throw std::runtime_error("deserialize(std::vector) out of bounds");
+
+                array.resize(size);
+                std::memcpy(array.data(), span.data(), size * sizeof(K));
+                span = span.subspan(size * sizeof(K));
+                return;
+            }
+        }
+
         array.clear();
         array.reserve(size);
 
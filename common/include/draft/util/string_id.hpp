@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Draft {
+    /**
+     * @brief A 32-bit hash standing in for a string (an action name, a component type name, an
+     * animation tag) wherever that string is only ever compared for equality. Hashing a literal
+     * happens at compile time (see `_sid`), so looking something up by StringId costs no
+     * allocation or string hashing per call.
+     *
+     * The hash alone doesn't remember the string. Anything that registers a name (e.g.
+     * InputManager::bind_default()) passes it through intern() instead, which records it so
+     * str() can recover it later, and in debug builds throws if two different strings ever
+     * intern to the same id.
+     */
+    class StringId {
+    public:
+        /**
+         * @brief The id of the empty string.
+         */
+        constexpr StringId() = default;
+
+        /**
+         * @brief Hashes @p string without interning it.
+         */
+        constexpr explicit StringId(std::string_view string) : m_value(hash(string)) {}
+
+        /**
+         * @brief Hashes @p string and records it against its id, see str().
+         * @throws std::logic_error in debug builds if a different string already interned to the same id.
+         */
+        static StringId intern(std::string_view string);
+
+        /**
+         * @brief The string this id was interned from, or an empty string if it never was.
+         */
+        const std::string& str() const;
+
+        constexpr std::uint32_t value() const { return m_value; }
+
+        constexpr bool operator==(const StringId& other) const = default;
+        constexpr auto operator<=>(const StringId& other) const = default;
+
+    private:
+        // FNV-1a
+        static constexpr std::uint32_t hash(std::string_view string){
+            std::uint32_t value = 2166136261u;
+            for(char c : string){
+                value ^= static_cast<unsigned char>(c);
+                value *= 16777619u;
+            }
+
+            return value;
+        }
+
+        std::uint32_t m_value = hash({});
+    };
+
+    /**
+     * @brief Literal suffix for a compile-time StringId, e.g. `input.is_pressed("Jump"_sid)`.
+     */
+    consteval StringId operator""_sid(const char* string, std::size_t length){
+        return StringId(std::string_view(string, length));
+    }
+}
+
+template<>
+struct std::hash<Draft::StringId> {
+    std::size_t operator()(const Draft::StringId& id) const noexcept {
+        // Already a well-mixed hash
+        return id.value();
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Draft {
+    /**
+     * @brief A fixed set of worker threads draining a shared FIFO of fire-and-forget tasks.
+     *
+     * Unlike AssetManager's job runner there is no main-thread finish stage here, a task is
+     * just a callable. Callers that need to know when a batch is done either use
+     * parallel_for() (which blocks until every index ran) or track completion themselves.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Starts @p workerCount worker threads. Zero is allowed, submit() then runs
+         * each task inline on the calling thread instead.
+         */
+        explicit ThreadPool(std::size_t workerCount);
+
+        /**
+         * @brief Runs every already-submitted task to completion, then joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        std::size_t worker_count() const { return m_workers.size(); }
+
+        /**
+         * @brief Queues @p task to run on some worker. Tasks must not throw, there is nobody
+         * to hand the exception to.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Calls @p fn(i) for every i in [0, @p count), spread across the workers and
+         * the calling thread, and returns once all of them finished.
+         * @throws The first exception any call of @p fn threw, after every index was visited.
+         */
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+    private:
+        void worker_loop(std::stop_token token);
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_cv;
+        std::deque<std::function<void()>> m_pending;
+
+        // Declared last so it's destroyed (stopped + joined) first.
+        std::vector<std::jthread> m_workers;
+    };
+}
@@ -138,6 +138,10 @@ namespace Draft {
         throw std::logic_error("ArchiveFileProvider: cannot write to '" + path.string() + "', archives are read-only");
     }
 
+    void ArchiveFileProvider::append_bytes(const fs::path& path, const void*, std::size_t) const {
+        throw std::logic_error("ArchiveFileProvider: cannot write to '" + path.string() + "', archives are read-only");
+    }
+
     std::vector<fs::path> ArchiveFileProvider::list(const fs::path& path) const {
         if (!is_directory(path)) return {};
 
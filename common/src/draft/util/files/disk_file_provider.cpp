@@ -85,6 +85,13 @@ namespace Draft {
         out.write(reinterpret_cast<const char*>(data), size);
     }
 
+    void DiskFileProvider::append_bytes(const fs::path& path, const void* data, std::size_t size) const {
+        create_directories(path);
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        if (!out) throw std::runtime_error("DiskFileProvider: failed to open '" + path.string() + "' for appending");
+        out.write(reinterpret_cast<const char*>(data), size);
+    }
+
     std::vector<fs::path> DiskFileProvider::list(const fs::path& path) const {
         if (!fs::is_directory(path)) return {};
 
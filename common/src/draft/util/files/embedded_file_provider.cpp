@@ -73,6 +73,10 @@ namespace Draft {
         throw std::logic_error("EmbeddedFileProvider: cannot write to '" + path.string() + "', embedded resources are read-only");
     }
 
+    void EmbeddedFileProvider::append_bytes(const fs::path& path, const void*, std::size_t) const {
+        throw std::logic_error("EmbeddedFileProvider: cannot write to '" + path.string() + "', embedded resources are read-only");
+    }
+
     std::vector<fs::path> EmbeddedFileProvider::list(const fs::path& path) const {
         if (!is_directory(path)) return {};
 
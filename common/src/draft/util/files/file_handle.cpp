@@ -99,6 +99,10 @@ namespace Draft {
         m_provider->write_bytes(m_path, data, size);
     }
 
+    void FileHandle::append_bytes(const void* data, std::size_t size) const {
+        m_provider->append_bytes(m_path, data, size);
+    }
+
     std::vector<FileHandle> FileHandle::list() const {
         std::vector<FileHandle> result;
         for (const auto& entryPath : m_provider->list(m_path)) {
@@ -74,6 +74,11 @@ namespace Draft {
         s_lastWriteTime[path.string()] = fs::file_time_type::clock::now();
     }
 
+    void MemoryFileProvider::append_bytes(const fs::path& path, const void* data, std::size_t size) const {
+        s_contents[path.string()].append(reinterpret_cast<const char*>(data), size);
+        s_lastWriteTime[path.string()] = fs::file_time_type::clock::now();
+    }
+
     std::vector<fs::path> MemoryFileProvider::list(const fs::path& path) const {
         std::vector<fs::path> result;
         for (const auto& [key, value] : s_contents) {
@@ -0,0 +1,262 @@
+#include "draft/util/json_stream.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Draft {
+    namespace {
+        // Buffered text past which the writer hands what it has to the file
+        constexpr std::size_t FLUSH_SIZE = 64 * 1024;
+
+        // SAX handler behind read_json_stream(). Walks the root object and its array members
+        // itself, and builds a JSON value only for each piece it hands out.
+        class SplittingSax {
+        public:
+            using json = nlohmann::json;
+
+            explicit SplittingSax(const std::function<void(const std::string&, JSON&)>& onElement) : m_onElement(onElement) {}
+
+            bool null(){ return put(json(nullptr), false); }
+            bool boolean(bool value){ return put(json(value), false); }
+            bool number_integer(json::number_integer_t value){ return put(json(value), false); }
+            bool number_unsigned(json::number_unsigned_t value){ return put(json(value), false); }
+            bool number_float(json::number_float_t value, const json::string_t&){ return put(json(value), false); }
+            bool string(json::string_t& value){ return put(json(std::move(value)), false); }
+            bool binary(json::binary_t& value){ return put(json::binary(std::move(value)), false); }
+
+            bool start_object(std::size_t){
+                if(capturing())
+                    return put(json::object(), true);
+
+                if(m_depth == 0){
+                    m_depth = 1;
+                    return true;
+                }
+
+                return put(json::object(), true);
+            }
+
+            bool key(json::string_t& key){
+                if(capturing()){
+                    m_member = &(*m_stack.back())[key];
+                    return true;
+                }
+
+                m_key = std::move(key);
+                m_keys.push_back(m_key);
+                return true;
+            }
+
+            bool end_object(){
+                if(capturing())
+                    return end_container();
+
+                m_depth = 0;
+                return true;
+            }
+
+            bool start_array(std::size_t){
+                // A root member's array is split rather than captured
+                if(!capturing() && m_depth == 1){
+                    m_depth = 2;
+                    return true;
+                }
+
+                return put(json::array(), true);
+            }
+
+            bool end_array(){
+                if(capturing())
+                    return end_container();
+
+                m_depth = 1;
+                return true;
+            }
+
+            std::vector<std::string>& keys(){ return m_keys; }
+
+            template<typename Exception>
+            bool parse_error(std::size_t, const std::string&, const Exception& ex){
+                throw ex;
+            }
+
+        private:
+            const std::function<void(const std::string&, JSON&)>& m_onElement;
+
+            // 0 outside the root, 1 inside it, 2 inside one of its array members
+            int m_depth = 0;
+            std::string m_key;
+            std::vector<std::string> m_keys;
+
+            // The piece being built, and the containers open inside it
+            JSON m_value;
+            std::vector<json*> m_stack;
+            json* m_member = nullptr;
+
+            bool capturing() const { return !m_stack.empty(); }
+
+            bool put(json&& value, bool container){
+                if(!capturing() && m_depth == 0)
+                    throw std::runtime_error("read_json_stream(): root is not an object");
+
+                json* slot = nullptr;
+
+                if(!capturing()){
+                    m_value = std::move(value);
+                    slot = &m_value;
+                } else if(m_stack.back()->is_array()){
+                    m_stack.back()->push_back(std::move(value));
+                    slot = &m_stack.back()->back();
+                } else {
+                    *m_member = std::move(value);
+                    slot = m_member;
+                }
+
+                if(container)
+                    m_stack.push_back(slot);
+                else if(!capturing())
+                    deliver();
+
+                return true;
+            }
+
+            bool end_container(){
+                m_stack.pop_back();
+                if(!capturing())
+                    deliver();
+
+                return true;
+            }
+
+            void deliver(){
+                m_onElement(m_key, m_value);
+                m_value = JSON();
+            }
+        };
+    }
+
+    JSONStreamWriter::JSONStreamWriter(const FileHandle& file, int indent) : m_file(file), m_indent(indent) {
+        m_buffer.reserve(FLUSH_SIZE * 2);
+    }
+
+    void JSONStreamWriter::begin_object(){
+        separate();
+        m_buffer += '{';
+        m_levels.push_back(Level{true, 0});
+    }
+
+    void JSONStreamWriter::end_object(){
+        close(true);
+    }
+
+    void JSONStreamWriter::begin_array(){
+        separate();
+        m_buffer += '[';
+        m_levels.push_back(Level{false, 0});
+    }
+
+    void JSONStreamWriter::end_array(){
+        close(false);
+    }
+
+    void JSONStreamWriter::key(std::string_view name){
+        if(m_levels.empty() || !m_levels.back().isObject || m_afterKey)
+            throw std::logic_error("JSONStreamWriter::key(): not directly inside an object");
+
+        separate();
+        m_buffer += nlohmann::json(std::string(name)).dump();
+        m_buffer += m_indent < 0 ? ":" : ": ";
+        m_afterKey = true;
+    }
+
+    void JSONStreamWriter::value(const JSON& json){
+        if(!m_levels.empty() && m_levels.back().isObject && !m_afterKey)
+            throw std::logic_error("JSONStreamWriter::value(): an object member needs a key() first");
+
+        separate();
+        std::string text = json.dump(m_indent);
+
+        if(m_indent < 0 || m_levels.empty()){
+            m_buffer += text;
+        } else {
+            // Shift the value's own lines to this depth. A raw newline can only be whitespace,
+            // inside a string it's always escaped
+            std::string padding(m_levels.size() * m_indent, ' ');
+
+            for(char c : text){
+                m_buffer += c;
+                if(c == '\n')
+                    m_buffer += padding;
+            }
+        }
+
+        flush_if_full();
+    }
+
+    void JSONStreamWriter::finish(){
+        if(!m_levels.empty() || m_afterKey)
+            throw std::logic_error("JSONStreamWriter::finish(): document is incomplete");
+
+        flush();
+    }
+
+    void JSONStreamWriter::separate(){
+        if(m_afterKey){
+            m_afterKey = false;
+            return;
+        }
+
+        if(m_levels.empty())
+            return;
+
+        if(m_levels.back().count++ > 0)
+            m_buffer += ',';
+
+        newline(m_levels.size());
+    }
+
+    void JSONStreamWriter::newline(std::size_t depth){
+        if(m_indent < 0)
+            return;
+
+        m_buffer += '\n';
+        m_buffer.append(depth * m_indent, ' ');
+    }
+
+    void JSONStreamWriter::close(bool isObject){
+        if(m_levels.empty() || m_levels.back().isObject != isObject || m_afterKey)
+            throw std::logic_error(isObject ? "JSONStreamWriter::end_object(): no object to end" : "JSONStreamWriter::end_array(): no array to end");
+
+        bool hasItems = m_levels.back().count > 0;
+        m_levels.pop_back();
+
+        // Empty containers stay on one line, same as JSON::dump()
+        if(hasItems)
+            newline(m_levels.size());
+
+        m_buffer += isObject ? '}' : ']';
+        flush_if_full();
+    }
+
+    void JSONStreamWriter::flush_if_full(){
+        if(m_buffer.size() >= FLUSH_SIZE)
+            flush();
+    }
+
+    void JSONStreamWriter::flush(){
+        if(m_written){
+            m_file.append_bytes(m_buffer.data(), m_buffer.size());
+        } else {
+            m_file.write_bytes(m_buffer.data(), m_buffer.size());
+            m_written = true;
+        }
+
+        m_buffer.clear();
+    }
+
+    std::vector<std::string> read_json_stream(std::string_view text, const std::function<void(const std::string& key, JSON& element)>& onElement){
+        SplittingSax sax(onElement);
+        nlohmann::json::sax_parse(text, &sax);
+        return std::move(sax.keys());
+    }
+}
@@ -0,0 +1,46 @@
+#include "draft/util/string_id.hpp"
+
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Draft {
+    namespace {
+        // Every interned string by id. Node-based, so a reference str() hands out stays valid
+        // however much is interned after it.
+        struct Interner {
+            std::mutex mutex;
+            std::unordered_map<StringId, std::string> strings;
+        };
+
+        Interner& interner(){
+            static Interner instance;
+            return instance;
+        }
+
+        const std::string EMPTY_STRING;
+    }
+
+    StringId StringId::intern(std::string_view string){
+        StringId id(string);
+        Interner& table = interner();
+
+        std::lock_guard lock(table.mutex);
+        [[maybe_unused]] auto [it, inserted] = table.strings.try_emplace(id, string);
+
+#ifndef NDEBUG
+        if(!inserted && it->second != string)
+            throw std::logic_error("StringId::intern(): '" + std::string(string) + "' collides with '" + it->second + "'");
+#endif
+
+        return id;
+    }
+
+    const std::string& StringId::str() const {
+        Interner& table = interner();
+
+        std::lock_guard lock(table.mutex);
+        auto it = table.strings.find(*this);
+        return it == table.strings.end() ? EMPTY_STRING : it->second;
+    }
+}
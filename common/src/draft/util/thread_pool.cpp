@@ -0,0 +1,106 @@
+#include "draft/util/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace Draft {
+    ThreadPool::ThreadPool(std::size_t workerCount){
+        m_workers.reserve(workerCount);
+
+        for(std::size_t i = 0; i < workerCount; i++)
+            m_workers.emplace_back([this](std::stop_token token){ worker_loop(token); });
+    }
+
+    ThreadPool::~ThreadPool(){
+        for(auto& worker : m_workers)
+            worker.request_stop();
+
+        m_cv.notify_all();
+        // std::jthread's destructor joins each worker, which only exits once m_pending is
+        // drained, so every already-submitted task still runs.
+    }
+
+    void ThreadPool::submit(std::function<void()> task){
+        if(m_workers.empty()){
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_pending.push_back(std::move(task));
+        }
+
+        m_cv.notify_one();
+    }
+
+    void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn){
+        if(count == 0)
+            return;
+
+        // Every participant (helpers plus the caller) pulls indices off one shared counter, so
+        // uneven per-index costs balance themselves out
+        std::atomic<std::size_t> next = 0;
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto drain = [&](){
+            for(std::size_t i = next++; i < count; i = next++){
+                try {
+                    fn(i);
+                } catch(...){
+                    std::lock_guard lock(errorMutex);
+                    if(!error)
+                        error = std::current_exception();
+                }
+            }
+        };
+
+        const std::size_t helpers = std::min(m_workers.size(), count - 1);
+        std::size_t finished = 0;
+        std::mutex doneMutex;
+        std::condition_variable doneCv;
+
+        for(std::size_t i = 0; i < helpers; i++){
+            submit([&](){
+                drain();
+
+                std::lock_guard lock(doneMutex);
+                finished++;
+                doneCv.notify_one();
+            });
+        }
+
+        drain();
+
+        {
+            std::unique_lock lock(doneMutex);
+            doneCv.wait(lock, [&]{ return finished == helpers; });
+        }
+
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    void ThreadPool::worker_loop(std::stop_token token){
+        while(true){
+            std::function<void()> task;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, token, [this]{ return !m_pending.empty(); });
+
+                // Only reachable with an empty queue if wait() gave up because of a stop
+                // request with nothing left pending
+                if(m_pending.empty())
+                    return;
+
+                task = std::move(m_pending.front());
+                m_pending.pop_front();
+            }
+
+            task();
+        }
+    }
+}
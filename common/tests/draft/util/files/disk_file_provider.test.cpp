@@ -46,6 +46,23 @@ TEST(DiskFileProvider, BytesReadWrite)
     provider.remove("test_dfp_bytes.bin");
 }
 
+TEST(DiskFileProvider, AppendBytesCreatesThenExtends)
+{
+    DiskFileProvider provider;
+    provider.remove("test_dfp_append.txt");
+
+    provider.append_bytes("test_dfp_append.txt", "hello", 5);
+    provider.append_bytes("test_dfp_append.txt", " disk", 5);
+    ASSERT_EQ(provider.read_string("test_dfp_append.txt"), "hello disk");
+
+    // A plain write still truncates whatever was appended before
+    provider.write_string("test_dfp_append.txt", "reset");
+    provider.append_bytes("test_dfp_append.txt", "!", 1);
+    ASSERT_EQ(provider.read_string("test_dfp_append.txt"), "reset!");
+
+    provider.remove("test_dfp_append.txt");
+}
+
 TEST(DiskFileProvider, ReadBytesWithOffset)
 {
     DiskFileProvider provider;
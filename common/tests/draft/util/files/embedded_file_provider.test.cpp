@@ -82,6 +82,7 @@ TEST(EmbeddedFileProvider, MutatingOperationsAreRejected)
     EmbeddedFileProvider provider;
     ASSERT_THROW(provider.write_string("assets/fonts/default.ttf", "nope"), std::logic_error);
     ASSERT_THROW(provider.write_bytes("assets/fonts/default.ttf", "no", 2), std::logic_error);
+    ASSERT_THROW(provider.append_bytes("assets/fonts/default.ttf", "no", 2), std::logic_error);
     ASSERT_THROW(provider.remove("assets/fonts/default.ttf"), std::logic_error);
     ASSERT_THROW(provider.create_directories("assets/fonts/default.ttf"), std::logic_error);
 }
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "draft/util/json_stream.hpp"
+#include "draft/util/files/disk_file_provider.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    // Writes @p document through a JSONStreamWriter the way save_scene() does: the root and its
+    // array members as structure, everything below them as whole values
+    void stream_out(const JSON& document, JSONStreamWriter& writer){
+        writer.begin_object();
+
+        for(auto& [key, member] : document.items()){
+            writer.key(key);
+
+            if(member.is_array()){
+                writer.begin_array();
+                for(const auto& element : member)
+                    writer.value(element);
+                writer.end_array();
+            } else {
+                writer.value(member);
+            }
+        }
+
+        writer.end_object();
+        writer.finish();
+    }
+
+    JSON sample_document(int elements){
+        JSON document = JSON::object();
+        document["name"] = "level \"one\"\nsecond line";
+        document["empty"] = JSON::array();
+        document["settings"] = JSON::object({{"gravity", 9.8}, {"tags", {"a", "b"}}, {"nothing", JSON::object()}});
+
+        JSON items = JSON::array();
+        for(int i = 0; i < elements; i++)
+            items.push_back(JSON::object({{"id", i}, {"position", {i * 0.5, -i}}, {"label", "item " + std::to_string(i)}}));
+
+        document["items"] = items;
+        return document;
+    }
+}
+
+TEST(JSONStreamWriter, PrettyOutputMatchesDump)
+{
+    JSON document = sample_document(3);
+    FileHandle file = DiskFileProvider().open("test_json_stream_pretty.json");
+
+    JSONStreamWriter writer(file, 4);
+    stream_out(document, writer);
+
+    EXPECT_EQ(file.read_string(), document.dump(4));
+    file.remove();
+}
+
+TEST(JSONStreamWriter, CompactOutputMatchesDump)
+{
+    JSON document = sample_document(3);
+    FileHandle file = DiskFileProvider().open("test_json_stream_compact.json");
+
+    JSONStreamWriter writer(file, -1);
+    stream_out(document, writer);
+
+    EXPECT_EQ(file.read_string(), document.dump());
+    file.remove();
+}
+
+TEST(JSONStreamWriter, LargeDocumentsAreWrittenInPieces)
+{
+    // Well past the flush threshold, so the file is truncated once and appended to after
+    JSON document = sample_document(20000);
+    FileHandle file = DiskFileProvider().open("test_json_stream_large.json");
+    file.write_string("stale contents that must not survive");
+
+    JSONStreamWriter writer(file, 4);
+    stream_out(document, writer);
+
+    EXPECT_EQ(JSON(file), document);
+    file.remove();
+}
+
+TEST(JSONStreamWriter, MisuseThrows)
+{
+    FileHandle file = DiskFileProvider().open("test_json_stream_misuse.json");
+
+    JSONStreamWriter writer(file);
+    writer.begin_object();
+    EXPECT_THROW(writer.value(JSON(1)), std::logic_error);
+    EXPECT_THROW(writer.end_array(), std::logic_error);
+    EXPECT_THROW(writer.finish(), std::logic_error);
+
+    writer.key("a");
+    EXPECT_THROW(writer.key("b"), std::logic_error);
+}
+
+TEST(ReadJSONStream, SplitsArrayMembersIntoElements)
+{
+    JSON document = sample_document(50);
+    std::string text = document.dump(4);
+
+    std::vector<std::pair<std::string, JSON>> pieces;
+    std::vector<std::string> keys = read_json_stream(text, [&](const std::string& key, JSON& element){
+        pieces.emplace_back(key, std::move(element));
+    });
+
+    // "empty" splits into nothing, but is still reported
+    EXPECT_EQ(keys, (std::vector<std::string>{"empty", "items", "name", "settings"}));
+
+    // Members come in document order (nlohmann sorts keys), arrays one element at a time
+    JSON rebuilt = JSON::object();
+    rebuilt["empty"] = JSON::array();
+
+    std::size_t itemCount = 0;
+    for(auto& [key, element] : pieces){
+        if(key == "items"){
+            ASSERT_EQ(element.at("id"), itemCount);
+            itemCount++;
+            rebuilt["items"].push_back(element);
+        } else if(key == "settings"){
+            // Nested arrays inside a whole value stay whole
+            ASSERT_TRUE(element.at("tags").is_array());
+            rebuilt[key] = element;
+        } else {
+            rebuilt[key] = element;
+        }
+    }
+
+    EXPECT_EQ(itemCount, 50u);
+    EXPECT_EQ(rebuilt, document);
+}
+
+TEST(ReadJSONStream, RejectsANonObjectRootAndMalformedText)
+{
+    auto ignore = [](const std::string&, JSON&){};
+
+    EXPECT_THROW(read_json_stream("[1, 2, 3]", ignore), std::runtime_error);
+    EXPECT_THROW(read_json_stream("42", ignore), std::runtime_error);
+    EXPECT_THROW(read_json_stream(R"({"a": [1, 2)", ignore), nlohmann::json::parse_error);
+}
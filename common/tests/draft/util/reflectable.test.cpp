@@ -2,6 +2,7 @@
 #include "draft/util/reflectable.hpp"
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace {
@@ -167,3 +168,43 @@ TEST(Reflectable, VisitFieldCanMutateThroughTheVisitor)
     Draft::visit_field(p, "x", [](auto& value){ value = 100; });
     ASSERT_EQ(p.x, 100);
 }
+
+TEST(Reflectable, FieldIndexResolvesEveryNameAtCompileTime)
+{
+    static_assert(Draft::field_count<ManyFields>() == 7);
+    static_assert(Draft::field_index<ManyFields>("a") == 0);
+    static_assert(Draft::field_index<ManyFields>("g") == 6);
+    static_assert(Draft::field_index<ManyFields>("h") == Draft::field_count<ManyFields>());
+    static_assert(Draft::field_index<Empty>("anything") == 0);
+
+    std::vector<std::string> names;
+    Draft::for_each_field(ManyFields{}, [&](std::string_view name, const auto&){ names.emplace_back(name); });
+
+    for(std::size_t i = 0; i < names.size(); i++)
+        ASSERT_EQ(Draft::field_index<ManyFields>(names[i]), i);
+
+    // Prefixes, extensions and case changes of real names aren't matches
+    ASSERT_EQ(Draft::field_index<Mixed>("nam"), 2u);
+    ASSERT_EQ(Draft::field_index<Mixed>("names"), 2u);
+    ASSERT_EQ(Draft::field_index<Mixed>("Count"), 2u);
+}
+
+TEST(Reflectable, VisitFieldAtReachesTheFieldAtThatIndex)
+{
+    Mixed m{3, "three"};
+
+    std::string seen;
+    Draft::visit_field_at(m, 1, [&](auto& value){
+        if constexpr(std::is_same_v<std::remove_cvref_t<decltype(value)>, std::string>)
+            seen = value;
+    });
+    ASSERT_EQ(seen, "three");
+
+    const Mixed& constM = m;
+    int count = 0;
+    Draft::visit_field_at(constM, 0, [&](const auto& value){
+        if constexpr(std::is_same_v<std::remove_cvref_t<decltype(value)>, int>)
+            count = value;
+    });
+    ASSERT_EQ(count, 3);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "draft/util/serialization/serializer.hpp"
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -46,6 +47,60 @@ TEST(Binary, ReadThrowsWhenSpanTooSmall)
     ASSERT_THROW(read(view, value), std::runtime_error);
 }
 
+TEST(BinaryWriter, BackPatchesALengthPrefixWithoutAScratchBuffer)
+{
+    ByteArray arena;
+    Writer writer(arena);
+    writer.write(uint32_t{7});
+
+    std::size_t slot = writer.placeholder<uint32_t>();
+    writer.write(int16_t{-2});
+    writer.write_bytes(ByteView(arena).subspan(0, sizeof(uint32_t)));
+    writer.patch_size<uint32_t>(slot);
+
+    Reader reader(arena);
+    ASSERT_EQ(reader.read<uint32_t>(), 7u);
+
+    ByteView payload = reader.sized<uint32_t>();
+    ASSERT_EQ(payload.size(), sizeof(int16_t) + sizeof(uint32_t));
+    ASSERT_EQ(payload.data(), arena.data() + 2 * sizeof(uint32_t)); // a view, not a copy
+    ASSERT_TRUE(reader.empty());
+
+    Reader inner(payload);
+    ASSERT_EQ(inner.read<int16_t>(), -2);
+    ASSERT_EQ(inner.read<uint32_t>(), 7u);
+
+    ASSERT_THROW(writer.patch(arena.size() - 1, uint32_t{0}), std::out_of_range);
+}
+
+TEST(BinaryWriter, EncodesTheSameBytesAsWrite)
+{
+    ByteArray viaWrite;
+    write(viaWrite, int32_t{-5});
+    write(viaWrite, 2.25);
+
+    ByteArray viaWriter;
+    Writer writer(viaWriter);
+    writer.write(int32_t{-5});
+    writer.write(2.25);
+
+    ASSERT_EQ(viaWriter, viaWrite);
+}
+
+TEST(BinaryReader, ThrowsInsteadOfReadingPastTheEnd)
+{
+    ByteArray buffer;
+    write(buffer, uint32_t{100}); // a length prefix promising far more than follows
+    write(buffer, uint8_t{1});
+
+    Reader reader(buffer);
+    ASSERT_THROW(reader.sized<uint32_t>(), std::runtime_error);
+
+    Reader shortReader(ByteView(buffer).subspan(0, 2));
+    ASSERT_THROW(shortReader.read<uint32_t>(), std::runtime_error);
+    ASSERT_THROW(shortReader.bytes(3), std::runtime_error);
+}
+
 TEST(SerializerTrivial, BinaryRoundTrip)
 {
     ByteArray buffer;
@@ -81,6 +136,26 @@ TEST(SerializerVector, BinaryRoundTrip)
     ASSERT_EQ(restored, values);
 }
 
+TEST(SerializerVector, BulkCopyMatchesTheElementwiseEncoding)
+{
+    std::vector<int32_t> values = {1, -2, 3, -4};
+
+    ByteArray bulk;
+    Serializer::serialize(values, bulk);
+
+    ByteArray elementwise;
+    Serializer::serialize(values.size(), elementwise);
+    for(int32_t value : values)
+        Serializer::serialize(value, elementwise);
+
+    ASSERT_EQ(bulk, elementwise);
+
+    // Too short for the count it claims
+    bulk.pop_back();
+    std::vector<int32_t> restored;
+    ASSERT_THROW(Serializer::deserialize(restored, ByteView(bulk)), std::runtime_error);
+}
+
 namespace {
     // A custom type with its own static serialize/deserialize, satisfying both
     // BinarySerializable and JsonSerializable. Deliberately non-trivially-copyable (owns a
@@ -287,6 +362,51 @@ TEST(SerializerReflectable, JsonRoundTripNested)
     ASSERT_EQ(restored.end.y, 20);
 }
 
+namespace {
+    // Same fields as Point, reflected out of declaration order, so its encoding isn't its memory
+    struct SwappedPoint {
+        DRAFT_REFLECTED(int, x) = 0;
+        DRAFT_REFLECTED(int, y) = 0;
+
+        DRAFT_REFLECTABLE(SwappedPoint, y, x)
+    };
+
+    // Padding between the fields, which the reflect tier's encoding skips
+    struct PaddedPoint {
+        DRAFT_REFLECTED(char, id) = 0;
+        DRAFT_REFLECTED(int, value) = 0;
+
+        DRAFT_REFLECTABLE(PaddedPoint, id, value)
+    };
+}
+
+TEST(SerializerBulkCopyable, OnlyTypesEncodedAsTheirOwnMemory)
+{
+    if(!Binary::IS_LITTLE_ENDIAN)
+        GTEST_SKIP() << "bulk copies are little-endian only";
+
+    EXPECT_TRUE(Serializer::is_bulk_copyable<float>());
+    EXPECT_TRUE(Serializer::is_bulk_copyable<Point>());
+    EXPECT_TRUE(Serializer::is_bulk_copyable<Line>());
+
+    EXPECT_FALSE(Serializer::is_bulk_copyable<SwappedPoint>());
+    EXPECT_FALSE(Serializer::is_bulk_copyable<PaddedPoint>());
+    EXPECT_FALSE(Serializer::is_bulk_copyable<Path>());
+    EXPECT_FALSE(Serializer::is_bulk_copyable<std::string>());
+}
+
+TEST(SerializerBulkCopyable, RawBytesMatchTheSerializedEncoding)
+{
+    Line line{{1, 2}, {3, 4}};
+
+    Binary::ByteArray buffer;
+    Serializer::serialize(line, buffer);
+
+    ASSERT_EQ(buffer.size(), sizeof(Line));
+    if(Serializer::is_bulk_copyable<Line>())
+        ASSERT_EQ(std::memcmp(buffer.data(), &line, sizeof(Line)), 0);
+}
+
 TEST(SerializerVector, JsonRoundTrip)
 {
     std::vector<int> values = {1, 2, 3, 4, 5};
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "draft/util/string_id.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+using namespace Draft;
+
+TEST(StringId, LiteralsHashAtCompileTime)
+{
+    constexpr StringId jump = "Jump"_sid;
+    static_assert(jump == StringId("Jump"));
+    static_assert(jump != "Fire"_sid);
+    static_assert(StringId() == ""_sid);
+
+    EXPECT_EQ(jump, StringId(std::string("Jump")));
+}
+
+TEST(StringId, InternRecordsTheStringForStr)
+{
+    StringId id = StringId::intern("string_id_test_interned");
+
+    EXPECT_EQ(id, StringId("string_id_test_interned"));
+    EXPECT_EQ(id.str(), "string_id_test_interned");
+
+    // Interning the same string again is a no-op
+    EXPECT_EQ(StringId::intern("string_id_test_interned"), id);
+}
+
+TEST(StringId, StrIsEmptyForAnIdThatWasNeverInterned)
+{
+    EXPECT_TRUE("string_id_test_never_interned"_sid.str().empty());
+}
+
+TEST(StringId, UsableAsAnUnorderedKey)
+{
+    std::unordered_set<StringId> ids{"a"_sid, "b"_sid, "a"_sid};
+    EXPECT_EQ(ids.size(), 2u);
+    EXPECT_TRUE(ids.contains(StringId("b")));
+}
+
+#ifndef NDEBUG
+TEST(StringId, DebugBuildsRejectACollidingIntern)
+{
+    // FNV-1a 32 collision pair
+    ASSERT_EQ(StringId("costarring"), StringId("liquid"));
+
+    StringId::intern("costarring");
+    EXPECT_THROW(StringId::intern("liquid"), std::logic_error);
+}
+#endif
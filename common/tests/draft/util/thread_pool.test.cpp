@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "draft/util/thread_pool.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce)
+{
+    Draft::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+
+    pool.parallel_for(visits.size(), [&](std::size_t i){ visits[i]++; });
+
+    for(auto& v : visits)
+        ASSERT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPool, ZeroWorkersRunsInline)
+{
+    Draft::ThreadPool pool(0);
+    ASSERT_EQ(pool.worker_count(), 0u);
+
+    auto caller = std::this_thread::get_id();
+    bool ran = false;
+    pool.submit([&]{ ran = std::this_thread::get_id() == caller; });
+    ASSERT_TRUE(ran);
+
+    int sum = 0;
+    pool.parallel_for(10, [&](std::size_t i){ sum += static_cast<int>(i); });
+    ASSERT_EQ(sum, 45);
+}
+
+TEST(ThreadPool, ParallelForRethrowsAfterFinishing)
+{
+    Draft::ThreadPool pool(3);
+    std::atomic<int> visited = 0;
+
+    ASSERT_THROW(pool.parallel_for(100, [&](std::size_t i){
+        visited++;
+        if(i == 7)
+            throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    ASSERT_EQ(visited.load(), 100);
+}
+
+TEST(ThreadPool, DestructorDrainsSubmittedTasks)
+{
+    std::atomic<int> ran = 0;
+
+    {
+        Draft::ThreadPool pool(2);
+        for(int i = 0; i < 64; i++)
+            pool.submit([&]{ ran++; });
+    }
+
+    ASSERT_EQ(ran.load(), 64);
+}
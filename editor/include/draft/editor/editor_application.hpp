@@ -281,7 +281,6 @@ namespace Draft {
         void stop();
         void open_scene_now(const std::filesystem::path& path);
         void new_scene_now(const std::filesystem::path& path);
-        std::filesystem::path snapshot_path() const;
         std::filesystem::path reload_snapshot_path() const;
 
         std::optional<EditorProject> m_project;
@@ -294,5 +293,9 @@ namespace Draft {
         std::filesystem::path m_pendingProjectPath;
         std::filesystem::path m_pendingScenePath;
         bool m_isPlaying = false;
+
+        // Taken by play(), put back by stop(). Holds game module types, so it's dropped before
+        // a module reload
+        SceneSnapshot m_playSnapshot;
     };
 }
@@ -302,7 +302,11 @@ namespace Draft {
 
         if(preserveScene){
             fs.create_directories(reloadSnapshotPath);
-            save_scene(gameScene, gameEngine, assets, fs.open(reloadSnapshotPath));
+
+            // Read back moments later and never looked at, no point indenting it
+            SceneSaveOptions options;
+            options.compact = true;
+            save_scene(gameScene, gameEngine, assets, fs.open(reloadSnapshotPath), options);
         }
 
         GameModuleLoader newModule(modulePath);
@@ -310,6 +314,7 @@ namespace Draft {
         gameApp.simulationPaused = true;
         m_isPlaying = false;
         selection.clear();
+        m_playSnapshot = {};
         gameScene.get_registry().clear();
         gameScene.get_systems().clear();
         gameEngine.clear();
@@ -379,9 +384,7 @@ namespace Draft {
         if(!m_project)
             return;
 
-        std::filesystem::path path = snapshot_path();
-        HostFileSystem().create_directories(path);
-        save_scene(gameScene, gameEngine, assets, HostFileSystem().open(path));
+        m_playSnapshot = gameScene.snapshot(gameEngine, assets);
         gameApp.simulationPaused = false;
         m_isPlaying = true;
     }
@@ -394,15 +397,12 @@ namespace Draft {
         m_isPlaying = false;
         gameApp.fakeKeyboard.release_all();
 
-        FileHandle snapshot = HostFileSystem().open(snapshot_path());
-        if(!snapshot.exists())
+        if(m_playSnapshot.empty())
             return;
 
         selection.clear();
-        gameScene.get_registry().clear();
-        gameScene.get_systems().clear();
-
-        load_scene(gameScene, gameEngine, assets, snapshot);
+        gameScene.restore(m_playSnapshot);
+        m_playSnapshot = {};
     }
 
     void EditorApplication::open_scene_now(const std::filesystem::path& path){
@@ -433,10 +433,6 @@ namespace Draft {
         open_scene_now(path);
     }
 
-    std::filesystem::path EditorApplication::snapshot_path() const {
-        return m_project->root() / ".draft-editor" / "play_snapshot.json";
-    }
-
     std::filesystem::path EditorApplication::reload_snapshot_path() const {
         return m_project->root() / ".draft-editor" / "reload_snapshot.json";
     }
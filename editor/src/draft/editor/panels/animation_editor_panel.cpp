@@ -71,8 +71,8 @@ namespace Draft {
 
     void AnimationEditorPanelSystem::draw_tag_list(Animation& animation){
         std::vector<std::string> tagNames;
-        for(const auto& [name, tag] : animation.get_tags())
-            tagNames.push_back(name);
+        for(const auto& [id, tag] : animation.get_tags())
+            tagNames.push_back(tag.name);
         std::sort(tagNames.begin(), tagNames.end());
 
         ImGui::BeginGroup();
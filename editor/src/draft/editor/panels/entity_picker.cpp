@@ -1,7 +1,7 @@
 #include "draft/editor/panels/entity_picker.hpp"
 #include "draft/components/collider_component.hpp"
 #include "draft/components/sprite_component.hpp"
-#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
 
 #include <limits>
 
@@ -9,10 +9,13 @@ namespace Draft {
     Entity pick_entity(Scene& scene, const Vector2f& worldPoint){
         Registry& registry = scene.get_registry();
 
+        // Test against world-space poses, so parented entities are picked where they're drawn
+        scene.update_world_transforms();
+
         Entity best;
         float bestZIndex = -std::numeric_limits<float>::infinity();
 
-        for(auto [raw, transform, sprite] : registry.view<TransformComponent, SpriteComponent>().each()){
+        for(auto [raw, transform, sprite] : registry.view<WorldTransformComponent, SpriteComponent>().each()){
             Vector2f min = transform.position - sprite.origin;
             Vector2f max = min + sprite.size;
 
@@ -29,8 +32,8 @@ namespace Draft {
             return best;
 
         // No sprite matched, fall back to shape-accurate testing against ColliderComponent.
-        for(auto [raw, transform, colliderComp] : registry.view<TransformComponent, ColliderComponent>().each()){
-            Vector2f localPoint = Math::inverse(transform.get_transform()) * Vector3f(worldPoint, 1.f);
+        for(auto [raw, transform, colliderComp] : registry.view<WorldTransformComponent, ColliderComponent>().each()){
+            Vector2f localPoint = Math::inverse(transform.matrix) * Vector3f(worldPoint, 1.f);
             Collider& collider = colliderComp.collider;
 
             if(collider.test_point(localPoint))
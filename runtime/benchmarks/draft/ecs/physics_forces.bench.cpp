@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "draft/components/collider_component.hpp"
+#include "draft/components/rigid_body_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/physics_system.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/physics/shapes/circle_shape.hpp"
+#include "draft/physics/world.hpp"
+#include "draft/util/clock.hpp"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    constexpr int BODY_COUNT = 10000;
+    constexpr int GRID_WIDTH = 100;
+    constexpr int FRAMES = 120;
+    const Time DT = Time::seconds(1.f / 60.f);
+
+    // Average time per frame of a gameplay loop thrusting every body, then PhysicsSystem::update().
+    // @p thrust is called once per body per frame
+    template<typename Thrust>
+    Time run(bool accumulate, Thrust&& thrust){
+        World world({0.f, 0.f});
+        Scene scene;
+        scene.get_systems().add<PhysicsSystem>(scene, world);
+
+        CircleShape circle;
+        circle.set_radius(0.5f);
+
+        std::vector<Entity> entities;
+        entities.reserve(BODY_COUNT);
+
+        for(int i = 0; i < BODY_COUNT; i++){
+            Entity entity = scene.create_entity();
+            entity.add_component<TransformComponent>(TransformComponent{{(i % GRID_WIDTH) * 20.f, (i / GRID_WIDTH) * 20.f}, 0.f});
+            entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+            entity.add_component<ColliderComponent>(ColliderComponent(circle));
+
+            if(accumulate)
+                entity.add_component<ForceAccumulatorComponent>();
+
+            entities.push_back(entity);
+        }
+
+        scene.update(DT);
+
+        Clock clock;
+        for(int frame = 0; frame < FRAMES; frame++){
+            for(Entity& entity : entities)
+                thrust(entity);
+
+            scene.update(DT);
+        }
+
+        Time elapsed = clock.get_elapsed_time() / static_cast<float>(FRAMES);
+
+        // Both approaches push the same bodies the same way
+        EXPECT_GT(entities.back().get_component<RigidBodyComponent>().linearVelocity.x, 0.f);
+        return elapsed;
+    }
+}
+
+TEST(PhysicsForcesBenchmark, TenThousandThrustingBodies)
+{
+    Time oneShot = run(false, [](Entity& entity){
+        entity.add_component<ForceComponent>(ForceComponent{{1.f, 0.f}, {}, true});
+    });
+
+    Time accumulated = run(true, [](Entity& entity){
+        entity.get_component<ForceAccumulatorComponent>().add_force({1.f, 0.f});
+    });
+
+    std::printf("%d bodies thrusting every frame, per frame\n", BODY_COUNT);
+    std::printf("  one-shot ForceComponent:    %8.3f ms\n", oneShot.as_microseconds() / 1000.0);
+    std::printf("  ForceAccumulatorComponent:  %8.3f ms\n", accumulated.as_microseconds() / 1000.0);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "draft/components/collider_component.hpp"
+#include "draft/components/rigid_body_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/physics_system.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/physics/shapes/circle_shape.hpp"
+#include "draft/physics/world.hpp"
+#include "draft/util/clock.hpp"
+
+#include <cstdio>
+
+using namespace Draft;
+
+namespace {
+    constexpr int BODY_COUNT = 50000;
+    constexpr int GRID_WIDTH = 250;
+    constexpr int FRAMES = 60;
+    const Time DT = Time::seconds(1.f / 60.f);
+
+    // Average time per frame of stepping the world alone, and of a full PhysicsSystem::update()
+    // (step, then sync), with one body in every @p awakeEvery awake and drifting, the rest asleep
+    void run(int awakeEvery, Time& stepOnly, Time& update){
+        World world({0.f, 0.f});
+        Scene scene;
+        scene.get_systems().add<PhysicsSystem>(scene, world);
+
+        CircleShape circle;
+        circle.set_radius(0.5f);
+
+        // Spaced so nothing drifts into anything else within FRAMES
+        for(int i = 0; i < BODY_COUNT; i++){
+            bool awake = i % awakeEvery == 0;
+
+            Entity entity = scene.create_entity();
+            entity.add_component<TransformComponent>(TransformComponent{{(i % GRID_WIDTH) * 4.f, (i / GRID_WIDTH) * 4.f}, 0.f});
+            entity.add_component<RigidBodyComponent>(RigidBodyComponent{
+                .type = BodyType::DYNAMIC,
+                .linearVelocity = awake ? Vector2f{1.f, 0.f} : Vector2f{0.f, 0.f},
+                .awake = awake
+            });
+            entity.add_component<ColliderComponent>(ColliderComponent(circle));
+        }
+
+        // Settle the first sync, which visits every body once
+        scene.update(DT);
+
+        Clock clock;
+        for(int frame = 0; frame < FRAMES; frame++)
+            scene.update(DT);
+
+        update = clock.restart() / static_cast<float>(FRAMES);
+
+        for(int frame = 0; frame < FRAMES; frame++)
+            world.step(DT, World::VELOCITY_ITER, World::POSITION_ITER);
+
+        stepOnly = clock.restart() / static_cast<float>(FRAMES);
+    }
+}
+
+TEST(PhysicsSyncBenchmark, FiftyThousandBodiesTwoPercentAwake)
+{
+    Time sparseStep, sparseUpdate;
+    run(50, sparseStep, sparseUpdate);
+
+    Time denseStep, denseUpdate;
+    run(1, denseStep, denseUpdate);
+
+    std::printf("%d bodies, per frame\n", BODY_COUNT);
+    std::printf("  2%% awake:   step %8.3f ms, sync %8.3f ms\n", sparseStep.as_microseconds() / 1000.0, (sparseUpdate - sparseStep).as_microseconds() / 1000.0);
+    std::printf("  100%% awake: step %8.3f ms, sync %8.3f ms\n", denseStep.as_microseconds() / 1000.0, (denseUpdate - denseStep).as_microseconds() / 1000.0);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/util/clock.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    // Attaches count children to one parent, then detaches them newest first (each one the
+    // last sibling) or oldest first (the last sibling moves into each freed slot). Both should
+    // scale linearly with count
+    Time detach_all(int count, bool newestFirst){
+        Scene scene;
+        Entity parent = scene.create_entity();
+        std::vector<Entity> kids;
+
+        for(int i = 0; i < count; i++){
+            kids.push_back(scene.create_entity());
+            kids.back().add_component<ChildComponent>(ChildComponent{parent});
+        }
+
+        if(newestFirst)
+            std::reverse(kids.begin(), kids.end());
+
+        Clock clock;
+        for(Entity& kid : kids)
+            kid.remove_component<ChildComponent>();
+
+        Time elapsed = clock.get_elapsed_time();
+        EXPECT_FALSE(parent.has_component<ParentComponent>());
+        return elapsed;
+    }
+}
+
+TEST(RelationshipBenchmark, DetachingEveryChildOfOneParent)
+{
+    for(int count : {4000, 32000}){
+        Time newest = detach_all(count, true);
+        Time oldest = detach_all(count, false);
+
+        std::printf("detaching %d children\n", count);
+        std::printf("  newest first: %9.3f ms\n", newest.as_microseconds() / 1000.0);
+        std::printf("  oldest first: %9.3f ms\n", oldest.as_microseconds() / 1000.0);
+    }
+}
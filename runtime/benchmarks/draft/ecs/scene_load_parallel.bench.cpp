@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "draft/asset/asset_manager.hpp"
+#include "draft/components/tag_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/core/engine.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/ecs/scene_serializer.hpp"
+#include "draft/util/clock.hpp"
+#include "draft/util/files/disk_file_provider.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    void populate(Scene& scene, int entityCount){
+        std::vector<Entity> entities;
+        entities.reserve(entityCount);
+
+        for(int i = 0; i < entityCount; i++){
+            Entity entity = scene.create_entity();
+            entity.add_component<TagComponent>(TagComponent{"Entity" + std::to_string(i)});
+            entity.add_component<TransformComponent>(TransformComponent{{float(i), float(-i)}, 0.1f});
+
+            // Small families, so the decode also resolves entity references
+            if(i % 8 != 0)
+                entity.add_component<ChildComponent>(ChildComponent{entities[i - i % 8]});
+
+            entities.push_back(entity);
+        }
+    }
+
+    template<typename Load>
+    Time time_load(Load&& load){
+        Scene loaded;
+        Clock clock;
+        load(loaded);
+        return clock.get_elapsed_time();
+    }
+
+    void run(int entityCount, bool includeJson){
+        Engine engine;
+        AssetManager assets;
+
+        Scene scene;
+        populate(scene, entityCount);
+
+        const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+        std::printf("%d entities (tag + transform + child), %zu decode threads\n", entityCount, threads);
+
+        FileHandle binary = DiskFileProvider().open("scene_load_parallel_bench.bin");
+        save_scene_binary(scene, engine, assets, binary);
+
+        Time serial = time_load([&](Scene& s){ load_scene_binary(s, engine, assets, binary); });
+        Time parallel = time_load([&](Scene& s){ load_scene_binary(s, engine, assets, binary, SceneLoadOptions{threads}); });
+        std::printf("  binary serial:   %9.3f ms\n", serial.as_microseconds() / 1000.0);
+        std::printf("  binary parallel: %9.3f ms\n", parallel.as_microseconds() / 1000.0);
+        binary.remove();
+
+        if(!includeJson)
+            return;
+
+        FileHandle json = DiskFileProvider().open("scene_load_parallel_bench.json");
+        save_scene(scene, engine, assets, json);
+
+        serial = time_load([&](Scene& s){ load_scene(s, engine, assets, json); });
+        parallel = time_load([&](Scene& s){ load_scene(s, engine, assets, json, SceneLoadOptions{threads}); });
+        std::printf("  json serial:     %9.3f ms\n", serial.as_microseconds() / 1000.0);
+        std::printf("  json parallel:   %9.3f ms\n", parallel.as_microseconds() / 1000.0);
+        json.remove();
+    }
+}
+
+TEST(SceneLoadParallelBenchmark, TenThousandEntities)
+{
+    run(10000, true);
+}
+
+TEST(SceneLoadParallelBenchmark, HundredThousandEntities)
+{
+    run(100000, true);
+}
+
+// JSON is skipped here, parsing a document this size dwarfs the decode being measured
+TEST(SceneLoadParallelBenchmark, MillionEntities)
+{
+    run(1000000, false);
+}
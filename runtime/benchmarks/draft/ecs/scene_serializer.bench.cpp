@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "draft/asset/asset_manager.hpp"
+#include "draft/components/tag_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/core/engine.hpp"
+#include "draft/ecs/component_catalog.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/ecs/scene_serialization_context.hpp"
+#include "draft/ecs/scene_serializer.hpp"
+#include "draft/util/clock.hpp"
+#include "draft/util/files/disk_file_provider.hpp"
+#include "draft/util/serialization/context.hpp"
+#include "draft/util/serialization/serializer.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    constexpr int ENTITY_COUNT = 100000;
+
+    void populate(Scene& scene){
+        for(int i = 0; i < ENTITY_COUNT; i++){
+            Entity entity = scene.create_entity();
+            entity.add_component<TagComponent>(TagComponent{"Entity" + std::to_string(i)});
+            entity.add_component<TransformComponent>(TransformComponent{{float(i), float(-i)}, 0.1f});
+        }
+    }
+
+    // The pre-table layout (per component: name + byte length + blob), for comparison
+    void save_scene_binary_v1(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file){
+        SceneSerializationContext ctx;
+        ctx.assets = &assets;
+
+        std::vector<entt::entity> orderedEntities;
+        for(entt::entity raw : *scene.get_registry().storage<entt::entity>()){
+            ctx.entityToId[raw] = static_cast<uint32_t>(orderedEntities.size());
+            orderedEntities.push_back(raw);
+        }
+
+        Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
+        Binary::ByteArray out;
+        Serializer::serialize(uint32_t(0), out);
+        Serializer::serialize(static_cast<uint32_t>(orderedEntities.size()), out);
+
+        for(entt::entity raw : orderedEntities){
+            Entity entity(const_cast<Scene*>(&scene), raw);
+
+            uint32_t componentCount = 0;
+            for(ComponentTypeInterface* entry : engine.components().all())
+                componentCount += entry->has(entity);
+            Serializer::serialize(componentCount, out);
+
+            for(ComponentTypeInterface* entry : engine.components().all()){
+                if(!entry->has(entity))
+                    continue;
+
+                Serializer::serialize(entry->name(), out);
+                Binary::ByteArray data;
+                entry->serialize(entity, data);
+                Serializer::serialize(static_cast<uint64_t>(data.size()), out);
+                out.insert(out.end(), data.begin(), data.end());
+            }
+        }
+
+        file.write_bytes(out);
+    }
+
+    Time time_load(const Engine& engine, AssetManager& assets, const FileHandle& file){
+        Scene loaded;
+        Clock clock;
+        load_scene_binary(loaded, engine, assets, file);
+        return clock.get_elapsed_time();
+    }
+}
+
+TEST(SceneSerializerBenchmark, HundredThousandEntityBinaryLoad)
+{
+    Engine engine;
+    AssetManager assets;
+
+    Scene scene;
+    populate(scene);
+
+    FileHandle v1 = DiskFileProvider().open("scene_bench_v1.bin");
+    FileHandle current = DiskFileProvider().open("scene_bench_current.bin");
+
+    save_scene_binary_v1(scene, engine, assets, v1);
+
+    Clock clock;
+    save_scene_binary(scene, engine, assets, current);
+    Time save = clock.get_elapsed_time();
+
+    Time loadV1 = time_load(engine, assets, v1);
+    Time loadCurrent = time_load(engine, assets, current);
+
+    std::printf("%d entities (tag + transform)\n", ENTITY_COUNT);
+    std::printf("  save:                %8.3f ms (%zu bytes v1, %zu bytes current)\n", save.as_microseconds() / 1000.0, v1.read_bytes().size(), current.read_bytes().size());
+    std::printf("  load v1 layout:      %8.3f ms\n", loadV1.as_microseconds() / 1000.0);
+    std::printf("  load current layout: %8.3f ms\n", loadCurrent.as_microseconds() / 1000.0);
+
+    v1.remove();
+    current.remove();
+}
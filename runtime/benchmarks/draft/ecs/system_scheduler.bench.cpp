@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "draft/ecs/system.hpp"
+#include "draft/util/clock.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    constexpr int SYSTEM_COUNT = 32;
+    constexpr int FRAMES = 200;
+    constexpr std::size_t WORK_SIZE = 20000;
+
+    // System N writes Tag<N % 8>, so the 32 systems form 8 chains of 4 that must stay
+    // ordered, and every system reads Tag<8>, which nobody writes, so shared reads are
+    // exercised without adding edges
+    template<int N>
+    struct Tag {};
+
+    template<int... Ns>
+    void add_tag(std::vector<std::type_index>& types, int index, std::integer_sequence<int, Ns...>){
+        ((Ns == index ? (types.push_back(std::type_index(typeid(Tag<Ns>))), 0) : 0), ...);
+    }
+
+    // Burns a fixed amount of CPU per update() on its own data, standing in for e.g. particle
+    // simulation or animation advance
+    template<int N>
+    struct SyntheticSystem : AbstractSystem {
+        std::vector<float> values = std::vector<float>(WORK_SIZE, static_cast<float>(N));
+        bool declared;
+
+        explicit SyntheticSystem(bool declared) : declared(declared) {}
+
+        void update(Time dt) override {
+            for(auto& v : values)
+                v = std::sin(v + dt.as_seconds());
+        }
+
+        std::optional<SystemAccess> get_access() const override {
+            if(!declared)
+                return std::nullopt;
+
+            SystemAccess access;
+            add_tag(access.writes, N % 8, std::make_integer_sequence<int, 8>());
+            access.read<Tag<8>>();
+            return access;
+        }
+    };
+
+    template<int... Ns>
+    void add_systems(SystemRegistry& systems, bool declared, std::integer_sequence<int, Ns...>){
+        (systems.add<SyntheticSystem<Ns>>(declared), ...);
+    }
+
+    Time run_frames(std::size_t workers, bool declared){
+        SystemRegistry systems;
+        systems.set_worker_threads(workers);
+        add_systems(systems, declared, std::make_integer_sequence<int, SYSTEM_COUNT>());
+
+        // Warm up (first update_all() also builds the schedule)
+        systems.update_all(Time::seconds(1.f / 60.f));
+
+        Clock clock;
+        for(int i = 0; i < FRAMES; i++)
+            systems.update_all(Time::seconds(1.f / 60.f));
+
+        return clock.get_elapsed_time();
+    }
+}
+
+TEST(SystemSchedulerBenchmark, ThirtyTwoSyntheticSystems)
+{
+    const std::size_t workers = std::max(2u, std::thread::hardware_concurrency());
+
+    Time serial = run_frames(0, true);
+    Time undeclared = run_frames(workers, false);
+    Time parallel = run_frames(workers, true);
+
+    std::printf("%d systems x %d frames\n", SYSTEM_COUNT, FRAMES);
+    std::printf("  serial (no workers):        %8.3f ms/frame\n", serial.as_microseconds() / 1000.0 / FRAMES);
+    std::printf("  %2zu workers, undeclared:    %8.3f ms/frame\n", workers, undeclared.as_microseconds() / 1000.0 / FRAMES);
+    std::printf("  %2zu workers, declared:      %8.3f ms/frame\n", workers, parallel.as_microseconds() / 1000.0 / FRAMES);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/util/clock.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    constexpr int NODE_COUNT = 100000;
+    constexpr int BRANCHING = 8;
+    constexpr int CHURN = NODE_COUNT / 100;
+    constexpr int FRAMES = 100;
+}
+
+TEST(WorldTransformBenchmark, HundredThousandNodesOnePercentChurn)
+{
+    Scene scene;
+    std::vector<Entity> nodes;
+    nodes.reserve(NODE_COUNT);
+
+    // Breadth-first tree, node i's parent is node (i - 1) / BRANCHING
+    for(int i = 0; i < NODE_COUNT; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TransformComponent>(TransformComponent{{1.f, 0.f}, 0.01f});
+
+        if(i > 0)
+            entity.add_component<ChildComponent>(ChildComponent{nodes[(i - 1) / BRANCHING]});
+
+        nodes.push_back(entity);
+    }
+
+    Clock clock;
+    scene.update_world_transforms();
+    Time initial = clock.restart();
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> pick(0, NODE_COUNT - 1);
+    Time total;
+
+    for(int frame = 0; frame < FRAMES; frame++){
+        for(int i = 0; i < CHURN; i++)
+            nodes[pick(rng)].get_component<TransformComponent>().position.x += 0.5f;
+
+        clock.restart();
+        scene.update_world_transforms();
+        total += clock.restart();
+    }
+
+    // Nothing changed at all, the cost of just detecting that
+    clock.restart();
+    scene.update_world_transforms();
+    Time idle = clock.restart();
+
+    std::printf("%d nodes, %d changed per frame\n", NODE_COUNT, CHURN);
+    std::printf("  initial full pass:   %8.3f ms\n", initial.as_microseconds() / 1000.0);
+    std::printf("  1%% churn pass:       %8.3f ms\n", total.as_microseconds() / 1000.0 / FRAMES);
+    std::printf("  idle pass:           %8.3f ms\n", idle.as_microseconds() / 1000.0);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "draft/util/clock.hpp"
+#include "draft/util/json.hpp"
+#include "draft/util/reflectable.hpp"
+#include "draft/util/serialization/serializer.hpp"
+
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+using namespace Draft;
+
+namespace {
+    struct Wide {
+        DRAFT_REFLECTED(int, field00) = 0;
+        DRAFT_REFLECTED(int, field01) = 0;
+        DRAFT_REFLECTED(int, field02) = 0;
+        DRAFT_REFLECTED(int, field03) = 0;
+        DRAFT_REFLECTED(int, field04) = 0;
+        DRAFT_REFLECTED(int, field05) = 0;
+        DRAFT_REFLECTED(int, field06) = 0;
+        DRAFT_REFLECTED(int, field07) = 0;
+        DRAFT_REFLECTED(int, field08) = 0;
+        DRAFT_REFLECTED(int, field09) = 0;
+        DRAFT_REFLECTED(float, field10) = 0.f;
+        DRAFT_REFLECTED(float, field11) = 0.f;
+        DRAFT_REFLECTED(float, field12) = 0.f;
+        DRAFT_REFLECTED(float, field13) = 0.f;
+        DRAFT_REFLECTED(float, field14) = 0.f;
+        DRAFT_REFLECTED(float, field15) = 0.f;
+        DRAFT_REFLECTED(float, field16) = 0.f;
+        DRAFT_REFLECTED(float, field17) = 0.f;
+        DRAFT_REFLECTED(float, field18) = 0.f;
+        DRAFT_REFLECTED(float, field19) = 0.f;
+        DRAFT_REFLECTED(bool, field20) = false;
+        DRAFT_REFLECTED(bool, field21) = false;
+        DRAFT_REFLECTED(bool, field22) = false;
+        DRAFT_REFLECTED(bool, field23) = false;
+        DRAFT_REFLECTED(bool, field24) = false;
+        DRAFT_REFLECTED(bool, field25) = false;
+        DRAFT_REFLECTED(bool, field26) = false;
+        DRAFT_REFLECTED(bool, field27) = false;
+        DRAFT_REFLECTED(bool, field28) = false;
+        DRAFT_REFLECTED(bool, field29) = false;
+        DRAFT_REFLECTED(std::string, field30);
+        DRAFT_REFLECTED(std::string, field31);
+        DRAFT_REFLECTED(std::string, field32);
+        DRAFT_REFLECTED(std::string, field33);
+        DRAFT_REFLECTED(std::string, field34);
+        DRAFT_REFLECTED(double, field35) = 0.0;
+        DRAFT_REFLECTED(double, field36) = 0.0;
+        DRAFT_REFLECTED(double, field37) = 0.0;
+        DRAFT_REFLECTED(double, field38) = 0.0;
+        DRAFT_REFLECTED(double, field39) = 0.0;
+
+        DRAFT_REFLECTABLE(Wide,
+            field00, field01, field02, field03, field04, field05, field06, field07, field08, field09,
+            field10, field11, field12, field13, field14, field15, field16, field17, field18, field19,
+            field20, field21, field22, field23, field24, field25, field26, field27, field28, field29,
+            field30, field31, field32, field33, field34, field35, field36, field37, field38, field39)
+    };
+
+    // What Serializer::deserialize() did before the name table: a lookup into json per field
+    void deserialize_per_field(Wide& value, const JSON& json){
+        for_each_field(value, [&](std::string_view name, auto& field){
+            std::string key(name);
+
+            if(json.contains(key))
+                Serializer::deserialize(field, static_cast<const JSON&>(json.at(key)));
+        });
+    }
+
+    template<typename Deserialize>
+    Time time_runs(int runs, const JSON& json, Deserialize&& deserialize){
+        Wide value;
+        Clock clock;
+
+        for(int i = 0; i < runs; i++)
+            deserialize(value, json);
+
+        Time elapsed = clock.get_elapsed_time();
+
+        // Keeps the loop from being optimized away
+        EXPECT_EQ(value.field39, 39.0);
+        return elapsed;
+    }
+}
+
+TEST(ReflectionBenchmark, TenThousandFortyFieldDeserializations)
+{
+    Wide source;
+    int i = 0;
+    for_each_field(source, [&](std::string_view, auto& field){
+        using Field = std::remove_reference_t<decltype(field)>;
+
+        if constexpr(std::is_same_v<Field, std::string>)
+            field = "value " + std::to_string(i);
+        else
+            field = static_cast<Field>(i);
+
+        i++;
+    });
+
+    JSON json;
+    Serializer::serialize(source, json);
+
+    constexpr int runs = 10000;
+    Time perField = time_runs(runs, json, [](Wide& value, const JSON& json){ deserialize_per_field(value, json); });
+    Time hashed = time_runs(runs, json, [](Wide& value, const JSON& json){ Serializer::deserialize(value, json); });
+
+    std::printf("%d deserializations of a %zu-field struct\n", runs, field_count<Wide>());
+    std::printf("  per-field lookup: %9.3f ms\n", perField.as_microseconds() / 1000.0);
+    std::printf("  name table:       %9.3f ms\n", hashed.as_microseconds() / 1000.0);
+}
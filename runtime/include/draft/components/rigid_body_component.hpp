@@ -5,6 +5,8 @@
 #include "draft/physics/rigid_body.hpp"
 #include "draft/util/reflectable.hpp"
 
+#include <cstdint>
+
 namespace Draft {
     /**
      * @brief Live `RigidBody*` handle + delta-tracking state, added/removed alongside a
@@ -28,6 +30,10 @@ namespace Draft {
         bool deltaFixedRotation = false;
         float deltaGravityScale = 1.f;
 
+        // Pose before the last step that moved the body, for drawing between physics steps
+        Vector2f previousPosition = {};
+        float previousRotation = 0.f;
+
         RigidBody* operator->(){ return bodyPtr; }
         operator RigidBody& () { return *bodyPtr; }
         operator RigidBody* () { return bodyPtr; }
@@ -95,6 +101,19 @@ namespace Draft {
         )
     };
 
+    /**
+     * @brief Which of its PhysicsSystem's worlds the entity's body lives in, see
+     * PhysicsSystem::add_world(). Entities without one use world 0, as do those naming a world
+     * that isn't added yet (e.g. a freshly loaded scene's) until it is. Adding, patching
+     * (through Entity::modify_component()) or removing it rebuilds an existing body in its new
+     * world. Its joints stay, but only act while both bodies share a world.
+     */
+    struct PhysicsWorldComponent {
+        uint32_t world = 0;
+
+        DRAFT_REFLECTABLE(PhysicsWorldComponent, world)
+    };
+
     /**
      * @brief One-shot torque request
      */
@@ -163,4 +182,46 @@ namespace Draft {
 
         DRAFT_REFLECTABLE(ContinuousImpulseComponent, force, point, angular, wake, enabled)
     };
+
+    /**
+     * @brief Forces, torques and impulses gathered over a tick and applied together by the next
+     * PhysicsSystem::update(), which then zeroes them. Unlike the one-shot components it stays
+     * attached, so pushing a body every tick costs a few additions instead of a component
+     * emplace and removal. Points are in world space, as for ForceComponent. Not reflectable as
+     * it only ever holds one tick's requests.
+     */
+    struct ForceAccumulatorComponent {
+        Vector2f force = {};
+        Vector2f impulse = {};
+        float torque = 0.f;
+        float angularImpulse = 0.f;
+
+        // Sum of point x force (and point x impulse) for the off-center requests. The body's
+        // center is only known when they're applied, so the torque they add is worked out then
+        Vector2f momentForce = {};
+        float forceMoment = 0.f;
+        Vector2f momentImpulse = {};
+        float impulseMoment = 0.f;
+
+        bool wake = true;
+
+        inline void add_force(const Vector2f& f){ force += f; }
+        inline void add_force(const Vector2f& f, const Vector2f& point){ momentForce += f; forceMoment += point.x * f.y - point.y * f.x; }
+        inline void add_torque(float t){ torque += t; }
+
+        inline void add_impulse(const Vector2f& j){ impulse += j; }
+        inline void add_impulse(const Vector2f& j, const Vector2f& point){ momentImpulse += j; impulseMoment += point.x * j.y - point.y * j.x; }
+        inline void add_angular_impulse(float j){ angularImpulse += j; }
+
+        /**
+         * @brief True when nothing was added since the last application, so the body is left
+         * alone (and asleep, if it was).
+         */
+        inline bool is_empty() const {
+            return force == Vector2f{} && impulse == Vector2f{} && torque == 0.f && angularImpulse == 0.f
+                && momentForce == Vector2f{} && forceMoment == 0.f && momentImpulse == Vector2f{} && impulseMoment == 0.f;
+        }
+
+        inline void clear(){ *this = ForceAccumulatorComponent{.wake = wake}; }
+    };
 }
@@ -50,6 +50,8 @@ namespace Draft {
                 ptr->bodyPtr->set_transform(position, rotation);
                 ptr->deltaP = position;
                 ptr->deltaR = rotation;
+                ptr->previousPosition = position;
+                ptr->previousRotation = rotation;
             }
         }
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "draft/math/glm.hpp"
+
+namespace Draft {
+    /**
+     * @brief The world-space pose of an entity's TransformComponent, i.e. its local transform
+     * composed with every ancestor's (see ChildComponent/ParentComponent).
+     *
+     * Attached and kept up to date by WorldTransformSystem, never by hand. Read it instead of
+     * walking the parent chain yourself, it's refreshed once per Scene::update() and before each
+     * Geometry render, or on demand with Scene::update_world_transforms().
+     */
+    struct WorldTransformComponent {
+        Vector2f position = {};
+        float rotation = 0.f;
+
+        /// position/rotation as a 2D (3x3) matrix, cached alongside them.
+        Matrix3 matrix = Matrix3(1.f);
+
+        /**
+         * @brief This transform as a 3D (4x4) matrix, for use alongside 3D rendering/camera math.
+         */
+        Matrix4 get_matrix() const {
+            Matrix4 mat = Matrix4(1.f);
+            mat = Math::translate(mat, {position, 0.f});
+            mat = Math::rotate(mat, rotation, {0, 0, 1});
+            return mat;
+        }
+
+    private:
+        friend class WorldTransformSystem;
+
+        // The local position/rotation the pose above was computed from, so a local transform
+        // written directly (not through patch()) is still noticed on the next pass
+        Vector2f m_localPosition = {};
+        float m_localRotation = 0.f;
+        bool m_dirty = true;
+    };
+}
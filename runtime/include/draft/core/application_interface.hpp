@@ -59,6 +59,14 @@ namespace Draft {
         void set_renderer(std::unique_ptr<Renderer> renderer);
         inline Renderer* get_renderer() const { return p_renderer.get(); }
 
+        /**
+         * @brief How far the time left over after tick()'s last fixed step is into the next
+         * one, in [0, 1). Renderers draw physics bodies this far from their previous pose to
+         * their latest one, so motion stays smooth when frames and steps don't line up. 1 while
+         * simulationPaused, i.e. the latest pose.
+         */
+        float get_interpolation_alpha() const;
+
     protected:
         // Protected functions
         bool dispatch(const Event& event);
@@ -25,6 +25,9 @@ namespace Draft {
         // Functions
         void render(Time dt, RenderLayer layer) override;
 
+        // All of its work is in render(), update() touches nothing
+        std::optional<SystemAccess> get_access() const override { return SystemAccess(); }
+
         DRAFT_REFLECTABLE(AudioSystem, dopplerSensitivity)
     };
 }
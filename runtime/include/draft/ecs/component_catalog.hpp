@@ -5,16 +5,22 @@
 #include "draft/ecs/gizmo_context.hpp"
 #include "draft/util/reflectable.hpp"
 #include "draft/util/serialization/serializer.hpp"
+#include "draft/util/string_id.hpp"
 
 #include <algorithm>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Draft {
@@ -37,6 +43,53 @@ namespace Draft {
         { value.draw_gizmo(ctx, entity) } -> std::same_as<void>;
     };
 
+    namespace Detail {
+        template<typename T>
+        struct TemplateArguments { using type = std::tuple<>; };
+
+        template<template<typename...> class C, typename... Args>
+        struct TemplateArguments<C<Args...>> { using type = std::tuple<Args...>; };
+    }
+
+    /**
+     * @brief True if decoding a T touches nothing but the T itself and the read-only id table of
+     * the active SceneSerializationContext, so it may run off the loading thread. Checked through
+     * reflected fields and template arguments (a vector's elements, an optional's value). A type
+     * with its own serialize/deserialize members is opaque and assumed not to be, Entity aside:
+     * Resource<T> resolves through the single-threaded AssetManager, and components like
+     * SoundComponent build audio objects while decoding.
+     */
+    template<typename T>
+    constexpr bool is_decodable_off_thread(){
+        using U = std::remove_cv_t<T>;
+
+        if constexpr(std::is_same_v<U, Entity>){
+            return true;
+        } else if constexpr(Serializer::BinarySerializable<U> || Serializer::JsonSerializable<U>){
+            return false;
+        } else {
+            bool fields = true;
+
+            if constexpr(Reflectable<U>){
+                fields = std::apply([](const auto&... field){
+                    return (is_decodable_off_thread<typename std::remove_cvref_t<decltype(field)>::ValueType>() && ...);
+                }, U::reflect());
+            }
+
+            return fields && []<typename... Args>(std::tuple<Args...>*){
+                return (is_decodable_off_thread<Args>() && ...);
+            }(static_cast<typename Detail::TemplateArguments<U>::type*>(nullptr));
+        }
+    }
+
+    /**
+     * @brief Components of one type decoded ahead of being added to any entity, see
+     * ComponentTypeInterface::decode().
+     */
+    struct DecodedComponents {
+        virtual ~DecodedComponents() = default;
+    };
+
     /**
      * @brief Type-erased base of ComponentTypeCatalogEntry<T>, letting ComponentCatalog hold a
      * heterogeneous collection of registered component types behind one type_index/name-keyed
@@ -83,6 +136,63 @@ namespace Draft {
         virtual void deserialize(Entity entity, JSON& json) const = 0;
         virtual void deserialize(Entity entity, Binary::ByteView data) const = 0;
 
+        /**
+         * @brief True if this component type's Binary encoding is its raw memory (see
+         * Serializer::is_bulk_copyable()), so serialize_pool() writes the whole pool at once.
+         */
+        virtual bool is_bulk_copyable() const = 0;
+
+        /**
+         * @brief Appends every instance of this component in @p scene: its element size, then the
+         * owning entities' ids (mapped through @p entityToId) in storage order, then the
+         * components themselves in that same order. Requires is_bulk_copyable().
+         * @return How many components were written.
+         */
+        virtual uint32_t serialize_pool(const Scene& scene, const std::unordered_map<entt::entity, uint32_t>& entityToId, Binary::ByteArray& out) const = 0;
+
+        /**
+         * @brief Restores @p count components written by serialize_pool() into @p registry, onto
+         * @p idToEntity's entities, assigning over any that already exist. Falls back to decoding
+         * one component at a time when this host can't take the raw bytes as is.
+         * @throws std::runtime_error if @p data is truncated, references an unknown id, or was
+         * written with a different element size.
+         */
+        virtual void deserialize_pool(Registry& registry, std::span<const entt::entity> idToEntity, Binary::ByteView data, uint32_t count) const = 0;
+
+        /**
+         * @brief True if decode() may run off the loading thread (see is_decodable_off_thread()).
+         */
+        virtual bool decodes_off_thread() const = 0;
+
+        /**
+         * @brief Decodes one fresh component per entry of @p payloads, without touching any
+         * registry. Needs a SceneSerializationContext active on the calling thread.
+         */
+        virtual std::unique_ptr<DecodedComponents> decode(std::span<const Binary::ByteView> payloads) const = 0;
+        virtual std::unique_ptr<DecodedComponents> decode(std::span<JSON* const> payloads) const = 0;
+
+        /**
+         * @brief Adds @p decoded's components to @p entities, pairwise and in order, with the same
+         * result deserialize() would have had: an entity that already has this component gets it
+         * overwritten (binary) or its JSON merged into it in place.
+         */
+        virtual void emplace(Registry& registry, std::span<const entt::entity> entities, DecodedComponents& decoded) const = 0;
+
+        /**
+         * @brief Moves every instance of this component out of @p from into @p to, in @p from's
+         * storage order, onto `targets[entt::to_entity(e)]` for each owner e, overwriting any
+         * instance already there. Used to publish a staging registry (see SceneStreamLoader).
+         */
+        virtual void transfer(Registry& from, Registry& to, std::span<const entt::entity> targets) const = 0;
+
+        /**
+         * @brief Copies every instance of this component in @p from onto the same entity ids in
+         * @p to, which must already be valid there, assigning over any instance already there.
+         * Keeps @p from's storage order when @p to's pool starts out empty. Used by
+         * Scene::snapshot() and Scene::restore().
+         */
+        virtual void copy_pool(const Registry& from, Registry& to) const = 0;
+
         /**
          * @brief Calls @p visitor once per reflected field of this component on @p entity, which
          * must already have(entity). Generic, reflection-driven hook meant for an editor's
@@ -167,6 +277,197 @@ namespace Draft {
             entity.add_component<T>(component);
         }
 
+        bool is_bulk_copyable() const override {
+            // In-place deletion leaves tombstones in the packed array, which can't be copied out whole
+            return !entt::component_traits<T>::in_place_delete && Serializer::is_bulk_copyable<T>();
+        }
+
+        uint32_t serialize_pool(const Scene& scene, const std::unordered_map<entt::entity, uint32_t>& entityToId, Binary::ByteArray& out) const override {
+            constexpr std::size_t pageSize = entt::component_traits<T>::page_size;
+            constexpr uint32_t elementSize = pageSize == 0 ? 0 : sizeof(T);
+
+            const auto* storage = scene.get_registry().storage<T>();
+            const std::size_t count = storage ? storage->size() : 0;
+
+            Binary::Writer writer(out);
+            writer.write(elementSize);
+            writer.reserve(count * (sizeof(uint32_t) + elementSize));
+
+            for(std::size_t i = 0; i < count; i++)
+                writer.write(entityToId.at(storage->data()[i]));
+
+            // Empty (tag) types have no payload pages at all, the ids alone are the pool
+            if constexpr(pageSize != 0){
+                for(std::size_t first = 0; first < count; first += pageSize){
+                    const auto* bytes = reinterpret_cast<const std::byte*>(storage->raw()[first / pageSize]);
+                    writer.write_bytes(Binary::ByteView(bytes, std::min(pageSize, count - first) * sizeof(T)));
+                }
+            }
+
+            return static_cast<uint32_t>(count);
+        }
+
+        void deserialize_pool(Registry& registry, std::span<const entt::entity> idToEntity, Binary::ByteView data, uint32_t count) const override {
+            constexpr std::size_t pageSize = entt::component_traits<T>::page_size;
+            constexpr uint32_t expectedSize = pageSize == 0 ? 0 : sizeof(T);
+
+            uint32_t elementSize = 0;
+            Binary::read_and_advance(data, elementSize);
+
+            if(elementSize != expectedSize)
+                throw std::runtime_error("ComponentTypeCatalogEntry::deserialize_pool(): '" + m_name + "' was saved with a different size");
+
+            if(data.size() < std::size_t(count) * (sizeof(uint32_t) + elementSize))
+                throw std::runtime_error("ComponentTypeCatalogEntry::deserialize_pool(): pool out of bounds");
+
+            Binary::ByteView ids = data.subspan(0, std::size_t(count) * sizeof(uint32_t));
+            Binary::ByteView values = data.subspan(ids.size(), std::size_t(count) * elementSize);
+
+            std::vector<entt::entity> entities(count);
+            for(uint32_t i = 0; i < count; i++){
+                uint32_t id = 0;
+                Binary::read_and_advance(ids, id);
+
+                if(id >= idToEntity.size())
+                    throw std::runtime_error("ComponentTypeCatalogEntry::deserialize_pool(): unknown entity id");
+
+                entities[i] = idToEntity[id];
+            }
+
+            // The raw bytes are this type's canonical encoding, so a host that can't adopt them
+            // directly can still decode them one component at a time
+            if(!is_bulk_copyable()){
+                std::vector<Binary::ByteView> payloads(count);
+                for(uint32_t i = 0; i < count; i++)
+                    payloads[i] = values.subspan(std::size_t(i) * elementSize, elementSize);
+
+                emplace(registry, entities, *decode(payloads));
+                return;
+            }
+
+            if constexpr(pageSize == 0){
+                std::erase_if(entities, [&](entt::entity e){ return registry.all_of<T>(e); });
+                registry.insert<T>(entities.begin(), entities.end());
+            } else {
+                std::vector<T> components(count);
+                std::memcpy(static_cast<void*>(components.data()), values.data(), values.size());
+
+                // Entities that already have a T get it assigned over, the rest are compacted
+                // to the front and constructed with one range insert (still firing on_construct)
+                std::size_t fresh = 0;
+                for(uint32_t i = 0; i < count; i++){
+                    if(T* existing = registry.try_get<T>(entities[i])){
+                        *existing = components[i];
+                        continue;
+                    }
+
+                    entities[fresh] = entities[i];
+                    components[fresh] = components[i];
+                    fresh++;
+                }
+
+                registry.insert<T>(entities.begin(), entities.begin() + fresh, components.begin());
+            }
+        }
+
+        bool decodes_off_thread() const override { return is_decodable_off_thread<T>(); }
+
+        std::unique_ptr<DecodedComponents> decode(std::span<const Binary::ByteView> payloads) const override {
+            auto decoded = std::make_unique<Decoded>();
+            decoded->values.resize(payloads.size());
+
+            for(std::size_t i = 0; i < payloads.size(); i++)
+                Serializer::deserialize(decoded->values[i], payloads[i]);
+
+            return decoded;
+        }
+
+        std::unique_ptr<DecodedComponents> decode(std::span<JSON* const> payloads) const override {
+            auto decoded = std::make_unique<Decoded>();
+            decoded->values.resize(payloads.size());
+            decoded->sources.assign(payloads.begin(), payloads.end());
+
+            // Read through const, several threads may be decoding out of the same document
+            for(std::size_t i = 0; i < payloads.size(); i++)
+                Serializer::deserialize(decoded->values[i], std::as_const(*payloads[i]));
+
+            return decoded;
+        }
+
+        void emplace(Registry& registry, std::span<const entt::entity> entities, DecodedComponents& decoded) const override {
+            auto& components = static_cast<Decoded&>(decoded);
+
+            // One at a time rather than a range insert, so a construct hook that adds this same
+            // component to a later entity in the span is seen the same way deserialize() sees it
+            for(std::size_t i = 0; i < entities.size(); i++){
+                T* existing = registry.try_get<T>(entities[i]);
+
+                if(!existing){
+                    registry.emplace<T>(entities[i], std::move(components.values[i]));
+                } else if(components.sources.empty()){
+                    *existing = std::move(components.values[i]);
+                } else {
+                    Serializer::deserialize(*existing, *components.sources[i]);
+                }
+            }
+        }
+
+        void transfer(Registry& from, Registry& to, std::span<const entt::entity> targets) const override {
+            auto& storage = from.storage<T>();
+
+            // By position rather than the storage's own iterators, which walk it back to front
+            for(std::size_t i = 0; i < storage.size(); i++){
+                entt::entity source = storage.data()[i];
+                entt::entity target = targets[entt::to_entity(source)];
+
+                if constexpr(entt::component_traits<T>::page_size == 0){
+                    if(!to.all_of<T>(target))
+                        to.emplace<T>(target);
+                } else if(T* existing = to.try_get<T>(target)){
+                    *existing = std::move(storage.get(source));
+                } else {
+                    to.emplace<T>(target, std::move(storage.get(source)));
+                }
+            }
+
+            from.clear<T>();
+        }
+
+        void copy_pool(const Registry& from, Registry& to) const override {
+            const auto* storage = from.storage<T>();
+            if(!storage || storage->empty())
+                return;
+
+            const entt::sparse_set& owners = *storage;
+
+            if(!entt::component_traits<T>::in_place_delete && to.storage<T>().empty()){
+                // One insert for the whole pool. Reverse iterators walk the packed array front
+                // to back, so the copy keeps the source's order (and thus its views' order)
+                if constexpr(entt::component_traits<T>::page_size == 0)
+                    to.insert<T>(owners.rbegin(), owners.rend());
+                else
+                    to.insert<T>(owners.rbegin(), owners.rend(), storage->rbegin());
+
+                return;
+            }
+
+            // Something (e.g. a construct hook) already added some, or there may be tombstones
+            for(std::size_t i = 0; i < owners.size(); i++){
+                entt::entity owner = owners.data()[i];
+                if(owner == entt::tombstone)
+                    continue;
+
+                if constexpr(entt::component_traits<T>::page_size == 0){
+                    if(!to.all_of<T>(owner))
+                        to.emplace<T>(owner);
+                } else if(T* existing = to.try_get<T>(owner)){
+                    *existing = storage->get(owner);
+                } else {
+                    to.emplace<T>(owner, storage->get(owner));
+                }
+            }
+        }
+
         void visit_fields(Entity entity, FieldVisitor& visitor) const override {
             for_each_field(entity.get_component<T>(), [&](std::string_view name, auto& field){
                 visitor.visit(name, std::type_index(typeid(field)), const_cast<void*>(static_cast<const void*>(std::addressof(field))));
@@ -196,6 +497,13 @@ namespace Draft {
         }
 
     private:
+        struct Decoded : DecodedComponents {
+            std::vector<T> values;
+
+            // Set when decoded from JSON, which merges into an existing component rather than replacing it
+            std::vector<JSON*> sources;
+        };
+
         std::string m_name;
     };
 
@@ -227,7 +535,7 @@ namespace Draft {
             auto type = std::type_index(typeid(T));
             std::string name(T::reflect_name());
 
-            auto nameIter = m_byName.find(name);
+            auto nameIter = m_byName.find(StringId::intern(name));
             if(nameIter != m_byName.end() && nameIter->second->type() != type)
                 throw std::logic_error("ComponentCatalog::register_component(): name '" + name + "' is already registered to a different component type");
 
@@ -238,11 +546,11 @@ namespace Draft {
             if(typeIt == m_byType.end()){
                 m_order.push_back(ptr);
             }else{
-                m_byName.erase(typeIt->second->name());
+                m_byName.erase(StringId(typeIt->second->name()));
                 std::replace(m_order.begin(), m_order.end(), static_cast<ComponentTypeInterface*>(typeIt->second.get()), ptr);
             }
 
-            m_byName[ptr->name()] = ptr;
+            m_byName[StringId(ptr->name())] = ptr;
             m_byType[type] = std::move(entry);
         }
 
@@ -267,7 +575,17 @@ namespace Draft {
          * @brief Gets the catalog entry registered under @p name, or nullptr if none is.
          */
         ComponentTypeInterface* by_name(std::string_view name) const {
-            auto it = m_byName.find(std::string(name));
+            // Also checks the name itself, in case @p name was never registered but shares an id with one that was
+            ComponentTypeInterface* entry = by_name(StringId(name));
+            return entry && entry->name() == name ? entry : nullptr;
+        }
+
+        /**
+         * @brief Gets the catalog entry registered under the name @p id was hashed from, or
+         * nullptr if none is. Nothing is hashed or allocated per call.
+         */
+        ComponentTypeInterface* by_name(StringId id) const {
+            auto it = m_byName.find(id);
             return it == m_byName.end() ? nullptr : it->second;
         }
 
@@ -295,7 +613,7 @@ namespace Draft {
 
     private:
         std::unordered_map<std::type_index, std::unique_ptr<ComponentTypeInterface>> m_byType;
-        std::unordered_map<std::string, ComponentTypeInterface*> m_byName;
+        std::unordered_map<StringId, ComponentTypeInterface*> m_byName;
         std::vector<ComponentTypeInterface*> m_order;
     };
 }
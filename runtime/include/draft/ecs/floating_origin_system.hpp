@@ -0,0 +1,82 @@
+#pragma once
+
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/system.hpp"
+#include "draft/math/glm.hpp"
+#include "draft/util/reflectable.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace Draft {
+    class ParticleSystem;
+    class Scene;
+
+    typedef std::function<void(const Vector2f& shift)> OriginShiftCallback;
+
+    /**
+     * @brief Keeps coordinates near zero in large worlds. Once the target (see set_target(), or
+     * the active camera without one) is further than `threshold` from the origin, the whole scene
+     * is moved back by its position, rounded to whole units: every world of the scene's
+     * PhysicsSystem, each root TransformComponent (children follow their parent), every camera
+     * not placed by a transform, the active camera override, the particle systems given to
+     * add_particles() and anything registered with add_shift_callback().
+     *
+     * The shift happens in one pass at the end of update(), so add this system after every
+     * other one and the rest of the tick never sees coordinates from both sides of it.
+     * get_origin() accumulates where the current origin lies in the original coordinates.
+     */
+    class FloatingOriginSystem : public AbstractSystem {
+    private:
+        Scene& m_sceneRef;
+        Entity m_target;
+        Vector2d m_origin{};
+
+        std::vector<ParticleSystem*> m_particles;
+        std::vector<OriginShiftCallback> m_callbacks;
+
+        bool get_target_position(Vector2f& position);
+
+    public:
+        // Public vars
+        float threshold = 1024.f;
+
+        // Constructors
+        FloatingOriginSystem(Scene& sceneRef);
+        ~FloatingOriginSystem() override = default;
+
+        // Functions
+        void update(Time dt) override;
+
+        /**
+         * @brief Follows @p target's transform. An invalid entity (the default) follows the
+         * scene's active camera instead.
+         */
+        inline void set_target(Entity target){ m_target = target; }
+        inline Entity get_target() const { return m_target; }
+
+        /**
+         * @brief Moves @p particles along with every shift. Not owned, remove it before it dies.
+         */
+        void add_particles(ParticleSystem& particles);
+        void remove_particles(ParticleSystem& particles);
+
+        /**
+         * @brief Calls @p callback with the shift every time the origin moves, after everything
+         * else moved. For positions kept outside the scene's components.
+         */
+        void add_shift_callback(OriginShiftCallback callback);
+
+        /**
+         * @brief Moves everything by -@p shift right away, as update() does past the threshold.
+         */
+        void rebase(const Vector2f& shift);
+
+        /**
+         * @brief Where the current origin lies in the coordinates the scene started in.
+         */
+        inline const Vector2d& get_origin() const { return m_origin; }
+
+        DRAFT_REFLECTABLE(FloatingOriginSystem, threshold)
+    };
+}
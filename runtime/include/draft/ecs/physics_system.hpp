@@ -2,20 +2,52 @@
 
 #include "draft/components/joint_component.hpp"
 #include "draft/components/rigid_body_component.hpp"
+#include "draft/ecs/entity.hpp"
 #include "draft/ecs/registry.hpp"
 #include "draft/ecs/scene.hpp"
 #include "draft/ecs/system.hpp"
+#include "draft/physics/contact_event.hpp"
 #include "draft/physics/world.hpp"
 #include "draft/util/reflectable.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace Draft {
+    class ThreadPool;
+
+    /**
+     * @brief A World ContactEvent with both bodies resolved to the entities that own them.
+     */
+    struct EntityContactEvent {
+        ContactEvent event;
+        Entity entityA;
+        Entity entityB;
+    };
+
     /**
      * @brief Keeps `RigidBodyComponent`/`ColliderComponent`/joint components in sync with their
      * live box2d-backed native components via reactive `on_construct`/`on_destroy` signals, and
      * steps `World` + syncs forces/joints/bodies every fixed `update(dt)`.
+     *
+     * Only awake bodies (and ones that fell asleep this step) are synced every update. Edits to a
+     * sleeping or static body's `TransformComponent`/`RigidBodyComponent` must go through
+     * Entity::modify_component() so the `on_update` signal can flag it, a raw field write is only
+     * noticed once the body wakes up.
+     *
+     * With set_threaded(), each update() syncs the results of the step the previous update()
+     * started and then starts the next one on a dedicated thread, so stepping overlaps with
+     * whatever the main thread does until the next update().
+     *
+     * A scene can spread its bodies over several independent worlds (see add_world() and
+     * PhysicsWorldComponent), e.g. one per room. update() steps them all, concurrently when given
+     * a ThreadPool, then syncs components and gathers contact events on the calling thread in
+     * world order, so the outcome doesn't depend on which world finished first.
      */
     class PhysicsSystem : public AbstractSystem {
     private:
@@ -24,6 +56,27 @@ namespace Draft {
         Scene& m_sceneRef;
         World& m_worldRef;
 
+        // m_worldRef first, then everything add_world() was given. Not owned
+        std::vector<World*> m_worlds;
+        ThreadPool* m_pool = nullptr;
+
+        // Set while move_body() rebuilds a body, so tearing it down keeps its joint entities
+        bool m_movingBody = false;
+
+        // Owning entity of every body this system created, for resolving contact events
+        std::unordered_map<const RigidBody*, entt::entity> m_bodyEntities;
+        std::vector<EntityContactEvent> m_contactEvents;
+
+        // Bodies whose RigidBodyComponent was patched since the last update, synced even if asleep
+        std::vector<entt::entity> m_modifiedBodies;
+
+        // Bodies the last update moved, their previous pose is reset if this one doesn't
+        std::vector<entt::entity> m_movedBodies;
+
+        // Set while threaded, see set_threaded()
+        struct StepThread;
+        std::unique_ptr<StepThread> m_stepThread;
+
         // Statics
         template<typename T>
         static void construct_joint_wrapper(PhysicsSystem* system, Registry& reg, entt::entity ent){
@@ -73,7 +126,14 @@ namespace Draft {
         }
 
         // Private functions
+        World& world_for(entt::entity entity) const;
+        void step_worlds(Time dt);
+
         void update_transform(Registry& reg, entt::entity rawEnt);
+        void update_body(Registry& reg, entt::entity rawEnt);
+        void update_world(Registry& reg, entt::entity rawEnt);
+        void deconstruct_world(Registry& reg, entt::entity rawEnt);
+        void move_body(entt::entity entity);
 
         void construct_body_func(Registry& reg, entt::entity rawEnt);
         void construct_native_body_func(Registry& reg, entt::entity rawEnt);
@@ -124,6 +184,8 @@ namespace Draft {
 
         template<typename T>
         void construct_native_joint_func(Registry& reg, entt::entity rawEnt){
+            finish_step();
+
             // Make sure the entity has a joint component, otherwise a native joint cant be constructed
             if(!reg.all_of<T>(rawEnt)){
                 reg.remove<typename T::NativeType>(rawEnt);
@@ -145,9 +207,15 @@ namespace Draft {
                 return;
             }
 
-            // Construct actual joint
+            // Construct actual joint, bodies in different worlds can't be joined
             RigidBody* bodyA = jointComponent.entityA.template get_component<NativeBodyComponent>();
             RigidBody* bodyB = jointComponent.entityB.template get_component<NativeBodyComponent>();
+
+            if(bodyA->get_world() != bodyB->get_world()){
+                reg.remove<typename T::NativeType>(rawEnt);
+                return;
+            }
+
             typename T::JointDataType* data = &jointComponent;
             Joint* joint = nullptr;
 
@@ -158,7 +226,7 @@ namespace Draft {
             using JointDefT = typename JointDefFor<typename T::JointDataType>::Type;
             JointDefT definition(bodyA, bodyB, data->collideConnected);
             static_cast<typename T::JointDataType&>(definition) = *data;
-            joint = m_worldRef.create_joint(definition);
+            joint = bodyA->get_world()->create_joint(definition);
             assert(joint && "Something went wrong with a joint");
 
             // Add a handle to the entity so it can be referenced later
@@ -215,6 +283,8 @@ namespace Draft {
 
         template<typename T>
         void deconstruct_native_joint_func(Registry& reg, entt::entity rawEnt){
+            finish_step();
+
             // A joint component was removed, delete the world joint
             typename T::NativeType& nativeComponent = reg.get<typename T::NativeType>(rawEnt);
 
@@ -230,6 +300,8 @@ namespace Draft {
             }
         }
 
+        void handle_contacts();
+        void sync_body(entt::entity entity, NativeBodyComponent& handle);
         void handle_bodies();
         void handle_forces();
 
@@ -256,6 +328,64 @@ namespace Draft {
 
         // Functions
         void update(Time dt) override;
+        void on_detach() override;
+
+        /**
+         * @brief Every body, collider, force and joint component, the worlds (as `World`) and
+         * the contact events (as `PhysicsSystem`), so a system reading get_contact_events()
+         * declares `read<PhysicsSystem>()`. Reads PhysicsWorldComponent, and includes
+         * RelationshipSystem::get_listener_access() (which covers WorldTransformSystem's).
+         */
+        std::optional<SystemAccess> get_access() const override;
+
+        /**
+         * @brief Moves World stepping onto a dedicated thread, one step ahead of the synced
+         * components, or back onto the calling thread.
+         *
+         * While threaded, a step is in flight between update()s. The component hooks wait for it
+         * before touching the World, but anything else using the World or a RigidBody directly
+         * (queries, RigidBodyComponent's getters, ...) must call finish_step() first.
+         */
+        void set_threaded(bool threaded);
+        inline bool is_threaded() const { return m_stepThread != nullptr; }
+
+        /**
+         * @brief Blocks until the step the last update() started is done. Returns right away
+         * when not threaded or nothing is in flight.
+         * @throws Whatever World::step() threw on the stepping thread.
+         */
+        void finish_step();
+
+        /**
+         * @brief Adds another world for bodies to live in, stepped alongside the one this system
+         * was constructed with (world 0). It must outlive this system. Bodies already waiting
+         * for this index in world 0 (see PhysicsWorldComponent) move over.
+         * @return Its index, for PhysicsWorldComponent::world.
+         */
+        uint32_t add_world(World& world);
+        inline World& get_world(uint32_t index = 0) const { return *m_worlds.at(index); }
+        inline size_t get_world_count() const { return m_worlds.size(); }
+
+        /**
+         * @brief Steps the worlds across @p pool's workers and the calling thread when there's
+         * more than one. Null (the default) steps them one after another. Not owned.
+         */
+        inline void set_thread_pool(ThreadPool* pool){ m_pool = pool; }
+
+        /**
+         * @brief Moves every world and the bookkeeping of every body by -@p shift, waiting for a
+         * step in flight first. The bodies' TransformComponents must be moved by the same amount
+         * before the next update(), or it reads the difference as a teleport. See
+         * FloatingOriginSystem, which does both.
+         */
+        void rebase_origin(const Vector2f& shift);
+
+        /**
+         * @brief Contact events from the last update(), between bodies owned by this scene, in
+         * world order. Valid until the next update(), meant to be read by systems running after
+         * this one.
+         */
+        inline std::span<const EntityContactEvent> get_contact_events() const { return m_contactEvents; }
 
         // No fields of its own to save, m_registryRef/m_sceneRef/m_worldRef are construction
         // dependencies (see SystemFactory), not tunable state. Empty so PhysicsSystem can still
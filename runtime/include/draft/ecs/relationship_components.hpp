@@ -2,6 +2,7 @@
 
 #include "draft/ecs/entity.hpp"
 #include "draft/util/reflectable.hpp"
+#include <cstddef>
 #include <vector>
 
 namespace Draft {
@@ -11,6 +12,11 @@ namespace Draft {
      */
     struct ChildComponent {
         Entity parent;
+
+        // Where this entity sits in parent's ParentComponent::children, so detaching doesn't
+        // have to search for it. Only a hint, checked before use, since anything may rewrite
+        // children directly (e.g. deserializing over an existing ParentComponent).
+        std::size_t indexInParent = 0;
         
         DRAFT_REFLECTABLE(ChildComponent, parent)
     };
@@ -18,6 +24,11 @@ namespace Draft {
     /**
      * @brief Attached to an entity that has children, RelationshipSystem keeps this in sync
      * with each child's ChildComponent.
+     *
+     * New children are appended, so children stays in attach order until one is detached.
+     * Detaching is O(1): the child is found through its stored index and swap-removed, so the
+     * last child moves into its slot and sibling order is not kept past that point. Code that
+     * needs a particular order may rewrite children directly, the stored index is only a hint.
      */
     struct ParentComponent {
         std::vector<Entity> children;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "draft/ecs/registry.hpp"
+#include "draft/ecs/system.hpp"
 
 #include <unordered_set>
 
@@ -33,5 +34,12 @@ namespace Draft {
 
         RelationshipSystem& operator=(const RelationshipSystem& other) = delete;
         RelationshipSystem& operator=(RelationshipSystem&& other) = delete;
+
+        /**
+         * @brief What the listeners touch when a ChildComponent is added or removed, including
+         * WorldTransformSystem's. Removing a ParentComponent that still has children destroys
+         * them, which no declared system may do.
+         */
+        static SystemAccess get_listener_access();
     };
 }
@@ -26,6 +26,9 @@ namespace Draft {
         // Functions
         void render(Time dt, RenderLayer layer) override;
         RenderLayer get_render_layers() const override { return RenderLayer::Geometry; }
+
+        // All of its work is in render(), update() touches nothing
+        std::optional<SystemAccess> get_access() const override { return SystemAccess(); }
         
         DRAFT_REFLECTABLE(RenderSystem)
     };
@@ -2,18 +2,22 @@
 
 #include "draft/ecs/registry.hpp"
 #include "draft/ecs/relationship_system.hpp"
+#include "draft/ecs/scene_snapshot.hpp"
 #include "draft/ecs/system.hpp"
+#include "draft/ecs/world_transform_system.hpp"
 #include "draft/input/event.hpp"
 #include "draft/rendering/camera.hpp"
 #include "draft/util/time.hpp"
 #include <optional>
 
 namespace Draft {
+    class AssetManager;
+    class Engine;
     class Entity;
 
     /**
      * @brief A pure ECS container. An entity registry, entity creation, parent/child
-     * relationships (RelationshipSystem), and whatever per-tick systems are registered against
+     * relationships (RelationshipSystem), cached world transforms (WorldTransformSystem), and whatever per-tick systems are registered against
      * it (SystemRegistry)
      */
     class Scene {
@@ -21,7 +25,7 @@ namespace Draft {
         Scene();
         Scene(const Scene& other) = delete;
         Scene& operator=(const Scene& other) = delete;
-        ~Scene() = default;
+        ~Scene();
 
         Registry& get_registry();
         const Registry& get_registry() const;
@@ -34,10 +38,33 @@ namespace Draft {
          */
         Entity create_entity();
 
+        /**
+         * @brief Copies this scene's entities, every component registered in @p engine's catalog
+         * and every registered system's data into memory, pool by pool. Meant for the editor's
+         * play/stop, where a save_scene()/load_scene() round trip costs far more than a copy.
+         * Unregistered components and systems aren't captured, same as a save.
+         * @param assets Resolves Resource<T> fields in system data, must outlive the snapshot.
+         */
+        SceneSnapshot snapshot(const Engine& engine, AssetManager& assets) const;
+
+        /**
+         * @brief Replaces everything in this scene with @p snapshot, which must have been taken
+         * from this same scene. Entities come back under their original ids (versions
+         * included), so Entity handles held elsewhere from before the snapshot stay valid.
+         * Systems are re-added first, then components, so construct hooks fire as they would for
+         * load_scene().
+         * @throws std::runtime_error if @p snapshot is empty or was taken from another scene.
+         */
+        void restore(const SceneSnapshot& snapshot);
+
         /**
          * @brief Resolves the highest-priority active CameraComponent in this scene, syncing its
          * Camera's position/rotation from that entity's TransformComponent (if any) first.
          * Returns nullptr if no active CameraComponent exists. Never save this pointer, it may change or be freed.
+         *
+         * The choice is cached and only re-made after a CameraComponent is added, removed or
+         * patched, so change `active`/`priority` through Entity::modify_component() (the
+         * inspector already does). A cached camera that was deactivated directly is still noticed.
          */
         Camera* get_active_camera();
 
@@ -53,16 +80,25 @@ namespace Draft {
         bool has_active_camera_override() const;
 
         /**
-         * @brief Advances every registered system by a fixed-size @p dt, in registration order.
-         * Equivalent to get_systems().update_all(dt). Meant to be called zero or more times per
-         * frame from an accumulator loop (deterministic physics among the reasons why)
-         * see render() for the once-per-frame, variable-dt counterpart.
+         * @brief Brings every WorldTransformComponent up to date right now. Already done after
+         * each update() and before each RenderLayer::Geometry render(), call this when you need
+         * fresh world transforms anywhere else (e.g. picking right after moving something).
+         */
+        void update_world_transforms();
+
+        /**
+         * @brief Advances every registered system by a fixed-size @p dt, in registration order,
+         * then refreshes world transforms. Equivalent to get_systems().update_all(dt) followed by
+         * update_world_transforms(). Meant to be called zero or more times per frame from an
+         * accumulator loop (deterministic physics among the reasons why) see render() for the
+         * once-per-frame, variable-dt counterpart.
          */
         void update(Time dt);
 
         /**
          * @brief Runs every registered system's per-frame work with the actual, variable frame
-         * @p dt for the given @p layer, in registration order. Equivalent to get_systems().render_all(dt, layer).
+         * @p dt for the given @p layer, in registration order. Equivalent to get_systems().render_all(dt, layer),
+         * preceded by update_world_transforms() for RenderLayer::Geometry.
          */
         void render(Time dt, RenderLayer layer);
 
@@ -86,12 +122,19 @@ namespace Draft {
         bool dispatch_event(const Event& event);
 
     private:
-        // Declaration order matters, m_registry must exist before m_relationshipSystem is
-        // constructed, since its constructor calls get_registry() on this Scene.
+        // Declaration order matters, m_registry must exist before m_relationshipSystem and
+        // m_worldTransformSystem are constructed, since their constructors call get_registry()
+        // on this Scene.
         Registry m_registry;
         RelationshipSystem m_relationshipSystem;
+        WorldTransformSystem m_worldTransformSystem;
         SystemRegistry m_systems;
 
         std::optional<Camera> m_cameraOverride; // Used to override scene camera without an entity
+
+        entt::entity m_activeCamera = entt::null;
+        bool m_activeCameraDirty = true;
+
+        void camera_changed_func(Registry& reg, entt::entity rawEnt);
     };
 }
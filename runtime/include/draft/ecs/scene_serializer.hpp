@@ -5,22 +5,54 @@
 #include "draft/ecs/scene.hpp"
 #include "draft/util/files/file_handle.hpp"
 
+#include <cstddef>
+
 namespace Draft {
+    /**
+     * @brief Tuning for load_scene()/load_scene_binary(), none of which changes the loaded scene.
+     */
+    struct SceneLoadOptions {
+        /**
+         * @brief Threads decoding component data, the calling one included. Above 1, each type's
+         * components are decoded in chunks across that many threads (where the type allows it,
+         * see is_decodable_off_thread()), while adding them to the registry stays on the calling
+         * thread, one type at a time in file order, so the result matches a serial load exactly.
+         */
+        std::size_t decodeThreads = 1;
+    };
+
+    /**
+     * @brief Tuning for save_scene().
+     */
+    struct SceneSaveOptions {
+        /**
+         * @brief Writes JSON with no indentation or line breaks, smaller and faster to write
+         * (e.g. for autosaves) but unpleasant to diff.
+         */
+        bool compact = false;
+    };
+
     /**
      * @brief Writes every system attached to @p scene (in attach order, alongside each system's
      * own reflected data) and every live entity's registered component data to @p file as JSON.
+     * The file is streamed out entity by entity (see JSONStreamWriter) rather than built as one
+     * document first, so saving needs about the same memory whatever the scene's size.
      *
      * Only system/component types actually registered in @p engine's catalogs round-trip. A
      * system attached directly via SystemRegistry::add<T>()/emplace<T>() (bypassing
      * SystemCatalog), or a component with no matching ComponentCatalog entry, is silently
      * skipped, same as by_name()/by_type() returning nullptr anywhere else in the catalogs.
      */
-    void save_scene(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file);
+    void save_scene(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneSaveOptions& options = {});
 
     /**
      * @brief Reads a scene previously written by save_scene() into @p scene. @p scene is meant to
      * be freshly constructed, entities/components are only ever added, never cleared first.
      *
+     * The file is parsed as a stream (see read_json_stream()), never as one whole document:
+     * each entity's components are sorted into per-type columns as it's read, and components
+     * of unregistered types are dropped right away.
+     *
      * Systems are attached first (via each SystemTypeInterface::add(), constructing through the
      * type's registered factory, then deserializing its own reflected data back onto the
      * attached instance), before any entity or component exists. That way, anything a system
@@ -32,19 +64,29 @@ namespace Draft {
      * Entities are created next, all at once, before any component is added, so a component's
      * cross-reference to another entity (e.g. ChildComponent::parent) can resolve regardless of
      * which entity in the file defines it, or whether it appears earlier or later in the file.
+     * Components are then restored a whole type at a time, in registration order, the same
+     * order load_scene_binary() uses.
+     * @throws std::runtime_error if the file has no "systems" or "entities".
      */
-    void load_scene(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file);
+    void load_scene(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneLoadOptions& options = {});
 
     /**
-     * @brief Same three-pass algorithm and skip-if-unregistered semantics as save_scene(), but
-     * writes a length-prefixed binary format to @p file instead of JSON: system/entity/component
-     * counts, each system/component blob preceded by its name and byte length. The length prefix
-     * is what lets an unknown/removed type be skipped on load without knowing how to decode it.
+     * @brief Same skip-if-unregistered semantics as save_scene(), but writes a length-prefixed
+     * binary format to @p file instead of JSON: a magic/version header, each system blob preceded
+     * by its name and byte length, then a component table naming every registered type once,
+     * followed by one column per type of (entity id, byte length, blob) records. A type whose
+     * encoding is its raw memory (see Serializer::is_bulk_copyable()) instead gets its whole
+     * pool copied into its column at once. The lengths are what let an unknown/removed type (a
+     * whole column at once) be skipped on load without knowing how to decode it.
      */
     void save_scene_binary(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file);
 
     /**
      * @brief Binary counterpart to load_scene(), reading the format written by save_scene_binary().
+     * Components are restored a whole column (type) at a time, in table order, which is
+     * registration order. Files from before the component table existed (no magic, one name per
+     * component) still load, as do version 2 files, which predate whole-pool columns.
+     * @throws std::runtime_error on an unknown format version or a truncated file.
      */
-    void load_scene_binary(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file);
+    void load_scene_binary(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneLoadOptions& options = {});
 }
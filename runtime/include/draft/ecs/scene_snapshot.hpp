@@ -0,0 +1,62 @@
+#pragma once
+
+#include "draft/ecs/registry.hpp"
+#include "draft/util/serialization/binary.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Draft {
+    class AssetManager;
+    class Scene;
+    struct ComponentTypeInterface;
+    struct SystemTypeInterface;
+
+    /**
+     * @brief An in-memory copy of a Scene's entities, registered components and registered
+     * systems' data, taken by Scene::snapshot() and put back by Scene::restore(). Much cheaper
+     * than a save_scene()/load_scene() round trip, but only valid for as long as the catalog
+     * entries it was taken with: reloading a game module (see ComponentCatalog::clear())
+     * invalidates every snapshot taken before it.
+     */
+    class SceneSnapshot {
+    public:
+        SceneSnapshot() = default;
+        SceneSnapshot(SceneSnapshot&& other) = default;
+        SceneSnapshot& operator=(SceneSnapshot&& other) = default;
+        SceneSnapshot(const SceneSnapshot& other) = delete;
+        SceneSnapshot& operator=(const SceneSnapshot& other) = delete;
+
+        /**
+         * @brief True if this was never filled in by Scene::snapshot().
+         */
+        bool empty() const { return !m_taken; }
+
+        /**
+         * @brief How many entities were captured.
+         */
+        std::size_t entity_count() const { return m_entities.size(); }
+
+    private:
+        friend class Scene;
+
+        struct SystemData {
+            SystemTypeInterface* entry = nullptr;
+            Binary::ByteArray data;
+        };
+
+        bool m_taken = false;
+        const Scene* m_source = nullptr;
+        AssetManager* m_assets = nullptr;
+
+        // Live entities at snapshot time, in storage order, with their exact versions
+        std::vector<entt::entity> m_entities;
+
+        // Component copies on the same entity ids as m_entities, hook-free
+        Registry m_registry;
+        std::vector<ComponentTypeInterface*> m_components;
+
+        // Registered systems in attach order
+        std::vector<SystemData> m_systems;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "draft/asset/asset_manager.hpp"
+#include "draft/core/engine.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/util/files/file_handle.hpp"
+#include "draft/util/time.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace Draft {
+    /**
+     * @brief Loads a file written by save_scene_binary() into a Scene a slice at a time, so a
+     * large level can come in over several frames instead of stalling one.
+     *
+     * Components are decoded into a private staging registry and only moved into the scene,
+     * together with the file's systems, by the pump() that finishes the load. Until then nothing
+     * the load produces is visible to the scene's systems. The exception is the entities
+     * themselves: they are created in the scene up front (component-less) so that entity
+     * references inside staged components already point at their final handles.
+     *
+     * Version 1 files have no column layout to slice along and load whole on the first pump().
+     */
+    class SceneStreamLoader {
+    public:
+        using CompletionCallback = std::function<void(Scene&)>;
+
+        /**
+         * @brief Reads @p file, without instantiating anything yet. @p scene, @p engine and
+         * @p assets must outlive this loader.
+         * @throws std::runtime_error on an unsupported version or a truncated file.
+         */
+        SceneStreamLoader(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file);
+
+        /**
+         * @brief Abandoning an unfinished load destroys the entities it had created in the scene.
+         */
+        ~SceneStreamLoader();
+
+        SceneStreamLoader(const SceneStreamLoader&) = delete;
+        SceneStreamLoader& operator=(const SceneStreamLoader&) = delete;
+
+        /**
+         * @brief Called once, from the pump() that finishes the load, after everything was
+         * moved into the scene.
+         */
+        void set_completion_callback(CompletionCallback callback);
+
+        /**
+         * @brief Creates entities and decodes components until @p budget has elapsed or the
+         * load finishes. Always makes some progress, even with a zero budget. The last step can
+         * overrun @p budget, and the finishing pump() also pays for moving every staged
+         * component into the scene.
+         * @return True once the load is finished.
+         */
+        bool pump(Time budget);
+
+        bool is_finished() const;
+
+        /**
+         * @brief Fraction of entities and component records instantiated so far, 0 to 1.
+         */
+        float get_progress() const;
+
+    private:
+        struct State;
+
+        void step();
+        void finish();
+
+        Scene& m_scene;
+        const Engine& m_engine;
+        AssetManager& m_assets;
+        FileHandle m_file;
+        CompletionCallback m_callback;
+        std::unique_ptr<State> m_state;
+    };
+}
@@ -2,16 +2,69 @@
 
 #include "draft/input/event.hpp"
 #include "draft/rendering/render_layer.hpp"
+#include "draft/util/thread_pool.hpp"
 #include "draft/util/time.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
 namespace Draft {
+    /**
+     * @brief The component types a system's update() reads and writes, so SystemRegistry can
+     * run systems that don't touch the same data at the same time (see
+     * SystemRegistry::set_worker_threads()).
+     *
+     * Two systems conflict when either writes a type the other reads or writes. Types are
+     * whatever the system touches, usually components, but any type works as a tag for shared
+     * state that isn't a component (e.g. `write<AudioDevice>()`).
+     *
+     * That includes whatever the registry's listeners touch on the system's behalf: adding or
+     * removing a component runs every hook connected to it on the same thread (see
+     * WorldTransformSystem::get_listener_access() and RelationshipSystem::get_listener_access()).
+     * Creating or destroying entities, or viewing a component type nothing has created storage
+     * for yet, changes the registry itself, so a system doing either shouldn't declare access.
+     */
+    struct SystemAccess {
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+
+        template<typename... Ts>
+        SystemAccess& read(){
+            (reads.push_back(std::type_index(typeid(Ts))), ...);
+            return *this;
+        }
+
+        template<typename... Ts>
+        SystemAccess& write(){
+            (writes.push_back(std::type_index(typeid(Ts))), ...);
+            return *this;
+        }
+
+        /**
+         * @brief Adds everything @p other reads and writes, e.g. the listeners a system's
+         * update() sets off.
+         */
+        SystemAccess& include(const SystemAccess& other){
+            reads.insert(reads.end(), other.reads.begin(), other.reads.end());
+            writes.insert(writes.end(), other.writes.begin(), other.writes.end());
+            return *this;
+        }
+
+        /**
+         * @brief Whether this and @p other can't safely run concurrently.
+         */
+        bool conflicts_with(const SystemAccess& other) const;
+    };
+
     /**
      * @brief Base of anything registered into a SystemRegistry. A per-tick behavior attached
      * to a Scene (physics, rendering, gameplay logic, ...).
@@ -82,6 +135,18 @@ namespace Draft {
          * Default no-op, returns false.
          */
         virtual bool on_event(const Event& event) { return false; }
+
+        /**
+         * @brief What this system's update() touches. Queried again whenever the registry's set
+         * of systems changes, not every frame.
+         * Declaring it lets SystemRegistry run this system's update() on a worker thread,
+         * concurrently with other declared systems it doesn't conflict with.
+         *
+         * Default nullopt: undeclared, update() always runs on the calling thread with every
+         * system registered before it finished and none registered after it started, exactly
+         * like a registry without worker threads.
+         */
+        virtual std::optional<SystemAccess> get_access() const { return std::nullopt; }
     };
 
     /**
@@ -106,18 +171,7 @@ namespace Draft {
 
             auto ptr = std::make_unique<T>(std::forward<Args>(args)...);
             T& ref = *ptr;
-
-            auto type = std::type_index(typeid(T));
-            if(!m_systems.contains(type))
-                m_order.push_back(type);
-            else if(m_attached)
-                m_systems[type]->on_detach();
-
-            m_systems[type] = std::move(ptr);
-
-            if(m_attached)
-                ref.on_attach();
-
+            insert(std::type_index(typeid(T)), std::move(ptr));
             return ref;
         }
 
@@ -130,18 +184,7 @@ namespace Draft {
             static_assert(std::is_base_of_v<AbstractSystem, T>, "SystemRegistry::emplace<T>(): T must derive from AbstractSystem");
 
             T& ref = static_cast<T&>(*systemPtr);
-
-            auto type = std::type_index(typeid(T));
-            if(!m_systems.contains(type))
-                m_order.push_back(type);
-            else if(m_attached)
-                m_systems[type]->on_detach();
-
-            m_systems[type] = std::move(systemPtr);
-
-            if(m_attached)
-                ref.on_attach();
-
+            insert(std::type_index(typeid(T)), std::move(systemPtr));
             return ref;
         }
 
@@ -200,8 +243,11 @@ namespace Draft {
             if(m_attached)
                 it->second->on_detach();
 
+            auto index = std::find(m_order.begin(), m_order.end(), type) - m_order.begin();
+            m_order.erase(m_order.begin() + index);
+            m_ordered.erase(m_ordered.begin() + index);
             m_systems.erase(it);
-            std::erase(m_order, type);
+            m_scheduleDirty = true;
             return true;
         }
 
@@ -213,7 +259,9 @@ namespace Draft {
                 notify_detach_all();
 
             m_order.clear();
+            m_ordered.clear();
             m_systems.clear();
+            m_scheduleDirty = true;
         }
 
         /**
@@ -223,10 +271,25 @@ namespace Draft {
          */
         const std::vector<std::type_index>& registered_types() const { return m_order; }
 
+        /**
+         * @brief Sets how many worker threads update_all() may spread systems across. Zero (the
+         * default) runs every system serially on the calling thread.
+         */
+        void set_worker_threads(std::size_t count);
+        std::size_t get_worker_threads() const { return m_pool ? m_pool->worker_count() : 0; }
+
         /**
          * @brief Calls update(dt) on every registered system, in the order each was first
          * added. Meant to be driven at a fixed timestep, possibly several times (or not at all)
          * per frame.
+         *
+         * With worker threads (see set_worker_threads()), systems declaring their access (see
+         * AbstractSystem::get_access()) may run concurrently, but a system still only starts
+         * once every conflicting system registered before it finished, so the observable order
+         * between systems sharing data is the same as the serial one.
+         *
+         * @throws Whatever the first throwing system threw, once every system already running
+         * finished. Systems that hadn't started yet are skipped.
          */
         void update_all(Time dt);
 
@@ -258,11 +321,53 @@ namespace Draft {
         bool dispatch_event(const Event& event);
 
     private:
+        // One system in the update_all() dependency graph
+        struct ScheduleNode {
+            AbstractSystem* system = nullptr;
+            std::optional<SystemAccess> access;
+            std::vector<std::size_t> successors;
+            std::size_t predecessors = 0;
+        };
+
+        // A run of declared systems scheduled together, or a single undeclared system run alone
+        struct ScheduleSegment {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            bool parallel = false;
+        };
+
+        // Registers (or replaces) the system under type, keeping every side table in step
+        void insert(std::type_index type, std::unique_ptr<AbstractSystem> systemPtr);
+
         // Calls on_detach() on every currently-registered system
         void notify_detach_all();
 
+        // Rebuilds m_schedule/m_segments from the current registration order
+        void rebuild_schedule();
+
+        // Runs every system in segment on the pool, honoring m_schedule's edges
+        void run_parallel(const ScheduleSegment& segment, Time dt);
+
+        // Pool task: updates one node, then releases whichever successors it was the last
+        // predecessor of
+        void run_node(std::size_t index, Time dt);
+
         std::unordered_map<std::type_index, std::unique_ptr<AbstractSystem>> m_systems;
         std::vector<std::type_index> m_order;
+        std::vector<AbstractSystem*> m_ordered;
         bool m_attached = false;
+
+        std::unique_ptr<ThreadPool> m_pool;
+        std::vector<ScheduleNode> m_schedule;
+        std::vector<ScheduleSegment> m_segments;
+        bool m_scheduleDirty = true;
+
+        // Per-run state shared with the pool's tasks
+        std::unique_ptr<std::atomic<std::size_t>[]> m_pendingPredecessors;
+        std::size_t m_remaining = 0;
+        std::exception_ptr m_error;
+        std::atomic<bool> m_failed = false;
+        std::mutex m_runMutex;
+        std::condition_variable m_runCv;
     };
 }
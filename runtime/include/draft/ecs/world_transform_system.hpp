@@ -0,0 +1,71 @@
+#pragma once
+
+#include "draft/ecs/registry.hpp"
+#include "draft/ecs/system.hpp"
+#include "draft/math/glm.hpp"
+
+#include <vector>
+
+namespace Draft {
+    class Scene;
+
+    /**
+     * @brief Maintains a WorldTransformComponent on every entity with a TransformComponent.
+     * Owned directly by Scene (not through SystemRegistry), like RelationshipSystem, since it
+     * runs as part of Scene::update()/Scene::render() rather than as a registered system.
+     *
+     * update() only recomputes subtrees rooted at an entity whose local transform or parent
+     * changed since the last pass, each subtree once, parents before children. An ancestor
+     * without a TransformComponent counts as the identity.
+     *
+     * Finding the changed local transforms isn't free though. They're plain fields, written
+     * directly (by PhysicsSystem, FloatingOriginSystem and game code) as often as through
+     * patch(), so every pass compares each TransformComponent against the pose its world
+     * transform was last computed from. Even an idle pass is O(entities with a transform),
+     * a cheap linear walk over two pools. Only the recomputation is O(changed subtrees).
+     */
+    class WorldTransformSystem {
+    private:
+        // One pending node of the subtree walk, with the world pose of its nearest transformed ancestor
+        struct PendingNode {
+            entt::entity entity;
+            Vector2f parentPosition;
+            float parentRotation;
+        };
+
+        Registry& m_registryRef;
+
+        std::vector<entt::entity> m_changed;
+        std::vector<PendingNode> m_stack;
+
+        void construct_transform_func(Registry& reg, entt::entity rawEnt);
+        void deconstruct_transform_func(Registry& reg, entt::entity rawEnt);
+        void hierarchy_changed_func(Registry& reg, entt::entity rawEnt);
+
+        void mark_dirty(entt::entity rawEnt);
+        void update_subtree(entt::entity root);
+
+    public:
+        WorldTransformSystem(Scene& sceneRef);
+        WorldTransformSystem(const WorldTransformSystem& other) = delete;
+        WorldTransformSystem(WorldTransformSystem&& other) = delete;
+        ~WorldTransformSystem();
+
+        WorldTransformSystem& operator=(const WorldTransformSystem& other) = delete;
+        WorldTransformSystem& operator=(WorldTransformSystem&& other) = delete;
+
+        /**
+         * @brief Brings every WorldTransformComponent up to date with the local transforms and
+         * hierarchy as they are right now. O(entities with a transform) to find what changed,
+         * see the class doc.
+         */
+        void update();
+
+        /**
+         * @brief What the listeners touch when a TransformComponent or ChildComponent is added
+         * or removed. update() itself runs after SystemRegistry::update_all(), never alongside
+         * a system, but a declared system adding or removing either must include this.
+         */
+        static SystemAccess get_listener_access();
+    };
+}
@@ -6,6 +6,7 @@
 #include "draft/util/files/file_handle.hpp"
 #include "draft/util/json.hpp"
 #include "draft/util/reflectable.hpp"
+#include "draft/util/string_id.hpp"
 
 #include <initializer_list>
 #include <string>
@@ -43,14 +44,29 @@ namespace Draft {
      * set_bindings(), reset_to_defaults()) without touching gameplay code. save_bindings()/
      * load_overrides() persist and restore that current state as JSON, independent of whatever
      * bind_default() calls run on the next launch.
+     *
+     * Actions are stored by StringId. The queries called every frame also take one directly
+     * (e.g. `is_pressed("Jump"_sid)`), skipping the per-call string hash the name overloads do.
+     * The name overloads also compare the action's name, and binding a name whose id is already
+     * taken by a different action throws std::logic_error.
      */
     class InputManager : public AbstractSystem {
     private:
+        struct Action {
+            std::string name;
+            std::vector<InputBinding> bindings;
+        };
+
+        using ActionMap = std::unordered_map<StringId, Action>;
+
         Keyboard& keyboardRef;
         Mouse& mouseRef;
 
-        std::unordered_map<std::string, std::vector<InputBinding>> m_defaultBindings;
-        std::unordered_map<std::string, std::vector<InputBinding>> m_bindings;
+        ActionMap m_defaultBindings;
+        ActionMap m_bindings;
+
+        std::vector<InputBinding>& bindings_for(ActionMap& actions, const std::string& action);
+        static const Action* find_action(const ActionMap& actions, const std::string& action);
 
         bool is_binding_pressed(const InputBinding& binding) const;
         bool is_binding_just_pressed(const InputBinding& binding) const;
@@ -58,11 +74,15 @@ namespace Draft {
     public:
         InputManager(Keyboard& keyboardRef, Mouse& mouseRef);
 
+        // Only queried, update() touches nothing
+        std::optional<SystemAccess> get_access() const override { return SystemAccess(); }
+
         /**
          * @brief Declares @p action's default binding(s), meant to be called from game code once
          * at startup for every action it defines. Also becomes @p action's current binding the
          * first time @p action is seen, so is_pressed() works immediately, even before
          * load_overrides() runs.
+         * @throws std::logic_error if @p action's id is already bound under a different name.
          */
         void bind_default(const std::string& action, InputBinding binding);
         void bind_default(const std::string& action, std::initializer_list<InputBinding> bindings);
@@ -99,18 +119,22 @@ namespace Draft {
         void reset_to_defaults(const std::string& action);
 
         bool has_action(const std::string& action) const;
+        bool has_action(StringId action) const;
         const std::vector<InputBinding>& get_bindings(const std::string& action) const;
+        const std::vector<InputBinding>& get_bindings(StringId action) const;
         const std::vector<InputBinding>& get_default_bindings(const std::string& action) const;
 
         /**
          * @brief True if any of @p action's current bindings is currently held down.
          */
         bool is_pressed(const std::string& action) const;
+        bool is_pressed(StringId action) const;
 
         /**
          * @brief True if any of @p action's current bindings transitioned to pressed this frame.
          */
         bool is_just_pressed(const std::string& action) const;
+        bool is_just_pressed(StringId action) const;
 
         /**
          * @brief Dumps every action's current bindings (the "current setup") to JSON, keyed by
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Draft {
+    /**
+     * @brief Generation-checked reference to a RigidBody in its World. Unlike a `RigidBody*`,
+     * a handle outliving its body is safe to keep around: World::get_body() returns nullptr for
+     * it, even after the body's slot has been reused by a new one.
+     */
+    struct BodyHandle {
+        static constexpr uint32_t NULL_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index = NULL_INDEX;
+        uint32_t generation = 0;
+
+        constexpr bool is_null() const { return index == NULL_INDEX; }
+        constexpr bool operator==(const BodyHandle& other) const = default;
+    };
+};
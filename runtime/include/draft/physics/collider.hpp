@@ -16,6 +16,11 @@ namespace Draft {
         // Variables
         std::vector<std::unique_ptr<Shape>> shapes;
 
+        // `shapes` with this collider's own transform undone, so a new transform is applied to
+        // them directly instead of undoing the old one first. Built on the first transform change
+        // after the shapes themselves changed, emptied whenever they do
+        std::vector<std::unique_ptr<Shape>> localShapes;
+
         Vector2f position = { 0, 0 };
         Vector2f origin = { 0, 0 };
         Vector2f scale = { 1, 1 };
@@ -28,6 +33,7 @@ namespace Draft {
         void copy_collider(const Collider& other);
         void move_collider(Collider&& other);
         void set_new_transform(Vector2f newPosition, Vector2f newOrigin, Vector2f newScale, float newRotation);
+        void cache_local_shapes();
 
         // Clears rigidBodyPtr/fixtures without touching box2d, called by RigidBody's destructor
         // when it is torn down while this Collider is still attached to it, so this Collider
@@ -50,7 +56,7 @@ namespace Draft {
 
         // Functions
         inline const uint get_shape_count() const { return shapes.size(); };
-        inline const auto& get_shapes() const { return shapes; };
+        inline const auto& get_shapes() const { return shapes; }; // Geometry edited through these isn't seen by later transform changes, re-add the shape instead
         Shape* add_shape(const Shape& shape);
         void del_shape(const Shape* shapePtr);
         void clear();
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "draft/math/glm.hpp"
+
+#include <cstdint>
+
+namespace Draft {
+    class Fixture;
+    class RigidBody;
+
+    enum class ContactEventType : uint8_t {
+        BEGIN_CONTACT = 0,  // Two solid fixtures started touching
+        END_CONTACT,        // Two solid fixtures stopped touching
+        SENSOR_BEGIN,       // A sensor fixture started overlapping another fixture
+        SENSOR_END,         // A sensor fixture stopped overlapping another fixture
+        IMPULSE             // The solver resolved a touching contact, see `normalImpulse`
+    };
+
+    /**
+     * @brief One contact change recorded during World::step(). For sensor events `fixtureA` is
+     * always the sensor. `point`, `normal` and `normalImpulse` are only filled in for
+     * BEGIN_CONTACT and IMPULSE, the normal pointing from A to B.
+     */
+    struct ContactEvent {
+        ContactEventType type = ContactEventType::BEGIN_CONTACT;
+        RigidBody* bodyA = nullptr;
+        RigidBody* bodyB = nullptr;
+        Fixture* fixtureA = nullptr;
+        Fixture* fixtureB = nullptr;
+        Vector2f point{0.f, 0.f};
+        Vector2f normal{0.f, 0.f};
+        float normalImpulse = 0.f;
+    };
+};
@@ -74,6 +74,7 @@ namespace Draft {
         float get_stiffness() const;
         float get_damping() const;
 
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB); // In place, keeps warm starting
         void set_length(float length);
         void set_min_length(float length);
         void set_max_length(float length);
@@ -99,6 +100,7 @@ namespace Draft {
         float get_max_force() const;
         float get_max_torque() const;
 
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB);
         void set_max_force(float force);
         void set_max_torque(float torque);
 
@@ -200,6 +202,9 @@ namespace Draft {
         bool is_limit_enabled() const;
         bool is_motor_enabled() const;
 
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB);
+        void set_local_axis(const Vector2f& axis); // Normalized
+        void set_reference_angle(float angle);
         void set_limits(float lower, float upper);
         void set_motor_speed(float speed);
         void set_max_motor_force(float force);
@@ -255,6 +260,8 @@ namespace Draft {
 
         void enable_limit(bool flag);
         void enable_motor(bool flag);
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB);
+        void set_reference_angle(float angle);
         void set_limits(float lower, float upper);
         void set_motor_speed(float speed);
         void set_max_motor_torque(float torque);
@@ -278,6 +285,8 @@ namespace Draft {
         float get_stiffness() const;
         float get_damping() const;
 
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB);
+        void set_reference_angle(float angle);
         void set_stiffness(float hz);
         void set_damping(float damping);
 
@@ -313,6 +322,8 @@ namespace Draft {
 
         void enable_limit(bool flag);
         void enable_motor(bool flag);
+        void set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB);
+        void set_local_axis(const Vector2f& axis); // Normalized
         void set_limits(float lower, float upper);
         void set_motor_speed(float speed);
         void set_max_motor_torque(float torque);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "draft/math/glm.hpp"
+#include "draft/physics/body_handle.hpp"
 #include "draft/physics/body_type.hpp"
 #include "draft/physics/fixture.hpp"
 #include "draft/physics/fixture_def.hpp"
@@ -8,6 +9,7 @@
 #include "draft/physics/shapes/shape.hpp"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 class b2JointDef;
@@ -23,6 +25,7 @@ namespace Draft {
         std::vector<std::unique_ptr<Fixture>> fixtures;
         std::vector<Collider*> attachedColliders; // Non-owning, invalidated on destruction
         World* currentWorld = nullptr;
+        BodyHandle handle; // Assigned by the world
 
         // Constructor
         RigidBody(World* worldPtr, void* bodyPtr);
@@ -30,6 +33,11 @@ namespace Draft {
         // Private functions
         void* get_body_ptr();
 
+        // Rewrites each fixture's box2d shape from its (edited) Shape without recreating it, used
+        // by Collider. Returns false and touches nothing if one can't be, i.e. a chain whose
+        // point count changed
+        bool reshape_fixtures(std::span<Fixture* const> fixtureList);
+
     public:
         // Constructors
         RigidBody(const RigidBody& other) = delete;
@@ -45,6 +53,7 @@ namespace Draft {
 
         // Functions
         bool is_valid() const;
+        inline BodyHandle get_handle() const { return handle; }
 
         Fixture* create_fixture(const FixtureDef& def);
         Fixture* create_fixture(const Shape* shape, float density);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "draft/math/glm.hpp"
+#include "draft/physics/shapes/shape.hpp"
+
+#include <cstdint>
+
+namespace Draft {
+    class Fixture;
+
+    /**
+     * @brief Narrows a batched World query down to some fixtures. `maskBits` is matched against
+     * each fixture's PhysMask::categoryBits, the same way box2d pairs two fixtures' filters.
+     */
+    struct QueryFilter {
+        uint16_t maskBits = 0xFFFF;
+        bool includeSensors = false;
+    };
+
+    /**
+     * @brief A segment to cast from `start` to `end`, in world space.
+     */
+    struct RayQuery {
+        Vector2f start{0.f, 0.f};
+        Vector2f end{0.f, 0.f};
+    };
+
+    /**
+     * @brief A circle or polygon swept from `position`/`rotation` along `translation`, without
+     * rotating. The shape's vertices are relative to `position`.
+     */
+    struct ShapeCastQuery {
+        const Shape* shape = nullptr;
+        Vector2f position{0.f, 0.f};
+        float rotation = 0.f;
+        Vector2f translation{0.f, 0.f};
+    };
+
+    /**
+     * @brief The closest thing a ray or shape cast hit. `fixture` is null on a miss, and
+     * `fraction` is how far along the cast it was hit, from 0 to 1.
+     */
+    struct QueryHit {
+        Fixture* fixture = nullptr;
+        Vector2f point{0.f, 0.f};
+        Vector2f normal{0.f, 0.f};
+        float fraction = 1.f;
+    };
+};
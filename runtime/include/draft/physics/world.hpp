@@ -1,22 +1,37 @@
 #pragma once
 
 #include "draft/math/glm.hpp"
+#include "draft/math/rect.hpp"
 #include "draft/physics/body_def.hpp"
+#include "draft/physics/body_handle.hpp"
+#include "draft/physics/contact_event.hpp"
 #include "draft/physics/joint.hpp"
 #include "draft/physics/joint_def.hpp"
 #include "draft/physics/raycast_props.hpp"
 #include "draft/physics/rigid_body.hpp"
+#include "draft/physics/spatial_query.hpp"
 #include "draft/rendering/pipeline/renderer.hpp"
 #include "draft/util/time.hpp"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace Draft {
+    class ThreadPool;
+
     class World {
     private:
+        // Structs
+        struct BodySlot {
+            std::unique_ptr<RigidBody> body;
+            uint32_t generation = 0;
+        };
+
         // Variables
-        std::vector<std::unique_ptr<RigidBody>> rigidBodies;
+        std::vector<BodySlot> bodySlots; // Indexed by BodyHandle::index, empty slots are listed in freeBodySlots
+        std::vector<uint32_t> freeBodySlots;
+        size_t bodyCount = 0;
         std::vector<std::unique_ptr<Joint>> joints;
         Vector2d offsetShift{};
 
@@ -39,7 +54,9 @@ namespace Draft {
         // Functions
         RigidBody* create_rigid_body(const BodyDef& def);
         RigidBody* get_body(void* ptr) const;
+        RigidBody* get_body(BodyHandle handle) const;
         void destroy_body(RigidBody* rigidBodyPtr);
+        void destroy_body(BodyHandle handle);
         size_t get_body_count() const;
 
         Joint* create_joint(const JointDef& def);
@@ -50,11 +67,52 @@ namespace Draft {
         void shift_origin(const Vector2d& shift);
         inline const Vector2d& get_shift_offset() const { return offsetShift; }
 
+        /**
+         * @brief Moves everything in the world by -@p shift, the same box2d shift as
+         * shift_origin() but without recording it, so positions read back move too. For callers
+         * moving every other coordinate in the scene along with it (see FloatingOriginSystem).
+         */
+        void rebase_origin(const Vector2f& shift);
+
         void step(Time timeStep, int32_t velocityIterations, int32_t positionIterations);
 
+        /**
+         * @brief Every contact change from the last step(), in the order box2d reported them.
+         * The buffer is reused, so the view is only valid until the next step() or until one of
+         * the bodies it points at is destroyed.
+         */
+        std::span<const ContactEvent> get_contact_events() const;
+
         void raycast(RaycastCallback callback, const Vector2f& point1, const Vector2f& point2) const;
         RigidBody* test_point(const Vector2f& position) const;
 
+        /**
+         * @brief Casts every ray in @p rays and writes the closest hit of ray i to @p hits[i].
+         * With a @p pool the batch is split across its workers, which only read the world, so
+         * nothing may step or edit it until this returns.
+         * @throws std::invalid_argument if @p hits isn't as long as @p rays.
+         */
+        void raycast_batch(std::span<const RayQuery> rays, std::span<QueryHit> hits, const QueryFilter& filter = {}, ThreadPool* pool = nullptr) const;
+
+        /**
+         * @brief Finds the fixtures overlapping each of @p boxes, given as (x, y) lower corner
+         * plus size. Every box gets an equal share of @p results, box i writing to
+         * `results[i * capacity, (i + 1) * capacity)` with `capacity = results.size() / boxes.size()`.
+         * `counts[i]` is how many fixtures overlap box i in total, above capacity when some
+         * didn't fit. Threading works as in raycast_batch().
+         * @throws std::invalid_argument if @p counts isn't as long as @p boxes.
+         */
+        void overlap_batch(std::span<const FloatRect> boxes, std::span<Fixture*> results, std::span<size_t> counts, const QueryFilter& filter = {}, ThreadPool* pool = nullptr) const;
+
+        /**
+         * @brief Sweeps every circle or polygon in @p casts and writes the first fixture each one
+         * hits to @p hits[i]. A shape already overlapping something where it starts doesn't hit
+         * it, use overlap_batch() for that. Threading works as in raycast_batch().
+         * @throws std::invalid_argument if @p hits isn't as long as @p casts, or a cast has no
+         * shape or one that isn't a circle or polygon.
+         */
+        void shape_cast_batch(std::span<const ShapeCastQuery> casts, std::span<QueryHit> hits, const QueryFilter& filter = {}, ThreadPool* pool = nullptr) const;
+
         void set_debug_renderer();
         void debug_draw(Renderer& renderer, const Matrix4& m = Matrix4(1.f));
 
@@ -6,6 +6,7 @@
 #include "draft/math/rect.hpp"
 #include "draft/rendering/texture.hpp"
 #include "draft/util/files/file_handle.hpp"
+#include "draft/util/string_id.hpp"
 
 #include <optional>
 #include <string>
@@ -100,7 +101,7 @@ namespace Draft {
         // Variables
         Resource<Texture> texture;
         std::vector<AnimationFrame> frames;
-        std::unordered_map<std::string, AnimationTag> tags;
+        std::unordered_map<StringId, AnimationTag> tags;
         std::vector<AnimationSlice> slices;
         std::vector<AnimationLayer> layers;
 
@@ -116,6 +117,7 @@ namespace Draft {
 
         // Private functions
         void build_tag_playback(AnimationTag& tag);
+        const AnimationTag* find_tag(const std::string& name) const;
         TextureRegion make_region(size_t frameIndex) const;
 
     public:
@@ -142,15 +144,28 @@ namespace Draft {
          */
         TextureRegion get_frame(const std::string& tagName, float frameTime) const;
 
-        bool has_tag(const std::string& name) const { return tags.contains(name); }
+        /**
+         * @brief Same as get_frame(tagName, frameTime), with the tag looked up by id, so an
+         * animator switching tags every frame doesn't hash a string to do it.
+         * @throws std::runtime_error if @p tag isn't a known tag, or that tag has no frames.
+         */
+        TextureRegion get_frame(StringId tag, float frameTime) const;
+
+        bool has_tag(const std::string& name) const { return find_tag(name) != nullptr; }
+        bool has_tag(StringId tag) const { return tags.contains(tag); }
 
         /**
          * @throws std::runtime_error if @p name isn't a known tag.
          */
         const AnimationTag& get_tag(const std::string& name) const;
+        const AnimationTag& get_tag(StringId tag) const;
 
         const std::vector<AnimationFrame>& get_frames() const { return frames; }
-        const std::unordered_map<std::string, AnimationTag>& get_tags() const { return tags; }
+
+        /**
+         * @brief Every tag by the id of its name (see AnimationTag::name).
+         */
+        const std::unordered_map<StringId, AnimationTag>& get_tags() const { return tags; }
         const std::vector<AnimationSlice>& get_slices() const { return slices; }
         const std::vector<AnimationLayer>& get_layers() const { return layers; }
 
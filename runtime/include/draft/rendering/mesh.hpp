@@ -3,25 +3,72 @@
 #include "draft/math/glm.hpp"
 #include "draft/rendering/vertex_array.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace Draft {
     /**
-     * @brief Pure CPU-side mesh data, vertices plus optional indices/UVs/colors. No GL
+     * @brief One interleaved vertex, exactly as DrawableMesh uploads it (position at attribute
+     * 0, uv at 1, color at 2). Attributes a Mesh doesn't map keep these defaults.
+     */
+    struct MeshVertex {
+        Vector3f position{0, 0, 0};
+        Vector2f texCoord{0, 0};
+        Vector3f color{1, 1, 1};
+    };
+
+    /**
+     * @brief Index data of a Mesh. Stored 16 bits wide whenever every index fits, which halves
+     * both the upload and the GPU's index fetch bandwidth, and 32 bits wide otherwise.
+     */
+    class MeshIndices {
+    private:
+        // Variables
+        std::vector<std::uint16_t> shortIndices{};
+        std::vector<std::uint32_t> longIndices{};
+
+    public:
+        // Constructors
+        MeshIndices() = default;
+        MeshIndices(std::vector<std::uint16_t> indexArray);
+        MeshIndices(std::vector<std::uint32_t> indexArray); // Narrowed to 16 bits if every index fits
+
+        // Operators
+        std::uint32_t operator[](size_t index) const { return is_short() ? shortIndices[index] : longIndices[index]; }
+
+        // Functions
+        inline bool is_short() const { return longIndices.empty(); }
+        inline size_t size() const { return is_short() ? shortIndices.size() : longIndices.size(); }
+        inline bool empty() const { return size() == 0; }
+
+        const std::vector<std::uint16_t>& get_short() const { return shortIndices; }
+        const std::vector<std::uint32_t>& get_long() const { return longIndices; }
+
+        /**
+         * @brief GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, matching how the indices are stored.
+         */
+        int gl_type() const;
+    };
+
+    /**
+     * @brief Pure CPU-side mesh data, interleaved vertices plus optional indices. Which of
+     * the UV/color attributes actually came from the source is tracked by flags. No GL
      * dependency of its own
      */
     class Mesh {
     private:
         // Variables
-        std::vector<Vector3f> vertices{};
-        std::vector<Vector2f> texCoords{};
-        std::vector<int> indices{};
-        std::vector<Vector3f> colors{};
+        std::vector<MeshVertex> vertices{};
+        MeshIndices indices{};
 
         bool uvMapped = false; // Whether or not to use texture coordinates
         bool indexedMesh = false; // Whether or not to use indices
         bool colorMapped = false; // Whether or not to use colors coordinates
 
+        // Private functions
+        void interleave(const std::vector<Vector3f>& vertexArray, const std::vector<Vector2f>* uvArray, const std::vector<Vector3f>* colorArray);
+        void set_indices(const std::vector<int>& indexArray);
+
     public:
         // Constructors
         Mesh();
@@ -32,22 +79,26 @@ namespace Draft {
         Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<Vector3f>& colorArray); // Unindexed color-mapped mesh
         Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector3f>& colorArray); // Indexed color-mapped mesh
         Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector2f>& uvArray, const std::vector<Vector3f>& colorArray); // Indexed uv-mapped color-mapped mesh
+        Mesh(std::vector<MeshVertex> vertexArray, MeshIndices indexArray, bool uvMapped, bool colorMapped); // Already interleaved, indexed if indexArray isn't empty
 
         // Functions
         inline bool is_uv_mapped() const { return uvMapped; }
         inline bool is_indexed() const { return indexedMesh; }
         inline bool is_color_mapped() const { return colorMapped; }
 
-        const std::vector<Vector3f>& get_vertices() const;
-        const std::vector<int>& get_indices() const;
-        const std::vector<Vector2f>& get_tex_coords() const;
-        const std::vector<Vector3f>& get_colors() const;
+        const std::vector<MeshVertex>& get_vertex_data() const;
+        const MeshIndices& get_indices() const;
+
+        // De-interleaved copies of a single attribute, for tooling rather than hot paths
+        std::vector<Vector3f> get_vertices() const;
+        std::vector<Vector2f> get_tex_coords() const;
+        std::vector<Vector3f> get_colors() const;
     };
 
     /**
-     * @brief GPU-side counterpart to Mesh, owns a VertexArray built from the mesh's vertex/
-     * uv/color/index data (positions at attribute 0, uv at 1, colors at 2, matching
-     * assets/shaders/mesh/vertex.glsl) and can render it. Do not construct before an OpenGL
+     * @brief GPU-side counterpart to Mesh, owns a VertexArray holding the mesh's interleaved
+     * vertices in a single buffer (positions at attribute 0, uv at 1, colors at 2, matching
+     * assets/shaders/mesh/vertex.glsl) plus its indices, and can render it. Do not construct before an OpenGL
      * context was established.
      */
     class DrawableMesh {
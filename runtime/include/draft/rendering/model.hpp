@@ -1,6 +1,7 @@
 #pragma once
 
 #include "draft/math/glm.hpp"
+#include "draft/rendering/image.hpp"
 #include "draft/rendering/material.hpp"
 #include "draft/rendering/mesh.hpp"
 #include "draft/rendering/texture.hpp"
@@ -16,6 +17,33 @@ namespace tinygltf {
 }
 
 namespace Draft {
+    /**
+     * @brief Everything Model needs from a glTF file, decoded without touching OpenGL. Built by
+     * Model::decode(), which is safe to run off-thread, and turned into a Model (textures and
+     * vertex buffers uploaded) on the GL thread by Model(ModelData).
+     */
+    struct ModelData {
+        /**
+         * @brief A material whose texture slots are still indices into ModelData::images (-1
+         * for none) rather than live Texture pointers.
+         */
+        struct MaterialData {
+            Material3D material;
+            int baseTexture = -1;
+            int normalTexture = -1;
+            int emissiveTexture = -1;
+            int occlusionTexture = -1;
+            int roughnessTexture = -1;
+        };
+
+        std::optional<FileHandle> handle;
+        std::vector<Mesh> meshes;
+        std::vector<int> meshToMaterialMap;
+        std::vector<Matrix4> meshToMatrixMap;
+        std::vector<MaterialData> materials;
+        std::vector<Image> images; // One per material texture reference
+    };
+
     /**
      * @brief A loaded glTF (.gltf/.glb) scene
      */
@@ -24,13 +52,21 @@ namespace Draft {
         // Constructors
         Model();
         Model(const FileHandle& handle);
+        explicit Model(ModelData data);
         Model(const Model& other);
+        Model(Model&& other) noexcept;
 
         // Operators
         Model& operator=(const Model& other);
         Model& operator=(Model&& other) noexcept;
 
         // Functions
+        /**
+         * @brief Parses and decodes @p handle into CPU-side data. Touches no GL state, so it's
+         * safe to call from any thread.
+         */
+        static ModelData decode(const FileHandle& handle);
+
         void reload_materials();
         void render(const Shader& shader, const Matrix4& matrix) const;
         void reload();
@@ -46,16 +82,17 @@ namespace Draft {
         /**
          * @brief Reads @p count unsigned indices starting at @p data, using @p componentType
          * (one of glTF's unsigned component types byte, short, or int) rather than assuming a
-         * fixed width.
+         * fixed width. Byte and short indices stay 16 bits wide.
          */
-        static std::vector<int> read_indices(const unsigned char* data, int componentType, size_t count);
+        static MeshIndices read_indices(const unsigned char* data, int componentType, size_t count);
 
         static tinygltf::Model load_raw_model(const FileHandle& handle);
-        static void load_materials(const FileHandle& handle, std::vector<Material3D>& materials, std::vector<std::shared_ptr<Texture>>& embeddedTextures, const tinygltf::Model& mdl);
+        static void load_materials(const FileHandle& handle, std::vector<ModelData::MaterialData>& materials, std::vector<Image>& images, const tinygltf::Model& mdl);
         static void load_meshes(std::vector<Mesh>& meshes, std::vector<int>& meshToMaterialMap, std::vector<Matrix4>& meshToMatrixMap, std::vector<std::pair<size_t, size_t>>& meshPrimitiveRanges, const tinygltf::Model& mdl);
         static void load_nodes(std::vector<Matrix4>& meshToMatrixMap, const std::vector<std::pair<size_t, size_t>>& meshPrimitiveRanges, const tinygltf::Model& mdl);
 
-        void load(const FileHandle& handle);
+        void upload_materials(std::vector<ModelData::MaterialData>& materialData, std::vector<Image>& images);
+        void upload(ModelData&& data);
 
         // Variables
         bool reloadable;
@@ -49,6 +49,11 @@ namespace Draft {
         void update(Time timeStep);
         void render(SpriteCollection& batch);
 
+        /**
+         * @brief Moves every live particle by @p offset.
+         */
+        void translate(const Vector2f& offset);
+
     private:
         friend struct ParticleSystemTestAccess;
 
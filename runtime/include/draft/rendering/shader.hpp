@@ -55,22 +55,54 @@ namespace Draft {
         int binding;
     };
 
+    /**
+     * @brief When a Shader checks its compile and link results.
+     *
+     * Immediate checks them in the constructor and throws on failure. Deferred only submits
+     * the work, letting a driver with GL_KHR_parallel_shader_compile build many programs on its
+     * own threads while the caller carries on. The results are checked on first use instead
+     * (bind(), get_location(), ..., or an explicit wait()), and a failure there is logged and
+     * leaves the program as 0 rather than throwing, since nothing up the stack at that point
+     * is in a position to recover from it.
+     */
+    enum class ShaderLinkMode {
+        Immediate,
+        Deferred
+    };
+
+    /**
+     * @brief The raw GLSL text of a vertex/fragment pair, see Shader::read_source().
+     */
+    struct ShaderSource {
+        std::string vertex;
+        std::string fragment;
+    };
+
     /**
      * @brief A compiled+linked vertex/fragment GL shader program. Do not construct before an
      * OpenGL context was established.
+     *
+     * If a ShaderBinaryCache::set_default() cache is set, a program whose sources were linked
+     * before on the same driver is restored from its cached binary instead of being compiled.
      */
     class Shader {
     private:
         // Variables
-        unsigned int shaderId;
+        mutable unsigned int shaderId;
         const bool reloadable;
         FileHandle handle;
         mutable std::unordered_map<std::string, int> memo;
 
+        // Outstanding ShaderLinkMode::Deferred work, consumed by finish_link()
+        mutable unsigned int pendingVertex = 0;
+        mutable unsigned int pendingFragment = 0;
+        mutable std::string pendingCacheKey;
+
         // Private variables
         void cleanup();
-        void load_shaders(const char* vertexSrc, const char* fragmentSrc);
+        void load_shaders(const char* vertexSrc, const char* fragmentSrc, ShaderLinkMode mode);
         void load_from_handle(const FileHandle& shaderHandle);
+        bool finish_link(bool throwOnError) const;
 
     public:
         // Types
@@ -98,8 +130,14 @@ namespace Draft {
         >;
 
         // Constructors
-        Shader(const FileHandle& vertexHandle, const FileHandle& fragmentHandle);
-        Shader(const FileHandle& handle);
+        Shader(const FileHandle& vertexHandle, const FileHandle& fragmentHandle, ShaderLinkMode mode = ShaderLinkMode::Immediate);
+        Shader(const FileHandle& handle, ShaderLinkMode mode = ShaderLinkMode::Immediate);
+
+        /**
+         * @brief Builds a reloadable shader for the directory @p handle from @p source already
+         * read out of it (see read_source()), so the file reads can happen off-thread.
+         */
+        Shader(const FileHandle& handle, const ShaderSource& source, ShaderLinkMode mode = ShaderLinkMode::Immediate);
         Shader(const Shader& other) = delete;
         Shader(Shader&& other) noexcept;
         ~Shader();
@@ -108,7 +146,30 @@ namespace Draft {
         Shader& operator= (const Shader& other) = delete;
 
         // Functions
+        /**
+         * @brief Reads the vertex.glsl/fragment.glsl pair out of the shader directory @p handle.
+         * Touches no GL state, so it's safe to call from any thread.
+         */
+        static ShaderSource read_source(const FileHandle& handle);
+
+        /**
+         * @brief The GL program name. For a Deferred shader this may still be linking, see wait().
+         */
         inline unsigned int get_shader_handle() const { return shaderId; }
+
+        /**
+         * @brief True once a Deferred compile/link has finished on the driver's side, so
+         * wait() won't block. Always true without GL_KHR_parallel_shader_compile, or once the
+         * results have been checked.
+         */
+        bool is_ready() const;
+
+        /**
+         * @brief Blocks until any Deferred compile/link finishes and checks its result.
+         * @return False if the program failed to build (the reason is logged).
+         */
+        bool wait() const;
+
         void bind() const;
         void unbind() const;
         void reload();
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "draft/util/files/file_handle.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Draft {
+    /**
+     * @brief A driver-specific linked program image, as returned by glGetProgramBinary().
+     */
+    struct ShaderBinary {
+        unsigned int format = 0;
+        std::vector<std::byte> data;
+    };
+
+    /**
+     * @brief Persists linked program binaries in a directory, so a Shader whose sources haven't
+     * changed since the last run can skip compiling and linking entirely (glProgramBinary()).
+     *
+     * Entries are keyed by a hash of both shader sources plus the GL vendor/renderer/version
+     * strings, so a driver update naturally misses instead of feeding an incompatible image to
+     * the driver. A stale or corrupt entry is harmless anyway, Shader falls back to compiling
+     * from source whenever glProgramBinary() fails to link.
+     */
+    class ShaderBinaryCache {
+    public:
+        /**
+         * @brief A cache storing one file per program under @p directory.
+         */
+        explicit ShaderBinaryCache(FileHandle directory);
+
+        /**
+         * @brief Builds the cache key for a vertex/fragment source pair on the current driver.
+         * Requires a current OpenGL context, since it mixes in the driver's identity strings.
+         */
+        std::string make_key(std::string_view vertexSrc, std::string_view fragmentSrc) const;
+
+        /**
+         * @brief The binary stored under @p key, or nullopt if there isn't a readable one.
+         */
+        std::optional<ShaderBinary> load(const std::string& key) const;
+
+        /**
+         * @brief Writes @p binary under @p key, replacing any existing entry. Failures are
+         * logged rather than thrown, a cache that can't be written to just never hits.
+         */
+        void store(const std::string& key, const ShaderBinary& binary) const;
+
+        /**
+         * @brief Sets the process-wide cache every Shader consults, or clears it with nullptr
+         * (the default, no caching).
+         */
+        static void set_default(std::shared_ptr<ShaderBinaryCache> cache);
+        static std::shared_ptr<ShaderBinaryCache> get_default();
+
+    private:
+        FileHandle m_directory;
+    };
+}
@@ -21,13 +21,14 @@
 #include "draft/util/serialization/serializer.hpp"
 #include <any>
 #include <stdexcept>
+#include <utility>
 
 namespace Draft {
     namespace Loaders {
         template<>
         void register_default_loader<Animation>(AssetManager& assets){
             // Animation resolves its own spritesheet texture from the JSON's meta.image field,
-            // so (like Model) there's no separable off-thread stage.
+            // so there's no separable off-thread stage.
             assets.register_loader<Animation>(
                 [](const FileHandle& handle, AssetManager& assets){
                     return Animation(handle, assets);
@@ -89,11 +90,14 @@ namespace Draft {
 
         template<>
         void register_default_loader<Model>(AssetManager& assets){
-            // Model(FileHandle) already does its own GL upload internally (embedded textures,
-            // vertex buffers, ...), so there's no separable off-thread stage
+            // glTF parsing, attribute conversion and image decoding all happen off-thread,
+            // leaving only the texture/vertex buffer upload for the finish stage.
             assets.register_loader<Model>(
-                [](const FileHandle& handle, AssetManager&){
-                    return Model(handle);
+                [](const FileHandle& handle){
+                    return Model::decode(handle);
+                },
+                [](std::any data, AssetManager&){
+                    return Model(std::any_cast<ModelData>(std::move(data)));
                 }
             );
         }
@@ -157,11 +161,17 @@ namespace Draft {
 
         template<>
         void register_default_loader<Shader>(AssetManager& assets){
-            // Shader(FileHandle) already does its own GL upload internally, so (like Model)
-            // there's no separable off-thread stage.
+            // Reading the sources is plain file I/O, so it runs off-thread. The link is checked
+            // here rather than deferred to first bind, so a shader that fails to build throws
+            // with its compile/link log and the load is marked failed (placeholder or error)
+            // instead of handing out program 0.
             assets.register_loader<Shader>(
-                [](const FileHandle& handle, AssetManager&){
-                    return Shader(handle);
+                [](const FileHandle& handle){
+                    return std::make_pair(handle, Shader::read_source(handle));
+                },
+                [](std::any data, AssetManager&){
+                    auto [handle, source] = std::any_cast<std::pair<FileHandle, ShaderSource>>(std::move(data));
+                    return Shader(handle, source);
                 }
             );
         }
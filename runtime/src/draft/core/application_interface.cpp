@@ -52,6 +52,13 @@ namespace Draft {
         }
     }
 
+    float ApplicationInterface::get_interpolation_alpha() const {
+        if(simulationPaused)
+            return 1.f;
+
+        return static_cast<float>(p_accumulator / timeStep.as_seconds());
+    }
+
     void ApplicationInterface::frame_into(RenderTarget& target){
         target.begin();
 
@@ -25,6 +25,8 @@ namespace Draft {
         register_component<SpriteComponent>();
         register_component<ColliderComponent>();
         register_component<ConstrainedComponent>();
+        // Before RigidBodyComponent, so loaded bodies are built straight into their own world
+        register_component<PhysicsWorldComponent>();
         register_component<RigidBodyComponent>();
         register_component<AnimationComponent>();
         register_component<CameraComponent>();
@@ -0,0 +1,110 @@
+#include "draft/ecs/floating_origin_system.hpp"
+#include "draft/components/camera_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/ecs/physics_system.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/rendering/particle_system.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Draft {
+    // Constructors
+    FloatingOriginSystem::FloatingOriginSystem(Scene& sceneRef) : m_sceneRef(sceneRef) {}
+
+    // Private functions
+    bool FloatingOriginSystem::get_target_position(Vector2f& position){
+        if(m_target.is_valid()){
+            // A child's own transform is relative to its parent
+            auto* worldTransform = m_target.try_get_component<WorldTransformComponent>();
+            if(worldTransform && m_target.has_component<ChildComponent>()){
+                position = worldTransform->position;
+                return true;
+            }
+
+            if(auto* transform = m_target.try_get_component<TransformComponent>()){
+                position = transform->position;
+                return true;
+            }
+
+            return false;
+        }
+
+        if(Camera* camera = m_sceneRef.get_active_camera()){
+            position = Vector2f(camera->get_position());
+            return true;
+        }
+
+        return false;
+    }
+
+    // Functions
+    void FloatingOriginSystem::update(Time){
+        Vector2f position;
+        if(!get_target_position(position) || Math::length(position) <= threshold)
+            return;
+
+        // Whole units, so anything laid out on a grid stays on it
+        rebase(Math::round(position));
+    }
+
+    void FloatingOriginSystem::add_particles(ParticleSystem& particles){
+        m_particles.push_back(&particles);
+    }
+
+    void FloatingOriginSystem::remove_particles(ParticleSystem& particles){
+        m_particles.erase(std::remove(m_particles.begin(), m_particles.end(), &particles), m_particles.end());
+    }
+
+    void FloatingOriginSystem::add_shift_callback(OriginShiftCallback callback){
+        m_callbacks.push_back(std::move(callback));
+    }
+
+    void FloatingOriginSystem::rebase(const Vector2f& shift){
+        if(shift == Vector2f(0.f))
+            return;
+
+        Registry& registry = m_sceneRef.get_registry();
+
+        // Physics first, it waits out a step in flight before anything else moves
+        if(auto* physics = m_sceneRef.get_systems().try_get<PhysicsSystem>())
+            physics->rebase_origin(shift);
+
+        // Written directly rather than patched, WorldTransformSystem notices on its next pass
+        for(auto [entity, transform] : registry.view<TransformComponent>().each()){
+            bool hasTransformedAncestor = false;
+
+            for(auto* child = registry.try_get<ChildComponent>(entity); child && child->parent.is_valid(); child = registry.try_get<ChildComponent>(child->parent)){
+                if(registry.all_of<TransformComponent>(child->parent)){
+                    hasTransformedAncestor = true;
+                    break;
+                }
+            }
+
+            if(!hasTransformedAncestor)
+                transform.position -= shift;
+        }
+
+        // Cameras on a transform follow it the next time they're resolved
+        for(auto [entity, cam] : registry.view<CameraComponent>(entt::exclude<TransformComponent>).each()){
+            const Vector3f cameraPosition = cam.camera.get_position();
+            cam.camera.set_position({Vector2f(cameraPosition) - shift, cameraPosition.z});
+        }
+
+        if(m_sceneRef.has_active_camera_override()){
+            Camera* camera = m_sceneRef.get_active_camera();
+            const Vector3f cameraPosition = camera->get_position();
+            camera->set_position({Vector2f(cameraPosition) - shift, cameraPosition.z});
+        }
+
+        for(ParticleSystem* particles : m_particles)
+            particles->translate(-shift);
+
+        m_origin += Vector2d(shift);
+
+        for(auto& callback : m_callbacks)
+            callback(shift);
+    }
+}
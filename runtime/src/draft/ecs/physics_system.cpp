@@ -1,10 +1,18 @@
 #include "draft/ecs/physics_system.hpp"
 #include "draft/components/collider_component.hpp"
 #include "draft/components/transform_component.hpp"
+#include "draft/ecs/relationship_system.hpp"
 #include "draft/util/logger.hpp"
+#include "draft/util/thread_pool.hpp"
 #include "glm/common.hpp"
 
 #include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // Field syncing
@@ -22,6 +30,54 @@
     deltaValue = realValue;
 
 namespace Draft {
+    // Steps the worlds on their own thread, one launch() at a time
+    struct PhysicsSystem::StepThread {
+        PhysicsSystem& system;
+        std::mutex mutex;
+        std::condition_variable_any cv;
+        Time dt;
+        bool pending = false;
+        std::exception_ptr error;
+
+        // Declared last so it's stopped and joined first
+        std::jthread thread;
+
+        StepThread(PhysicsSystem& system) : system(system), thread([this](std::stop_token token){ run(token); }) {}
+
+        void run(std::stop_token token){
+            std::unique_lock lock(mutex);
+
+            while(cv.wait(lock, token, [this]{ return pending; })){
+                lock.unlock();
+
+                try {
+                    system.step_worlds(dt);
+                } catch(...){
+                    error = std::current_exception();
+                }
+
+                lock.lock();
+                pending = false;
+                cv.notify_all();
+            }
+        }
+
+        void launch(Time stepDt){
+            std::lock_guard lock(mutex);
+            dt = stepDt;
+            pending = true;
+            cv.notify_all();
+        }
+
+        void wait(){
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [this]{ return !pending; });
+
+            if(error)
+                std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    };
+
     // Helper functions
     template<typename ComponentType>
     void add_for_component(Entity entity){
@@ -61,11 +117,74 @@ namespace Draft {
     }
 
     // Private functions
+    World& PhysicsSystem::world_for(entt::entity entity) const {
+        auto* component = m_registryRef.try_get<PhysicsWorldComponent>(entity);
+
+        // A world that isn't added yet (e.g. a loaded scene's) falls back to world 0, add_world()
+        // moves its bodies over once it is
+        if(!component || component->world >= m_worlds.size())
+            return m_worldRef;
+
+        return *m_worlds[component->world];
+    }
+
+    void PhysicsSystem::step_worlds(Time dt){
+        // Worlds share nothing but box2d's global GJK/TOI statistics counters, which nothing
+        // reads, so they can step side by side
+        if(m_pool && m_worlds.size() > 1){
+            m_pool->parallel_for(m_worlds.size(), [&](size_t i){ m_worlds[i]->step(dt, World::VELOCITY_ITER, World::POSITION_ITER); });
+            return;
+        }
+
+        for(World* world : m_worlds)
+            world->step(dt, World::VELOCITY_ITER, World::POSITION_ITER);
+    }
+
+    void PhysicsSystem::move_body(entt::entity entity){
+        auto* nativeHandle = m_registryRef.try_get<NativeBodyComponent>(entity);
+
+        if(!nativeHandle || !nativeHandle->is_valid() || nativeHandle->bodyPtr->get_world() == &world_for(entity))
+            return;
+
+        // Rebuilt from its components in the new world, tearing it down writes its pose back first.
+        // Its joints are only unhooked, the rebuild hooks them up again to bodies sharing its world
+        if(auto* constrained = m_registryRef.try_get<ConstrainedComponent>(entity)){
+            std::vector<Entity> constraints = constrained->constraints;
+
+            for(Entity jointEntity : constraints)
+                remove_for_each_component<DRAFT_ALL_JOINT_TYPES>(jointEntity);
+        }
+
+        m_movingBody = true;
+        m_registryRef.remove<NativeBodyComponent>(entity);
+        m_movingBody = false;
+
+        m_registryRef.emplace<NativeBodyComponent>(entity);
+    }
+
+    void PhysicsSystem::update_world(Registry& reg, entt::entity rawEnt){
+        finish_step();
+        move_body(rawEnt);
+    }
+
+    void PhysicsSystem::deconstruct_world(Registry& reg, entt::entity rawEnt){
+        // Still attached while this runs, so point it at world 0 for the rebuild
+        finish_step();
+        reg.get<PhysicsWorldComponent>(rawEnt).world = 0;
+        move_body(rawEnt);
+    }
+
     void PhysicsSystem::update_transform(Registry& reg, entt::entity rawEnt){
+        finish_step();
         TransformComponent& transform = reg.get<TransformComponent>(rawEnt);
         transform.force_sync(Entity(&m_sceneRef, rawEnt));
     }
 
+    void PhysicsSystem::update_body(Registry& reg, entt::entity rawEnt){
+        // Picked up by the next handle_bodies(), even if the body is asleep by then
+        m_modifiedBodies.push_back(rawEnt);
+    }
+
     void PhysicsSystem::construct_body_func(Registry& reg, entt::entity rawEnt){
         // A RigidBodyComponent was attached to something
         // Get component and construct it in the world
@@ -88,6 +207,12 @@ namespace Draft {
         }
 
         // Get component and construct it in the world
+        finish_step();
+        World* world = &world_for(rawEnt);
+
+        if(auto* worldComponent = reg.try_get<PhysicsWorldComponent>(rawEnt); worldComponent && worldComponent->world >= m_worlds.size())
+            Logger::println(LogLevel::Warning, "Physics", "PhysicsWorldComponent names world " + std::to_string(worldComponent->world) + ", which hasn't been added. Using world 0 until it is.");
+
         NativeBodyComponent& nativeComponent = reg.get<NativeBodyComponent>(rawEnt);
         RigidBodyComponent& bodyComponent = reg.get<RigidBodyComponent>(rawEnt);
         BodyDef definition;
@@ -115,15 +240,27 @@ namespace Draft {
         definition.enabled = bodyComponent.enabled;
         definition.gravityScale = bodyComponent.gravityScale;
 
-        RigidBody* body = m_worldRef.create_rigid_body(definition);
+        RigidBody* body = world->create_rigid_body(definition);
         assert(body && "Something went wrong with body");
 
         // Add a handle to the entity so it can be referenced later
         nativeComponent.deltaP = definition.position;
         nativeComponent.deltaR = definition.angle;
+        nativeComponent.previousPosition = definition.position;
+        nativeComponent.previousRotation = definition.angle;
+        nativeComponent.deltaType = definition.type;
         nativeComponent.deltaLinearVelocity = definition.linearVelocity;
         nativeComponent.deltaAngularVelocity = definition.angularVelocity;
+        nativeComponent.deltaLinearDamping = definition.linearDamping;
+        nativeComponent.deltaAngularDamping = definition.angularDamping;
+        nativeComponent.deltaAllowSleep = definition.allowSleep;
+        nativeComponent.deltaAwake = definition.awake;
+        nativeComponent.deltaEnabled = definition.enabled;
+        nativeComponent.deltaBullet = definition.bullet;
+        nativeComponent.deltaFixedRotation = definition.fixedRotation;
+        nativeComponent.deltaGravityScale = definition.gravityScale;
         nativeComponent.bodyPtr = body;
+        m_bodyEntities[body] = rawEnt;
         bodyComponent.m_nativeHandlePtr = body; // Let the bodycomponent also know about the body, albiet very strictly
 
         // Add colliders to the body if they exist
@@ -151,6 +288,7 @@ namespace Draft {
             return;
 
         // Add the collider component to the rigidbody
+        finish_step();
         RigidBody* handle = reg.get<NativeBodyComponent>(rawEnt);
         Collider& colliderRef = reg.get<ColliderComponent>(rawEnt);
         colliderRef.attach(handle);
@@ -165,10 +303,12 @@ namespace Draft {
 
     void PhysicsSystem::deconstruct_native_body_func(Registry& reg, entt::entity rawEnt){
         // NativeBodyComponent was removed from an entity
+        finish_step();
         RigidBody* body = reg.get<NativeBodyComponent>(rawEnt);
+        m_bodyEntities.erase(body);
 
         // Skip cleanup if the body handle isnt valid
-        if(!body->is_valid())
+        if(!body || !body->is_valid())
             return;
 
         // Check if it has a transform component, if it does save final transform
@@ -204,9 +344,10 @@ namespace Draft {
             bodyComponent.gravityScale = body->get_gravity_scale();
         }
 
-        // Remove joints. Copy the list first since destroying a joint entity cleans up
-        // ConstrainedComponent on both its endpoints, including this entity's own list.
-        if(reg.all_of<ConstrainedComponent>(rawEnt)){
+        // Remove joints, unless move_body() is rebuilding it. Copy the list first since destroying
+        // a joint entity cleans up ConstrainedComponent on both its endpoints, including this
+        // entity's own list.
+        if(!m_movingBody && reg.all_of<ConstrainedComponent>(rawEnt)){
             std::vector<Entity> constraints = reg.get<ConstrainedComponent>(rawEnt).constraints;
 
             for(Entity jointEntity : constraints){
@@ -226,63 +367,123 @@ namespace Draft {
             return;
 
         // Detach collider
+        finish_step();
         Collider& colliderRef = reg.get<ColliderComponent>(rawEnt);
         colliderRef.detach();
     }
 
-    void PhysicsSystem::handle_bodies(){
-        // Iterate over entities and update each component, starting with transforms
-        auto view1 = m_registryRef.view<TransformComponent, NativeBodyComponent>();
+    void PhysicsSystem::handle_contacts(){
+        // Resolve every world's events to entities, reusing last step's storage
+        m_contactEvents.clear();
+
+        for(World* world : m_worlds){
+            for(const ContactEvent& event : world->get_contact_events()){
+                auto iterA = m_bodyEntities.find(event.bodyA);
+                auto iterB = m_bodyEntities.find(event.bodyB);
+
+                // Skip bodies created directly on the world rather than through a component
+                if(iterA == m_bodyEntities.end() || iterB == m_bodyEntities.end())
+                    continue;
+
+                m_contactEvents.push_back({event, Entity(&m_sceneRef, iterA->second), Entity(&m_sceneRef, iterB->second)});
+            }
+        }
+    }
 
-        for(auto entity : view1){
-            TransformComponent& transform = view1.get<TransformComponent>(entity);
-            NativeBodyComponent& nativeHandle = view1.get<NativeBodyComponent>(entity);
-            RigidBody& body = nativeHandle;
+    void PhysicsSystem::sync_body(entt::entity entity, NativeBodyComponent& handle){
+        RigidBody& body = handle;
 
+        if(TransformComponent* transform = m_registryRef.try_get<TransformComponent>(entity)){
             // Move based on dp and dr
-            nativeHandle.deltaP = transform.position - nativeHandle.deltaP;
-            nativeHandle.deltaR = transform.rotation - nativeHandle.deltaR;
+            handle.deltaP = transform->position - handle.deltaP;
+            handle.deltaR = transform->rotation - handle.deltaR;
 
             // If dp or dr is non-zero then update the body's position
-            if(Math::abs(nativeHandle.deltaP.x) > 0.f || Math::abs(nativeHandle.deltaP.y) > 0.f || nativeHandle.deltaR != 0.f)
-                body.set_transform(body.get_position() + nativeHandle.deltaP, body.get_angle() + nativeHandle.deltaR);
+            bool teleported = Math::abs(handle.deltaP.x) > 0.f || Math::abs(handle.deltaP.y) > 0.f || handle.deltaR != 0.f;
+            if(teleported)
+                body.set_transform(body.get_position() + handle.deltaP, body.get_angle() + handle.deltaR);
+
+            // Interpolate from where it was drawn last, unless it was just moved by hand
+            handle.previousPosition = teleported ? body.get_position() : transform->position;
+            handle.previousRotation = teleported ? body.get_angle() : transform->rotation;
+            m_movedBodies.push_back(entity);
 
             // Save new positions
-            transform.position = body.get_position();
-            transform.rotation = body.get_angle();
+            transform->position = body.get_position();
+            transform->rotation = body.get_angle();
 
             // Reset deltas
-            nativeHandle.deltaP = transform.position;
-            nativeHandle.deltaR = transform.rotation;
+            handle.deltaP = transform->position;
+            handle.deltaR = transform->rotation;
         }
 
-        auto view2 = m_registryRef.view<RigidBodyComponent, NativeBodyComponent>();
+        RigidBodyComponent* bodyComponentPtr = m_registryRef.try_get<RigidBodyComponent>(entity);
+        if(!bodyComponentPtr)
+            return;
 
-        for(auto entity : view2){
-            RigidBodyComponent& bodyComponent = view2.get<RigidBodyComponent>(entity);
-            NativeBodyComponent& handle = view2.get<NativeBodyComponent>(entity);
+        RigidBodyComponent& bodyComponent = *bodyComponentPtr;
 
-            DRAFT_SET_IF_CHANGE(bodyComponent.type, handle.deltaType, handle->set_type(bodyComponent.type), handle->get_type());
-            DRAFT_SYNC_ADDITIVE(bodyComponent.linearVelocity, handle.deltaLinearVelocity, handle->set_linear_velocity(handle->get_linear_velocity() + handle.deltaLinearVelocity), handle->get_linear_velocity());
-            DRAFT_SYNC_ADDITIVE(bodyComponent.angularVelocity, handle.deltaAngularVelocity, handle->set_angular_velocity(handle->get_angular_velocity() + handle.deltaAngularVelocity), handle->get_angular_velocity());
-            DRAFT_SYNC_ADDITIVE(bodyComponent.linearDamping, handle.deltaLinearDamping, handle->set_linear_damping(handle->get_linear_damping() + handle.deltaLinearDamping), handle->get_linear_damping());
-            DRAFT_SYNC_ADDITIVE(bodyComponent.angularDamping, handle.deltaAngularDamping, handle->set_angular_damping(handle->get_angular_damping() + handle.deltaAngularDamping), handle->get_angular_damping());
+        DRAFT_SET_IF_CHANGE(bodyComponent.type, handle.deltaType, handle->set_type(bodyComponent.type), handle->get_type());
+        DRAFT_SYNC_ADDITIVE(bodyComponent.linearVelocity, handle.deltaLinearVelocity, handle->set_linear_velocity(handle->get_linear_velocity() + handle.deltaLinearVelocity), handle->get_linear_velocity());
+        DRAFT_SYNC_ADDITIVE(bodyComponent.angularVelocity, handle.deltaAngularVelocity, handle->set_angular_velocity(handle->get_angular_velocity() + handle.deltaAngularVelocity), handle->get_angular_velocity());
+        DRAFT_SYNC_ADDITIVE(bodyComponent.linearDamping, handle.deltaLinearDamping, handle->set_linear_damping(handle->get_linear_damping() + handle.deltaLinearDamping), handle->get_linear_damping());
+        DRAFT_SYNC_ADDITIVE(bodyComponent.angularDamping, handle.deltaAngularDamping, handle->set_angular_damping(handle->get_angular_damping() + handle.deltaAngularDamping), handle->get_angular_damping());
 
-            if(handle.deltaAwake != bodyComponent.awake){
-                if(bodyComponent.awake){
-                    handle->set_awake();
-                } else {
-                    handle->set_sleep();
-                }
+        if(handle.deltaAwake != bodyComponent.awake){
+            if(bodyComponent.awake){
+                handle->set_awake();
+            } else {
+                handle->set_sleep();
             }
-            bodyComponent.awake = handle->is_awake();
-            handle.deltaAwake = bodyComponent.awake;
-
-            DRAFT_SET_IF_CHANGE(bodyComponent.allowSleep, handle.deltaAllowSleep, handle->set_sleep_allowed(bodyComponent.allowSleep), handle->is_sleep_allowed());
-            DRAFT_SET_IF_CHANGE(bodyComponent.fixedRotation, handle.deltaFixedRotation, handle->set_fixed_rotation(bodyComponent.fixedRotation), handle->is_fixed_rotation());
-            DRAFT_SET_IF_CHANGE(bodyComponent.bullet, handle.deltaBullet, handle->set_bullet(bodyComponent.bullet), handle->is_bullet());
-            DRAFT_SET_IF_CHANGE(bodyComponent.enabled, handle.deltaEnabled, handle->set_enabled(bodyComponent.enabled), handle->is_enabled());
-            DRAFT_SYNC_ADDITIVE(bodyComponent.gravityScale, handle.deltaGravityScale, handle->set_gravity_scale(handle->get_gravity_scale() + handle.deltaGravityScale), handle->get_gravity_scale());
+        }
+        bodyComponent.awake = handle->is_awake();
+        handle.deltaAwake = bodyComponent.awake;
+
+        DRAFT_SET_IF_CHANGE(bodyComponent.allowSleep, handle.deltaAllowSleep, handle->set_sleep_allowed(bodyComponent.allowSleep), handle->is_sleep_allowed());
+        DRAFT_SET_IF_CHANGE(bodyComponent.fixedRotation, handle.deltaFixedRotation, handle->set_fixed_rotation(bodyComponent.fixedRotation), handle->is_fixed_rotation());
+        DRAFT_SET_IF_CHANGE(bodyComponent.bullet, handle.deltaBullet, handle->set_bullet(bodyComponent.bullet), handle->is_bullet());
+        DRAFT_SET_IF_CHANGE(bodyComponent.enabled, handle.deltaEnabled, handle->set_enabled(bodyComponent.enabled), handle->is_enabled());
+        DRAFT_SYNC_ADDITIVE(bodyComponent.gravityScale, handle.deltaGravityScale, handle->set_gravity_scale(handle->get_gravity_scale() + handle.deltaGravityScale), handle->get_gravity_scale());
+    }
+
+    void PhysicsSystem::handle_bodies(){
+        // Bodies that moved last update stop interpolating, unless synced again below
+        for(entt::entity entity : m_movedBodies){
+            if(!m_registryRef.valid(entity))
+                continue;
+
+            auto* nativeHandle = m_registryRef.try_get<NativeBodyComponent>(entity);
+            auto* transform = m_registryRef.try_get<TransformComponent>(entity);
+
+            if(nativeHandle && transform){
+                nativeHandle->previousPosition = transform->position;
+                nativeHandle->previousRotation = transform->rotation;
+            }
+        }
+
+        m_movedBodies.clear();
+
+        // Patched components of bodies the loop below skips, whether or not they're asleep
+        for(entt::entity entity : m_modifiedBodies){
+            if(!m_registryRef.valid(entity))
+                continue;
+
+            NativeBodyComponent* nativeHandle = m_registryRef.try_get<NativeBodyComponent>(entity);
+            if(nativeHandle && !nativeHandle->deltaAwake && !(*nativeHandle)->is_awake())
+                sync_body(entity, *nativeHandle);
+        }
+
+        m_modifiedBodies.clear();
+
+        // Then everything box2d may have moved. Static and sleeping bodies can't have, except
+        // for the step a body falls asleep in (deltaAwake still says it was awake), which is
+        // synced once more so the components see it settle. Box2d keeps no list of awake
+        // bodies, so this is a flag check per body, the sync itself only runs for awake ones.
+        auto view = m_registryRef.view<NativeBodyComponent>();
+
+        for(auto [entity, nativeHandle] : view.each()){
+            if(nativeHandle.deltaAwake || nativeHandle->is_awake())
+                sync_body(entity, nativeHandle);
         }
     }
 
@@ -318,6 +519,27 @@ namespace Draft {
             body->apply_angular_impulse(c.angular, c.wake);
         });
 
+        // Accumulators stay attached, only the non-empty ones touch their body
+        for(auto [entity, accumulator, nativeHandle] : m_registryRef.view<ForceAccumulatorComponent, NativeBodyComponent>().each()){
+            if(accumulator.is_empty())
+                continue;
+
+            RigidBody* body = nativeHandle;
+            bool wake = accumulator.wake;
+
+            // Off-center requests: sum of (p - c) x f = sum of p x f - c x sum of f
+            Vector2f center = body->get_world_center();
+            float forceTorque = accumulator.forceMoment - (center.x * accumulator.momentForce.y - center.y * accumulator.momentForce.x);
+            float impulseTorque = accumulator.impulseMoment - (center.x * accumulator.momentImpulse.y - center.y * accumulator.momentImpulse.x);
+
+            body->apply_force(accumulator.force + accumulator.momentForce, wake);
+            body->apply_torque(accumulator.torque + forceTorque, wake);
+            body->apply_linear_impulse(accumulator.impulse + accumulator.momentImpulse, wake);
+            body->apply_angular_impulse(accumulator.angularImpulse + impulseTorque, wake);
+
+            accumulator.clear();
+        }
+
         apply_continuous<ContinuousTorqueComponent>(m_registryRef, [](RigidBody* body, ContinuousTorqueComponent& c){ body->apply_torque(c.torque, c.wake); });
         apply_continuous<ContinuousForceComponent>(m_registryRef, [](RigidBody* body, ContinuousForceComponent& c){ body->apply_force(c.force, c.point, c.wake); });
         apply_continuous<ContinuousImpulseComponent>(m_registryRef, [](RigidBody* body, ContinuousImpulseComponent& c){
@@ -329,9 +551,8 @@ namespace Draft {
     static bool sync_joint(DistanceJointComponent& jointData, DistanceJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<DistanceJoint>();
 
-        if(handle.delta.anchorA != jointData.anchorA || handle.delta.anchorB != jointData.anchorB)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.anchorA, handle.delta.anchorA, ptr->set_local_anchors(jointData.anchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.anchorB, handle.delta.anchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.anchorB), ptr->get_local_anchor_b());
         DRAFT_SET_IF_CHANGE(jointData.length, handle.delta.length, ptr->set_length(jointData.length), ptr->get_length());
         DRAFT_SET_IF_CHANGE(jointData.minLength, handle.delta.minLength, ptr->set_min_length(jointData.minLength), ptr->get_min_length());
         DRAFT_SET_IF_CHANGE(jointData.maxLength, handle.delta.maxLength, ptr->set_max_length(jointData.maxLength), ptr->get_max_length());
@@ -343,9 +564,8 @@ namespace Draft {
     static bool sync_joint(FrictionJointComponent& jointData, FrictionJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<FrictionJoint>();
 
-        if(handle.delta.anchorA != jointData.anchorA || handle.delta.anchorB != jointData.anchorB)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.anchorA, handle.delta.anchorA, ptr->set_local_anchors(jointData.anchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.anchorB, handle.delta.anchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.anchorB), ptr->get_local_anchor_b());
         DRAFT_SET_IF_CHANGE(jointData.maxForce, handle.delta.maxForce, ptr->set_max_force(jointData.maxForce), ptr->get_max_force());
         DRAFT_SET_IF_CHANGE(jointData.maxTorque, handle.delta.maxTorque, ptr->set_max_torque(jointData.maxTorque), ptr->get_max_torque());
         return false;
@@ -381,10 +601,10 @@ namespace Draft {
     static bool sync_joint(PrismaticJointComponent& jointData, PrismaticJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<PrismaticJoint>();
 
-        if(handle.delta.anchorA != jointData.anchorA || handle.delta.anchorB != jointData.anchorB ||
-            handle.delta.localAxisA != jointData.localAxisA || handle.delta.referenceAngle != jointData.referenceAngle)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.anchorA, handle.delta.anchorA, ptr->set_local_anchors(jointData.anchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.anchorB, handle.delta.anchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.anchorB), ptr->get_local_anchor_b());
+        DRAFT_SET_IF_CHANGE(jointData.localAxisA, handle.delta.localAxisA, ptr->set_local_axis(jointData.localAxisA), ptr->get_local_axis());
+        DRAFT_SET_IF_CHANGE(jointData.referenceAngle, handle.delta.referenceAngle, ptr->set_reference_angle(jointData.referenceAngle), ptr->get_reference_angle());
         DRAFT_SET_IF_CHANGE(jointData.lowerTranslation, handle.delta.lowerTranslation, ptr->set_limits(jointData.lowerTranslation, ptr->get_upper_limit()), ptr->get_lower_limit());
         DRAFT_SET_IF_CHANGE(jointData.upperTranslation, handle.delta.upperTranslation, ptr->set_limits(ptr->get_lower_limit(), jointData.upperTranslation), ptr->get_upper_limit());
         DRAFT_SET_IF_CHANGE(jointData.maxMotorForce, handle.delta.maxMotorForce, ptr->set_max_motor_force(jointData.maxMotorForce), ptr->get_max_motor_force());
@@ -397,6 +617,8 @@ namespace Draft {
     static bool sync_joint(PulleyJointComponent& jointData, PulleyJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<PulleyJoint>();
 
+        // The only joint that still has to be rebuilt: box2d folds the anchors into the rope
+        // length when it's created, and has no way to change it after
         if(handle.delta.groundAnchorA != jointData.groundAnchorA || handle.delta.groundAnchorB != jointData.groundAnchorB ||
             handle.delta.localAnchorA != jointData.localAnchorA || handle.delta.localAnchorB != jointData.localAnchorB)
             return true;
@@ -410,10 +632,9 @@ namespace Draft {
     static bool sync_joint(RevoluteJointComponent& jointData, RevoluteJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<RevoluteJoint>();
 
-        if(handle.delta.localAnchorA != jointData.localAnchorA || handle.delta.localAnchorB != jointData.localAnchorB ||
-            handle.delta.referenceAngle != jointData.referenceAngle)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.localAnchorA, handle.delta.localAnchorA, ptr->set_local_anchors(jointData.localAnchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.localAnchorB, handle.delta.localAnchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.localAnchorB), ptr->get_local_anchor_b());
+        DRAFT_SET_IF_CHANGE(jointData.referenceAngle, handle.delta.referenceAngle, ptr->set_reference_angle(jointData.referenceAngle), ptr->get_reference_angle());
         DRAFT_SET_IF_CHANGE(jointData.lowerAngle, handle.delta.lowerAngle, ptr->set_limits(jointData.lowerAngle, ptr->get_upper_limit()), ptr->get_lower_limit());
         DRAFT_SET_IF_CHANGE(jointData.upperAngle, handle.delta.upperAngle, ptr->set_limits(ptr->get_lower_limit(), jointData.upperAngle), ptr->get_upper_limit());
         DRAFT_SET_IF_CHANGE(jointData.maxMotorTorque, handle.delta.maxMotorTorque, ptr->set_max_motor_torque(jointData.maxMotorTorque), ptr->get_max_motor_torque());
@@ -426,10 +647,9 @@ namespace Draft {
     static bool sync_joint(WeldJointComponent& jointData, WeldJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<WeldJoint>();
 
-        if(handle.delta.anchorA != jointData.anchorA || handle.delta.anchorB != jointData.anchorB ||
-            handle.delta.referenceAngle != jointData.referenceAngle)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.anchorA, handle.delta.anchorA, ptr->set_local_anchors(jointData.anchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.anchorB, handle.delta.anchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.anchorB), ptr->get_local_anchor_b());
+        DRAFT_SET_IF_CHANGE(jointData.referenceAngle, handle.delta.referenceAngle, ptr->set_reference_angle(jointData.referenceAngle), ptr->get_reference_angle());
         DRAFT_SET_IF_CHANGE(jointData.stiffness, handle.delta.stiffness, ptr->set_stiffness(jointData.stiffness), ptr->get_stiffness());
         DRAFT_SET_IF_CHANGE(jointData.damping, handle.delta.damping, ptr->set_damping(jointData.damping), ptr->get_damping());
         return false;
@@ -438,10 +658,9 @@ namespace Draft {
     static bool sync_joint(WheelJointComponent& jointData, WheelJointComponent::NativeType& handle){
         auto* ptr = handle.get_as<WheelJoint>();
 
-        if(handle.delta.anchorA != jointData.anchorA || handle.delta.anchorB != jointData.anchorB ||
-            handle.delta.localAxis != jointData.localAxis)
-            return true;
-
+        DRAFT_SET_IF_CHANGE(jointData.anchorA, handle.delta.anchorA, ptr->set_local_anchors(jointData.anchorA, ptr->get_local_anchor_b()), ptr->get_local_anchor_a());
+        DRAFT_SET_IF_CHANGE(jointData.anchorB, handle.delta.anchorB, ptr->set_local_anchors(ptr->get_local_anchor_a(), jointData.anchorB), ptr->get_local_anchor_b());
+        DRAFT_SET_IF_CHANGE(jointData.localAxis, handle.delta.localAxis, ptr->set_local_axis(jointData.localAxis), ptr->get_local_axis());
         DRAFT_SET_IF_CHANGE(jointData.lowerTranslation, handle.delta.lowerTranslation, ptr->set_limits(jointData.lowerTranslation, ptr->get_upper_limit()), ptr->get_lower_limit());
         DRAFT_SET_IF_CHANGE(jointData.upperTranslation, handle.delta.upperTranslation, ptr->set_limits(ptr->get_lower_limit(), jointData.upperTranslation), ptr->get_upper_limit());
         DRAFT_SET_IF_CHANGE(jointData.maxMotorTorque, handle.delta.maxMotorTorque, ptr->set_max_motor_torque(jointData.maxMotorTorque), ptr->get_max_motor_torque());
@@ -471,6 +690,11 @@ namespace Draft {
         }
     }
 
+    template<typename... Ts>
+    static void write_joint_types(SystemAccess& access){
+        (access.write<Ts, typename Ts::NativeType>(), ...);
+    }
+
     void PhysicsSystem::handle_joints(){
         // Loops through every kind of joint and runs logic to keep the native and data components syncronized
         sync_joint_types<DRAFT_ALL_JOINT_TYPES>();
@@ -478,8 +702,14 @@ namespace Draft {
 
     // Constructors
     PhysicsSystem::PhysicsSystem(Scene& sceneRef, World& worldRef) : m_registryRef(sceneRef.get_registry()), m_sceneRef(sceneRef), m_worldRef(worldRef) {
+        m_worlds.push_back(&m_worldRef);
+
         // Attach listeners
         m_registryRef.on_update<TransformComponent>().connect<&PhysicsSystem::update_transform>(this);
+        m_registryRef.on_update<RigidBodyComponent>().connect<&PhysicsSystem::update_body>(this);
+        m_registryRef.on_construct<PhysicsWorldComponent>().connect<&PhysicsSystem::update_world>(this);
+        m_registryRef.on_update<PhysicsWorldComponent>().connect<&PhysicsSystem::update_world>(this);
+        m_registryRef.on_destroy<PhysicsWorldComponent>().connect<&PhysicsSystem::deconstruct_world>(this);
 
         m_registryRef.on_construct<RigidBodyComponent>().connect<&PhysicsSystem::construct_body_func>(this);
         m_registryRef.on_construct<NativeBodyComponent>().connect<&PhysicsSystem::construct_native_body_func>(this);
@@ -490,11 +720,34 @@ namespace Draft {
         m_registryRef.on_destroy<ColliderComponent>().connect<&PhysicsSystem::deconstruct_collider_func>(this);
 
         attach_listeners_for_all<DRAFT_ALL_JOINT_TYPES>(m_registryRef, this);
+
+        // Storage update() would otherwise create on first use, which get_access() can't cover
+        m_registryRef.storage<ConstrainedComponent>();
+        m_registryRef.storage<ForceAccumulatorComponent>();
+        m_registryRef.storage<TorqueComponent>();
+        m_registryRef.storage<ForceComponent>();
+        m_registryRef.storage<ImpulseComponent>();
+        m_registryRef.storage<ContinuousTorqueComponent>();
+        m_registryRef.storage<ContinuousForceComponent>();
+        m_registryRef.storage<ContinuousImpulseComponent>();
     }
 
     PhysicsSystem::~PhysicsSystem(){
+        // Nothing may be stepping once the world is left alone
+        if(m_stepThread){
+            try {
+                m_stepThread->wait();
+            } catch(const std::exception& e){
+                Logger::println(LogLevel::Severe, "Physics", e.what());
+            }
+        }
+
         // Remove listeners
         m_registryRef.on_update<TransformComponent>().disconnect<&PhysicsSystem::update_transform>(this);
+        m_registryRef.on_update<RigidBodyComponent>().disconnect<&PhysicsSystem::update_body>(this);
+        m_registryRef.on_construct<PhysicsWorldComponent>().disconnect<&PhysicsSystem::update_world>(this);
+        m_registryRef.on_update<PhysicsWorldComponent>().disconnect<&PhysicsSystem::update_world>(this);
+        m_registryRef.on_destroy<PhysicsWorldComponent>().disconnect<&PhysicsSystem::deconstruct_world>(this);
 
         m_registryRef.on_construct<RigidBodyComponent>().disconnect<&PhysicsSystem::construct_body_func>(this);
         m_registryRef.on_construct<NativeBodyComponent>().disconnect<&PhysicsSystem::construct_native_body_func>(this);
@@ -509,11 +762,86 @@ namespace Draft {
 
     // Functions
     void PhysicsSystem::update(Time dt){
-        m_worldRef.step(dt, World::VELOCITY_ITER, World::POSITION_ITER);
+        // Threaded, the step whose results are synced here was started by the last update()
+        if(m_stepThread)
+            finish_step();
+        else
+            step_worlds(dt);
+
+        handle_contacts();
 
         // Views
         handle_joints();
         handle_forces();
         handle_bodies();
+
+        if(m_stepThread)
+            m_stepThread->launch(dt);
+    }
+
+    std::optional<SystemAccess> PhysicsSystem::get_access() const {
+        SystemAccess access;
+        access.write<TransformComponent, RigidBodyComponent, NativeBodyComponent, ConstrainedComponent>();
+        access.write<ForceAccumulatorComponent, TorqueComponent, ForceComponent, ImpulseComponent>();
+        access.write<ContinuousTorqueComponent, ContinuousForceComponent, ContinuousImpulseComponent>();
+        access.write<World, PhysicsSystem>();
+        write_joint_types<DRAFT_ALL_JOINT_TYPES>(access);
+
+        // The body and joint hooks update() can set off attach colliders and look up worlds
+        access.write<ColliderComponent>();
+        access.read<PhysicsWorldComponent>();
+
+        // Scene's own listeners, for whatever those hooks add or remove
+        access.include(RelationshipSystem::get_listener_access());
+        return access;
+    }
+
+    void PhysicsSystem::on_detach(){
+        // An inactive scene's world shouldn't be busy behind anyone's back
+        finish_step();
+    }
+
+    void PhysicsSystem::set_threaded(bool threaded){
+        if(threaded == is_threaded())
+            return;
+
+        if(threaded){
+            m_stepThread = std::make_unique<StepThread>(*this);
+        } else {
+            finish_step();
+            m_stepThread.reset();
+        }
+    }
+
+    uint32_t PhysicsSystem::add_world(World& world){
+        finish_step();
+        m_worlds.push_back(&world);
+        uint32_t index = static_cast<uint32_t>(m_worlds.size() - 1);
+
+        // Bodies built before their world was added
+        for(auto [entity, worldComponent] : m_registryRef.view<PhysicsWorldComponent>().each()){
+            if(worldComponent.world == index)
+                move_body(entity);
+        }
+
+        return index;
+    }
+
+    void PhysicsSystem::rebase_origin(const Vector2f& shift){
+        finish_step();
+
+        for(World* world : m_worlds)
+            world->rebase_origin(shift);
+
+        // Keeps sync_body() from seeing the shifted transforms as moved by hand
+        for(auto [entity, nativeHandle] : m_registryRef.view<NativeBodyComponent>().each()){
+            nativeHandle.deltaP -= shift;
+            nativeHandle.previousPosition -= shift;
+        }
+    }
+
+    void PhysicsSystem::finish_step(){
+        if(m_stepThread)
+            m_stepThread->wait();
     }
 };
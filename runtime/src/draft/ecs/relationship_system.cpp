@@ -2,6 +2,7 @@
 #include "draft/ecs/relationship_components.hpp"
 #include "draft/ecs/entity.hpp"
 #include "draft/ecs/scene.hpp"
+#include "draft/ecs/world_transform_system.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -27,13 +28,17 @@ namespace Draft {
             childrenCompPtr = &parent.get_component<ParentComponent>();
         }
 
-        // Add to array, unless it's already there.
+        // Add to array, unless it's already there (a ParentComponent backfilling its children
+        // sets the index up front).
         if(childrenCompPtr){
             Entity self(&m_sceneRef, rawEnt);
             auto& vec = childrenCompPtr->children;
 
-            if(std::find(vec.begin(), vec.end(), self) == vec.end())
-                vec.push_back(self);
+            if(component.indexInParent < vec.size() && vec[component.indexInParent] == self)
+                return;
+
+            component.indexInParent = vec.size();
+            vec.push_back(self);
         }
     }
 
@@ -43,13 +48,17 @@ namespace Draft {
         Entity parent(&m_sceneRef, rawEnt);
         auto& vec = component.children;
 
-        // Remove entities which are parented to this
-        for(auto& entity : vec){
+        // Link up entities which are parented to this
+        for(std::size_t i = 0; i < vec.size(); i++){
+            Entity& entity = vec[i];
+
             if(entity.has_component<ChildComponent>()){
                 // Check to see if this owner is correct
-                assert(entity.get_component<ChildComponent>().parent == parent && "Entity cannot be parented to two entities");
+                ChildComponent& child = entity.get_component<ChildComponent>();
+                assert(child.parent == parent && "Entity cannot be parented to two entities");
+                child.indexInParent = i;
             } else {
-                entity.add_component<ChildComponent>(ChildComponent{parent});
+                entity.add_component<ChildComponent>(ChildComponent{parent, i});
             }
         }
     }
@@ -78,10 +87,25 @@ namespace Draft {
         // Remove from array
         if(childrenCompPtr){
             auto& vec = childrenCompPtr->children;
-            auto iter = std::find(vec.begin(), vec.end(), Entity(&m_sceneRef, rawEnt));
+            Entity self(&m_sceneRef, rawEnt);
+            std::size_t index = component.indexInParent;
 
-            if(iter != vec.end()){
-                vec.erase(iter);
+            if(index >= vec.size() || vec[index] != self){
+                // Stale hint, children was rewritten behind our back, fall back to searching
+                index = std::find(vec.begin(), vec.end(), self) - vec.begin();
+            }
+
+            if(index < vec.size()){
+                // Swap-remove, so detaching is O(1) wherever the child sits. Only the last
+                // child moves, into the freed slot
+                if(index != vec.size() - 1){
+                    vec[index] = std::move(vec.back());
+
+                    if(auto* moved = reg.try_get<ChildComponent>(vec[index]))
+                        moved->indexInParent = index;
+                }
+
+                vec.pop_back();
             }
 
             if(vec.empty()){
@@ -129,4 +153,12 @@ namespace Draft {
         m_registryRef.on_destroy<ChildComponent>().disconnect<&RelationshipSystem::deconstruct_child_func>(this);
         m_registryRef.on_destroy<ParentComponent>().disconnect<&RelationshipSystem::deconstruct_parent_func>(this);
     }
+
+    // Functions
+    SystemAccess RelationshipSystem::get_listener_access(){
+        // Adding a child can add its parent's ParentComponent, removing the last one removes it
+        return SystemAccess()
+            .write<ChildComponent, ParentComponent, RelationshipSystem>()
+            .include(WorldTransformSystem::get_listener_access());
+    }
 }
@@ -1,9 +1,12 @@
 #include "draft/ecs/render_system.hpp"
 #include "draft/components/animation_component.hpp"
+#include "draft/components/rigid_body_component.hpp"
 #include "draft/components/sprite_component.hpp"
 #include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
 #include "draft/core/application_interface.hpp"
 #include "draft/rendering/pipeline/renderer.hpp"
+#include "draft/util/string_id.hpp"
 
 namespace Draft {
     // Constructors
@@ -16,29 +19,55 @@ namespace Draft {
         if(!renderer)
             return;
 
+        float alpha = appRef.get_interpolation_alpha();
+
         for(const auto& [entity, spriteComponent, transformComponent] : registryRef.view<SpriteComponent, TransformComponent>().each()){
             TextureRegion region = spriteComponent.texture;
 
             if(auto* animComp = registryRef.try_get<AnimationComponent>(entity)){
-                // Animation component exists, it should take precedence over the sprite
-                if(animComp->animation && !animComp->animation->get_frames().empty() && (animComp->animation->has_tag(animComp->tag) || animComp->tag.empty())){
+                // Animation component exists, it should take precedence over the sprite. The tag
+                // is hashed once here rather than by each lookup below
+                StringId tag(animComp->tag);
+
+                if(animComp->animation && !animComp->animation->get_frames().empty() && (animComp->tag.empty() || animComp->animation->has_tag(tag))){
                     if(animComp->tag.empty()){
                         region = animComp->animation->get_frame(animComp->frameTime);
                     } else {
-                        region = animComp->animation->get_frame(animComp->tag, animComp->frameTime);
+                        region = animComp->animation->get_frame(tag, animComp->frameTime);
                     }
 
                     animComp->frameTime += dt.as_milliseconds();
                 }
             }
 
+            // Parented sprites draw at their composed world pose, Scene::render() refreshed it
+            // just before this Geometry pass
+            Vector2f position = transformComponent.position;
+            float rotation = transformComponent.rotation;
+            float parentRotation = 0.f;
+
+            if(auto* world = registryRef.try_get<WorldTransformComponent>(entity)){
+                position = world->position;
+                rotation = world->rotation;
+                parentRotation = world->rotation - transformComponent.rotation;
+            }
+
+            // Physics bodies only move once per fixed step, so they're drawn part way back
+            // towards where the step before left them. The previous pose is local like the
+            // transform, so the step back is turned by the parent's rotation into world space
+            if(auto* native = registryRef.try_get<NativeBodyComponent>(entity)){
+                float behind = 1.f - alpha;
+                position += Math::rotate(native->previousPosition - transformComponent.position, parentRotation) * behind;
+                rotation += (native->previousRotation - transformComponent.rotation) * behind;
+            }
+
             Material2D mat;
             mat.baseTexture = region.texture.get();
             mat.shader = spriteComponent.shader ? spriteComponent.shader->get() : nullptr;
 
             renderer->batch.draw({
-                transformComponent.position,
-                transformComponent.rotation,
+                position,
+                rotation,
                 spriteComponent.size,
                 spriteComponent.origin,
                 spriteComponent.zIndex,
@@ -1,12 +1,33 @@
 #include "draft/ecs/scene.hpp"
 #include "draft/components/camera_component.hpp"
 #include "draft/components/transform_component.hpp"
+#include "draft/core/engine.hpp"
+#include "draft/ecs/component_catalog.hpp"
 #include "draft/ecs/entity.hpp"
+#include "draft/ecs/scene_serialization_context.hpp"
+#include "draft/ecs/system_catalog.hpp"
+#include "draft/util/serialization/context.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <stdexcept>
 
 namespace Draft {
-    Scene::Scene() : m_relationshipSystem(*this) {}
+    Scene::Scene() : m_relationshipSystem(*this), m_worldTransformSystem(*this) {
+        m_registry.on_construct<CameraComponent>().connect<&Scene::camera_changed_func>(this);
+        m_registry.on_update<CameraComponent>().connect<&Scene::camera_changed_func>(this);
+        m_registry.on_destroy<CameraComponent>().connect<&Scene::camera_changed_func>(this);
+    }
+
+    Scene::~Scene(){
+        m_registry.on_construct<CameraComponent>().disconnect<&Scene::camera_changed_func>(this);
+        m_registry.on_update<CameraComponent>().disconnect<&Scene::camera_changed_func>(this);
+        m_registry.on_destroy<CameraComponent>().disconnect<&Scene::camera_changed_func>(this);
+    }
+
+    void Scene::camera_changed_func(Registry& reg, entt::entity rawEnt){
+        m_activeCameraDirty = true;
+    }
 
     Registry& Scene::get_registry(){ return m_registry; }
     const Registry& Scene::get_registry() const { return m_registry; }
@@ -18,32 +39,133 @@ namespace Draft {
         return Entity{ this, m_registry.create() };
     }
 
+    SceneSnapshot Scene::snapshot(const Engine& engine, AssetManager& assets) const {
+        SceneSnapshot snapshot;
+        snapshot.m_taken = true;
+        snapshot.m_source = this;
+        snapshot.m_assets = &assets;
+
+        if(const auto* entityStorage = m_registry.storage<entt::entity>()){
+            snapshot.m_entities.reserve(entityStorage->size());
+
+            for(entt::entity raw : *entityStorage){
+                if(m_registry.valid(raw))
+                    snapshot.m_entities.push_back(raw);
+            }
+        }
+
+        // Same ids in the copy, so components can be copied across without remapping anything
+        for(entt::entity raw : snapshot.m_entities)
+            snapshot.m_registry.create(raw);
+
+        snapshot.m_components = engine.components().all();
+        for(ComponentTypeInterface* entry : snapshot.m_components)
+            entry->copy_pool(m_registry, snapshot.m_registry);
+
+        // Systems are polymorphic and can't be copied as they are, their reflected data goes
+        // through the binary serializer instead. Entity fields in it need ids, so only build the
+        // map when some system actually has fields.
+        SceneSerializationContext ctx;
+        ctx.assets = &assets;
+
+        bool anyFields = std::ranges::any_of(m_systems.registered_types(), [&](const std::type_index& type){
+            SystemTypeInterface* entry = engine.systems().by_type(type);
+            return entry && entry->has_fields();
+        });
+
+        if(anyFields){
+            for(std::size_t i = 0; i < snapshot.m_entities.size(); i++)
+                ctx.entityToId[snapshot.m_entities[i]] = static_cast<uint32_t>(i);
+        }
+
+        Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
+
+        for(const std::type_index& type : m_systems.registered_types()){
+            SystemTypeInterface* entry = engine.systems().by_type(type);
+            if(!entry)
+                continue;
+
+            SceneSnapshot::SystemData& system = snapshot.m_systems.emplace_back();
+            system.entry = entry;
+            entry->serialize(m_systems, system.data);
+        }
+
+        return snapshot;
+    }
+
+    void Scene::restore(const SceneSnapshot& snapshot){
+        if(snapshot.empty())
+            throw std::runtime_error("Scene::restore(): snapshot is empty");
+
+        if(snapshot.m_source != this)
+            throw std::runtime_error("Scene::restore(): snapshot was taken from another scene");
+
+        m_registry.clear();
+        m_systems.clear();
+
+        // Cleared entities were only released, so each original id (version included) is free
+        // to be recreated exactly
+        for(entt::entity raw : snapshot.m_entities)
+            m_registry.create(raw);
+
+        SceneSerializationContext ctx;
+        ctx.assets = snapshot.m_assets;
+
+        bool anyFields = std::ranges::any_of(snapshot.m_systems, [](const SceneSnapshot::SystemData& system){
+            return system.entry->has_fields();
+        });
+
+        if(anyFields){
+            ctx.idToEntity.reserve(snapshot.m_entities.size());
+            for(entt::entity raw : snapshot.m_entities)
+                ctx.idToEntity.push_back(Entity(this, raw));
+        }
+
+        Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
+
+        // Systems first, so their construct hooks see the components added after them
+        for(const SceneSnapshot::SystemData& system : snapshot.m_systems){
+            system.entry->add(*this);
+            system.entry->deserialize(m_systems, system.data);
+        }
+
+        for(ComponentTypeInterface* entry : snapshot.m_components)
+            entry->copy_pool(snapshot.m_registry, m_registry);
+    }
+
     Camera* Scene::get_active_camera(){
         // If an override supplied, just use that
         if(m_cameraOverride){
             return &*m_cameraOverride;
         }
 
-        // Find a camera component
-        entt::entity best = entt::null;
-        int bestPriority = std::numeric_limits<int>::min();
+        // Re-select only after some CameraComponent changed, or the cached one was switched off directly
+        if(!m_activeCameraDirty && m_activeCamera != entt::null && !m_registry.get<CameraComponent>(m_activeCamera).active)
+            m_activeCameraDirty = true;
 
-        for(auto&& [raw, cam] : m_registry.view<CameraComponent>().each()){
-            if(!cam.active)
-                continue;
+        if(m_activeCameraDirty){
+            m_activeCamera = entt::null;
+            int bestPriority = std::numeric_limits<int>::min();
 
-            if(best != entt::null && cam.priority < bestPriority)
-                continue;
+            for(auto&& [raw, cam] : m_registry.view<CameraComponent>().each()){
+                if(!cam.active)
+                    continue;
 
-            best = raw;
-            bestPriority = cam.priority;
+                if(m_activeCamera != entt::null && cam.priority < bestPriority)
+                    continue;
+
+                m_activeCamera = raw;
+                bestPriority = cam.priority;
+            }
+
+            m_activeCameraDirty = false;
         }
 
-        if(best == entt::null)
+        if(m_activeCamera == entt::null)
             return nullptr;
 
-        CameraComponent& cam = m_registry.get<CameraComponent>(best);
-        if(auto* transform = m_registry.try_get<TransformComponent>(best)){
+        CameraComponent& cam = m_registry.get<CameraComponent>(m_activeCamera);
+        if(auto* transform = m_registry.try_get<TransformComponent>(m_activeCamera)){
             cam.camera.set_position({transform->position.x, transform->position.y, cam.camera.get_position().z});
             cam.camera.set_rotation(transform->rotation);
         }
@@ -59,11 +181,19 @@ namespace Draft {
         return m_cameraOverride.has_value();
     }
 
+    void Scene::update_world_transforms(){
+        m_worldTransformSystem.update();
+    }
+
     void Scene::update(Time dt){
         m_systems.update_all(dt);
+        m_worldTransformSystem.update();
     }
 
     void Scene::render(Time dt, RenderLayer layer){
+        if(has_layer(layer, RenderLayer::Geometry))
+            m_worldTransformSystem.update();
+
         m_systems.render_all(dt, layer);
     }
 
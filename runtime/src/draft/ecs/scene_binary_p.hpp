@@ -0,0 +1,79 @@
+#pragma once
+
+#include "draft/core/engine.hpp"
+#include "draft/ecs/component_catalog.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/ecs/system_catalog.hpp"
+#include "draft/util/serialization/binary.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Draft {
+    /**
+     * @brief The pieces of save_scene_binary()'s format shared by load_scene_binary() and
+     * SceneStreamLoader.
+     */
+    namespace SceneBinary {
+        // "DSCN", then a format version. Version 1 files predate both and start directly with
+        // their system count, which is never anywhere near this large
+        constexpr uint32_t MAGIC = 0x4E435344;
+        constexpr uint32_t VERSION = 3;
+
+        // How a column's bytes are laid out, stored per table entry from version 3 on
+        enum class ColumnLayout : uint8_t {
+            // (entity id, payload length, payload) per component, the only layout in version 2
+            Records = 0,
+            // The whole pool at once, see ComponentTypeInterface::serialize_pool()
+            Pool = 1
+        };
+
+        // One attached system's saved data, entry is nullptr if its type isn't registered
+        struct SystemBlob {
+            SystemTypeInterface* entry = nullptr;
+            Binary::ByteView data;
+        };
+
+        // One entry of a version 2+ file's component table along with its column's bytes, entry
+        // is nullptr if its type isn't registered
+        struct Column {
+            ComponentTypeInterface* entry = nullptr;
+            ColumnLayout layout = ColumnLayout::Records;
+            uint32_t recordCount = 0;
+            Binary::ByteView records;
+        };
+
+        // A version 2+ file split into its sections, nothing decoded yet
+        struct Layout {
+            std::vector<SystemBlob> systems;
+            uint32_t entityCount = 0;
+            std::vector<Column> columns;
+        };
+
+        /**
+         * @brief Reads the system section (shared by every version) off the front of @p reader.
+         * @throws std::runtime_error if a blob runs past the end of @p reader.
+         */
+        std::vector<SystemBlob> read_systems(Binary::Reader& reader, const Engine& engine);
+
+        /**
+         * @brief Attaches each registered system in @p systems via its factory, in file
+         * (original attach) order, then restores its own reflected data onto it.
+         */
+        void attach_systems(Scene& scene, const std::vector<SystemBlob>& systems);
+
+        /**
+         * @brief Splits a whole file into @p layout.
+         * @return False, leaving @p layout untouched, if @p bytes is a version 1 file.
+         * @throws std::runtime_error on an unsupported version or a truncated file.
+         */
+        bool read_layout(Binary::ByteView bytes, const Engine& engine, Layout& layout);
+
+        /**
+         * @brief Reads the next record of a ColumnLayout::Records column off @p records.
+         * @return Its payload, with its entity id in @p id.
+         * @throws std::runtime_error if the record is truncated or @p id is not below @p entityCount.
+         */
+        Binary::ByteView read_record(Binary::Reader& records, uint32_t entityCount, uint32_t& id);
+    }
+}
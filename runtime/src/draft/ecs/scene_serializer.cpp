@@ -3,14 +3,234 @@
 #include "draft/ecs/entity.hpp"
 #include "draft/ecs/scene_serialization_context.hpp"
 #include "draft/ecs/system_catalog.hpp"
+#include "draft/util/json_stream.hpp"
 #include "draft/util/serialization/context.hpp"
+#include "draft/util/thread_pool.hpp"
+#include "scene_binary_p.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Draft {
-    void save_scene(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file){
+    std::vector<SceneBinary::SystemBlob> SceneBinary::read_systems(Binary::Reader& reader, const Engine& engine){
+        uint32_t systemCount = reader.read<uint32_t>();
+
+        std::vector<SystemBlob> systems;
+        for(uint32_t i = 0; i < systemCount; i++){
+            std::string name;
+            Serializer::deserialize_and_advance(name, reader.view());
+
+            uint64_t dataSize = reader.read<uint64_t>();
+            if(dataSize > reader.remaining())
+                throw std::runtime_error("load_scene_binary(): system data out of bounds");
+
+            systems.push_back(SystemBlob{engine.systems().by_name(name), reader.bytes(dataSize)});
+        }
+
+        return systems;
+    }
+
+    void SceneBinary::attach_systems(Scene& scene, const std::vector<SystemBlob>& systems){
+        for(const SystemBlob& system : systems){
+            if(!system.entry)
+                continue;
+
+            system.entry->add(scene);
+            system.entry->deserialize(scene.get_systems(), system.data);
+        }
+    }
+
+    bool SceneBinary::read_layout(Binary::ByteView bytes, const Engine& engine, Layout& layout){
+        Binary::Reader reader(bytes);
+
+        // Files written before the component table existed start straight with the system count
+        uint32_t magic = 0;
+        Binary::read(bytes, magic);
+        if(magic != MAGIC)
+            return false;
+
+        reader.skip(sizeof(uint32_t));
+
+        uint32_t version = reader.read<uint32_t>();
+        if(version < 2 || version > VERSION)
+            throw std::runtime_error("load_scene_binary(): unsupported scene format version " + std::to_string(version));
+
+        layout.systems = read_systems(reader, engine);
+        reader.read(layout.entityCount);
+
+        // Resolve the component table, one by_name() per type rather than per component
+        uint32_t typeCount = reader.read<uint32_t>();
+
+        std::vector<uint64_t> byteSizes(typeCount);
+        layout.columns.resize(typeCount);
+
+        for(uint32_t t = 0; t < typeCount; t++){
+            Column& column = layout.columns[t];
+
+            std::string name;
+            Serializer::deserialize_and_advance(name, reader.view());
+
+            if(version >= 3)
+                reader.read(column.layout);
+
+            if(column.layout != ColumnLayout::Records && column.layout != ColumnLayout::Pool)
+                throw std::runtime_error("load_scene_binary(): unknown component column layout");
+
+            reader.read(column.recordCount);
+            reader.read(byteSizes[t]);
+            column.entry = engine.components().by_name(name);
+        }
+
+        for(uint32_t t = 0; t < typeCount; t++){
+            if(byteSizes[t] > reader.remaining())
+                throw std::runtime_error("load_scene_binary(): component column out of bounds");
+
+            layout.columns[t].records = reader.bytes(byteSizes[t]);
+        }
+
+        return true;
+    }
+
+    Binary::ByteView SceneBinary::read_record(Binary::Reader& records, uint32_t entityCount, uint32_t& id){
+        id = records.read<uint32_t>();
+        uint32_t payloadSize = records.read<uint32_t>();
+
+        if(id >= entityCount || payloadSize > records.remaining())
+            throw std::runtime_error("load_scene_binary(): malformed component record");
+
+        return records.bytes(payloadSize);
+    }
+
+    namespace {
+        // Records per decode task when loading with more than one decode thread, enough to
+        // amortize handing a task over, few enough to spread one big type across every thread
+        constexpr std::size_t DECODE_CHUNK = 4096;
+
+        // A run of one type's components, restored in order after (optionally) being decoded
+        // off the calling thread. Exactly one of payloads/json/pool is in use.
+        struct DecodeBatch {
+            ComponentTypeInterface* entry = nullptr;
+            std::vector<entt::entity> entities;
+            std::vector<Binary::ByteView> payloads;
+            std::vector<JSON*> json;
+
+            // A whole pool column, always restored by deserialize_pool() on the calling thread
+            bool isPool = false;
+            Binary::ByteView pool;
+            uint32_t poolCount = 0;
+
+            std::unique_ptr<DecodedComponents> decoded;
+        };
+
+        // The batch @p entry's next component goes into, starting a new one per type and chunk
+        DecodeBatch& batch_for(std::vector<DecodeBatch>& batches, ComponentTypeInterface* entry){
+            if(batches.empty() || batches.back().entry != entry || batches.back().isPool || batches.back().entities.size() == DECODE_CHUNK){
+                batches.emplace_back();
+                batches.back().entry = entry;
+            }
+
+            return batches.back();
+        }
+
+        // Decodes every batch whose type allows it across @p threads threads, the caller
+        // included. Each one runs under its own ScopedContext over @p ctx, which nothing writes
+        // to until restore_batches(). Rethrows the earliest failed batch's exception, so which
+        // error surfaces doesn't depend on scheduling.
+        void decode_batches(std::vector<DecodeBatch>& batches, SceneSerializationContext& ctx, std::size_t threads){
+            std::vector<std::size_t> pending;
+            for(std::size_t i = 0; i < batches.size(); i++){
+                if(!batches[i].isPool && batches[i].entry->decodes_off_thread())
+                    pending.push_back(i);
+            }
+
+            std::vector<std::exception_ptr> errors(batches.size());
+            ThreadPool pool(threads - 1);
+
+            pool.parallel_for(pending.size(), [&](std::size_t p){
+                DecodeBatch& batch = batches[pending[p]];
+                Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
+
+                try {
+                    if(batch.json.empty())
+                        batch.decoded = batch.entry->decode(batch.payloads);
+                    else
+                        batch.decoded = batch.entry->decode(batch.json);
+                } catch(...){
+                    errors[pending[p]] = std::current_exception();
+                }
+            });
+
+            for(std::exception_ptr& error : errors){
+                if(error)
+                    std::rethrow_exception(error);
+            }
+        }
+
+        // Adds every batch's components to the registry in order, on the calling thread,
+        // decoding on the spot whatever decode_batches() didn't. Pool batches resolve file ids
+        // through @p ids.
+        void restore_batches(Scene& scene, std::span<const entt::entity> ids, std::vector<DecodeBatch>& batches){
+            for(DecodeBatch& batch : batches){
+                if(batch.isPool){
+                    batch.entry->deserialize_pool(scene.get_registry(), ids, batch.pool, batch.poolCount);
+                } else if(batch.decoded){
+                    batch.entry->emplace(scene.get_registry(), batch.entities, *batch.decoded);
+                } else if(!batch.json.empty()){
+                    for(std::size_t i = 0; i < batch.entities.size(); i++)
+                        batch.entry->deserialize(Entity(&scene, batch.entities[i]), *batch.json[i]);
+                } else {
+                    for(std::size_t i = 0; i < batch.entities.size(); i++)
+                        batch.entry->deserialize(Entity(&scene, batch.entities[i]), batch.payloads[i]);
+                }
+            }
+        }
+
+        // Version 1: per entity, a component count then name + byte length + blob per component
+        void load_scene_binary_v1(Scene& scene, const Engine& engine, AssetManager& assets, Binary::ByteView bytes){
+            SceneSerializationContext ctx;
+            ctx.assets = &assets;
+
+            Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
+
+            Binary::Reader reader(bytes);
+            SceneBinary::attach_systems(scene, SceneBinary::read_systems(reader, engine));
+
+            uint32_t entityCount = reader.read<uint32_t>();
+            ctx.idToEntity.reserve(entityCount);
+
+            for(uint32_t i = 0; i < entityCount; i++)
+                ctx.idToEntity.push_back(scene.create_entity());
+
+            for(uint32_t i = 0; i < entityCount; i++){
+                Entity entity = ctx.idToEntity[i];
+
+                uint32_t componentCount = reader.read<uint32_t>();
+
+                for(uint32_t c = 0; c < componentCount; c++){
+                    std::string name;
+                    Serializer::deserialize_and_advance(name, reader.view());
+
+                    Binary::ByteView data = reader.sized<uint64_t>();
+
+                    ComponentTypeInterface* entry = engine.components().by_name(name);
+                    if(!entry)
+                        continue;
+
+                    entry->deserialize(entity, data);
+                }
+            }
+        }
+    }
+
+    void save_scene(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneSaveOptions& options){
         SceneSerializationContext ctx;
         ctx.assets = &assets;
 
@@ -30,10 +250,16 @@ namespace Draft {
 
         // Entity/Resource<T>'s tier-1 (de)serialization reaches into this for the rest of the call.
         Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
-        JSON json = JSON::object();
+
+        // Streamed out rather than built as one document, only a single system's or entity's
+        // JSON exists at any time
+        JSONStreamWriter out(file, options.compact ? -1 : 4);
+        out.begin_object();
 
         // Pass 2: which systems are attached, in attach order, each with its own reflected data.
-        JSON systemsJson = JSON::array();
+        // Written ahead of the entities, so a streaming reader meets them first.
+        out.key("systems");
+        out.begin_array();
         for(const std::type_index& type : scene.get_systems().registered_types()){
             SystemTypeInterface* entry = engine.systems().by_type(type);
 
@@ -42,42 +268,85 @@ namespace Draft {
 
             JSON data = JSON::object();
             entry->serialize(scene.get_systems(), data);
-            systemsJson.push_back(JSON::object({{"name", entry->name()}, {"data", data}}));
+            out.value(JSON::object({{"name", entry->name()}, {"data", std::move(data)}}));
         }
-        json["systems"] = systemsJson;
+        out.end_array();
 
         // Pass 3: per-entity component data, in the order ids were assigned above.
-        JSON entitiesJson = JSON::array();
+        out.key("entities");
+        out.begin_array();
+
+        JSON entityJson = JSON::object();
         for(entt::entity raw : orderedEntities){
             // save_scene only ever reads through this handle. Entity has no const-aware API of
             // its own (see entity.hpp), so a mutable Scene* is needed to construct one at all.
             Entity entity(const_cast<Scene*>(&scene), raw);
 
-            JSON entityJson = JSON::object();
+            entityJson.clear();
             for(ComponentTypeInterface* entry : engine.components().all()){
                 if(!entry->has(entity))
                     continue;
 
-                JSON data = JSON::object();
+                JSON& data = entityJson[entry->name()];
+                data = JSON::object();
                 entry->serialize(entity, data);
-                entityJson[entry->name()] = data;
             }
 
-            entitiesJson.push_back(entityJson);
+            out.value(entityJson);
         }
-        json["entities"] = entitiesJson;
 
-        file.write_string(json.dump(4));
+        out.end_array();
+        out.end_object();
+        out.finish();
     }
 
-    void load_scene(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file){
-        JSON json = JSON(file);
+    void load_scene(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneLoadOptions& options){
+        // The file is read without a DOM of the whole document: each system and each entity
+        // arrives as its own small JSON value. Component values are moved straight into one
+        // column per registered type (registration order) and unknown ones dropped on the spot.
+        const std::vector<ComponentTypeInterface*>& components = engine.components().all();
+
+        struct Column {
+            std::vector<uint32_t> ids;
+            std::vector<JSON> values;
+        };
+
+        std::unordered_map<ComponentTypeInterface*, std::size_t> columnOf;
+        for(std::size_t c = 0; c < components.size(); c++)
+            columnOf[components[c]] = c;
+
+        std::vector<Column> columns(components.size());
+        std::vector<JSON> systemsJson;
+        uint32_t entityCount = 0;
+        std::vector<std::string> members = read_json_stream(file.read_string(), [&](const std::string& key, JSON& element){
+            if(key == "systems"){
+                systemsJson.push_back(std::move(element));
+            } else if(key == "entities"){
+                if(!element.is_object())
+                    throw std::runtime_error("load_scene(): entity " + std::to_string(entityCount) + " is not an object");
+
+                for(auto& [name, value] : element.items()){
+                    ComponentTypeInterface* entry = engine.components().by_name(name);
+                    if(!entry)
+                        continue;
+
+                    Column& column = columns[columnOf.at(entry)];
+                    column.ids.push_back(entityCount);
+                    column.values.push_back(std::move(value));
+                }
+
+                entityCount++;
+            }
+        });
+
+        for(const char* required : {"systems", "entities"}){
+            if(std::find(members.begin(), members.end(), required) == members.end())
+                throw std::runtime_error(std::string("load_scene(): missing \"") + required + "\"");
+        }
 
         SceneSerializationContext ctx;
         ctx.assets = &assets;
-
-        JSON& entitiesJson = json.at("entities");
-        ctx.idToEntity.reserve(entitiesJson.size());
+        ctx.idToEntity.reserve(entityCount);
 
         // Entity/Resource<T>'s tier-1 (de)serialization reaches into this for the rest of the
         // call, active from before pass 1 in case a system's own data references either.
@@ -85,9 +354,7 @@ namespace Draft {
 
         // Load pass 1: attach systems via their registered factory, in file (original attach)
         // order, then restore each one's own reflected data onto the instance just attached.
-        JSON& systemsJson = json.at("systems");
-        for(std::size_t i = 0; i < systemsJson.size(); i++){
-            JSON& systemJson = systemsJson.at(i);
+        for(JSON& systemJson : systemsJson){
             std::string name = systemJson.at("name").get<std::string>();
 
             SystemTypeInterface* entry = engine.systems().by_name(name);
@@ -101,22 +368,26 @@ namespace Draft {
         // Load pass 2: create every saved entity up front, in file order, so a cross-reference
         // to an entity defined later in the file (or to one appearing earlier) already resolves
         // once pass 3 runs.
-        for(std::size_t i = 0; i < entitiesJson.size(); i++)
+        for(uint32_t i = 0; i < entityCount; i++)
             ctx.idToEntity.push_back(scene.create_entity());
 
-        // Load pass 3: restore each entity's component data, now that every system a component's
-        // reactive hook might depend on (e.g. PhysicsSystem) is already attached.
-        for(std::size_t i = 0; i < entitiesJson.size(); i++){
-            Entity entity = ctx.idToEntity[i];
-            JSON& entityJson = entitiesJson.at(i);
-
-            for(ComponentTypeInterface* entry : engine.components().all()){
-                if(!entityJson.contains(entry->name()))
-                    continue;
+        // Load pass 3: restore component data a type at a time, now that every system a
+        // component's reactive hook might depend on (e.g. PhysicsSystem) is already attached.
+        std::vector<DecodeBatch> batches;
+        for(std::size_t c = 0; c < components.size(); c++){
+            Column& column = columns[c];
 
-                entry->deserialize(entity, entityJson.at(entry->name()));
+            for(std::size_t i = 0; i < column.ids.size(); i++){
+                DecodeBatch& batch = batch_for(batches, components[c]);
+                batch.entities.push_back(ctx.idToEntity[column.ids[i]]);
+                batch.json.push_back(&column.values[i]);
             }
         }
+
+        if(options.decodeThreads > 1)
+            decode_batches(batches, ctx, options.decodeThreads);
+
+        restore_batches(scene, {}, batches);
     }
 
     void save_scene_binary(const Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file){
@@ -137,6 +408,10 @@ namespace Draft {
 
         Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
         Binary::ByteArray out;
+        Binary::Writer writer(out);
+
+        writer.write(SceneBinary::MAGIC);
+        writer.write(SceneBinary::VERSION);
 
         // Pass 2: systems, in attach order. Each entry is name + byte length + blob, so a reader
         // that doesn't recognize the name can still skip the blob without decoding it.
@@ -145,7 +420,7 @@ namespace Draft {
             if(engine.systems().by_type(type))
                 systemCount++;
         }
-        Serializer::serialize(systemCount, out);
+        writer.write(systemCount);
 
         for(const std::type_index& type : scene.get_systems().registered_types()){
             SystemTypeInterface* entry = engine.systems().by_type(type);
@@ -154,104 +429,120 @@ namespace Draft {
 
             Serializer::serialize(entry->name(), out);
 
-            Binary::ByteArray data;
-            entry->serialize(scene.get_systems(), data);
-            Serializer::serialize(static_cast<uint64_t>(data.size()), out);
-            out.insert(out.end(), data.begin(), data.end());
+            // Serialized straight into out, its length patched in after
+            std::size_t sizeSlot = writer.placeholder<uint64_t>();
+            entry->serialize(scene.get_systems(), out);
+            writer.patch_size<uint64_t>(sizeSlot);
         }
 
-        // Pass 3: per-entity component data, same skip-if-unregistered framing as systems above.
-        Serializer::serialize(static_cast<uint32_t>(orderedEntities.size()), out);
+        // Pass 3: the component table, every registered type's name and column layout once, with
+        // its column's record count and byte length patched in once that column is written below
+        writer.write(static_cast<uint32_t>(orderedEntities.size()));
 
-        for(entt::entity raw : orderedEntities){
-            Entity entity(const_cast<Scene*>(&scene), raw);
+        const auto& components = engine.components().all();
+        writer.write(static_cast<uint32_t>(components.size()));
 
-            uint32_t componentCount = 0;
-            for(ComponentTypeInterface* entry : engine.components().all()){
-                if(entry->has(entity))
-                    componentCount++;
+        std::vector<std::size_t> tableSlots;
+        tableSlots.reserve(components.size());
+
+        for(ComponentTypeInterface* entry : components){
+            Serializer::serialize(entry->name(), out);
+            writer.write(entry->is_bulk_copyable() ? SceneBinary::ColumnLayout::Pool : SceneBinary::ColumnLayout::Records);
+            tableSlots.push_back(writer.placeholder<uint32_t>());
+            writer.placeholder<uint64_t>();
+        }
+
+        // Pass 4: one column per type, either its whole pool copied out at once or (entity id,
+        // payload length, payload) records
+        for(std::size_t t = 0; t < components.size(); t++){
+            ComponentTypeInterface* entry = components[t];
+            std::size_t columnStart = writer.size();
+            uint32_t recordCount = 0;
+
+            if(entry->is_bulk_copyable()){
+                recordCount = entry->serialize_pool(scene, ctx.entityToId, out);
+                writer.patch(tableSlots[t], recordCount);
+                writer.patch(tableSlots[t] + sizeof(uint32_t), static_cast<uint64_t>(writer.size() - columnStart));
+                continue;
             }
-            Serializer::serialize(componentCount, out);
 
-            for(ComponentTypeInterface* entry : engine.components().all()){
+            for(std::size_t id = 0; id < orderedEntities.size(); id++){
+                Entity entity(const_cast<Scene*>(&scene), orderedEntities[id]);
                 if(!entry->has(entity))
                     continue;
 
-                Serializer::serialize(entry->name(), out);
+                writer.write(static_cast<uint32_t>(id));
 
-                Binary::ByteArray data;
-                entry->serialize(entity, data);
-                Serializer::serialize(static_cast<uint64_t>(data.size()), out);
-                out.insert(out.end(), data.begin(), data.end());
+                // Serialized straight into out, no per-component scratch buffer
+                std::size_t sizeSlot = writer.placeholder<uint32_t>();
+                entry->serialize(entity, out);
+                writer.patch_size<uint32_t>(sizeSlot);
+
+                recordCount++;
             }
+
+            writer.patch(tableSlots[t], recordCount);
+            writer.patch(tableSlots[t] + sizeof(uint32_t), static_cast<uint64_t>(writer.size() - columnStart));
         }
 
         file.write_bytes(out);
     }
 
-    void load_scene_binary(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file){
+    void load_scene_binary(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file, const SceneLoadOptions& options){
         Binary::ByteArray bytes = file.read_bytes();
-        Binary::ByteView span(bytes);
+
+        SceneBinary::Layout layout;
+        if(!SceneBinary::read_layout(bytes, engine, layout)){
+            load_scene_binary_v1(scene, engine, assets, bytes);
+            return;
+        }
 
         SceneSerializationContext ctx;
         ctx.assets = &assets;
 
         Serializer::ScopedContext<SceneSerializationContext> scope(ctx);
 
-        // Load pass 1: attach systems via their registered factory, in file (original attach)
-        // order, then restore each one's own reflected data onto the instance just attached.
-        uint32_t systemCount = 0;
-        Serializer::deserialize_and_advance(systemCount, span);
-
-        for(uint32_t i = 0; i < systemCount; i++){
-            std::string name;
-            Serializer::deserialize_and_advance(name, span);
-
-            uint64_t dataSize = 0;
-            Serializer::deserialize_and_advance(dataSize, span);
-
-            Binary::ByteView data = span.subspan(0, dataSize);
-            span = span.subspan(dataSize);
-
-            SystemTypeInterface* entry = engine.systems().by_name(name);
-            if(!entry)
-                continue;
-
-            entry->add(scene);
-            entry->deserialize(scene.get_systems(), data);
-        }
+        SceneBinary::attach_systems(scene, layout.systems);
 
         // Load pass 2: create every saved entity up front, same reasoning as load_scene().
-        uint32_t entityCount = 0;
-        Serializer::deserialize_and_advance(entityCount, span);
-        ctx.idToEntity.reserve(entityCount);
+        ctx.idToEntity.reserve(layout.entityCount);
+        std::vector<entt::entity> ids(layout.entityCount);
 
-        for(uint32_t i = 0; i < entityCount; i++)
+        for(uint32_t i = 0; i < layout.entityCount; i++){
             ctx.idToEntity.push_back(scene.create_entity());
+            ids[i] = ctx.idToEntity[i];
+        }
 
-        // Load pass 3: restore each entity's component data.
-        for(uint32_t i = 0; i < entityCount; i++){
-            Entity entity = ctx.idToEntity[i];
-
-            uint32_t componentCount = 0;
-            Serializer::deserialize_and_advance(componentCount, span);
-
-            for(uint32_t c = 0; c < componentCount; c++){
-                std::string name;
-                Serializer::deserialize_and_advance(name, span);
-
-                uint64_t dataSize = 0;
-                Serializer::deserialize_and_advance(dataSize, span);
+        // Load pass 3: split each column into its records, skipping unregistered types whole
+        std::vector<DecodeBatch> batches;
+        for(const SceneBinary::Column& column : layout.columns){
+            if(!column.entry)
+                continue;
 
-                Binary::ByteView data = span.subspan(0, dataSize);
-                span = span.subspan(dataSize);
+            if(column.layout == SceneBinary::ColumnLayout::Pool){
+                DecodeBatch& batch = batches.emplace_back();
+                batch.entry = column.entry;
+                batch.isPool = true;
+                batch.pool = column.records;
+                batch.poolCount = column.recordCount;
+                continue;
+            }
 
-                ComponentTypeInterface* entry = engine.components().by_name(name);
-                if(!entry)
-                    continue;
+            Binary::Reader records(column.records);
+            for(uint32_t r = 0; r < column.recordCount; r++){
+                uint32_t id = 0;
+                Binary::ByteView payload = SceneBinary::read_record(records, layout.entityCount, id);
 
-                entry->deserialize(entity, data);
+                DecodeBatch& batch = batch_for(batches, column.entry);
+                batch.entities.push_back(ids[id]);
+                batch.payloads.push_back(payload);
             }
         }
+
+        // Load pass 4: decode (in parallel if asked to), then add to the registry in column order
+        if(options.decodeThreads > 1)
+            decode_batches(batches, ctx, options.decodeThreads);
+
+        restore_batches(scene, ids, batches);
     }
 }
@@ -0,0 +1,205 @@
+#include "draft/ecs/scene_stream_loader.hpp"
+#include "draft/ecs/component_catalog.hpp"
+#include "draft/ecs/scene_serialization_context.hpp"
+#include "draft/ecs/scene_serializer.hpp"
+#include "draft/util/clock.hpp"
+#include "draft/util/serialization/context.hpp"
+#include "scene_binary_p.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace Draft {
+    namespace {
+        // Entities created, or component records decoded, between two budget checks
+        constexpr std::size_t ENTITY_STEP = 1024;
+        constexpr uint32_t RECORD_STEP = 256;
+    }
+
+    struct SceneStreamLoader::State {
+        Binary::ByteArray bytes;
+        SceneBinary::Layout layout;
+        bool legacy = false;
+        bool finished = false;
+
+        // Entity references resolve against idToEntity, which holds the scene's own entities
+        SceneSerializationContext ctx;
+        std::vector<entt::entity> liveIds;
+
+        // Where components wait until finish(). Its entities are created in file order into a
+        // fresh registry, so entt::to_entity() of each is its file id.
+        Registry staging;
+        std::vector<entt::entity> stagingIds;
+
+        // The column being decoded, and what's left of it
+        std::size_t column = 0;
+        uint32_t recordsDone = 0;
+        Binary::Reader records{Binary::ByteView()};
+
+        std::size_t totalWork = 0;
+        std::size_t doneWork = 0;
+
+        // Reused scratch for one step's records
+        std::vector<Binary::ByteView> payloads;
+        std::vector<entt::entity> entities;
+    };
+
+    SceneStreamLoader::SceneStreamLoader(Scene& scene, const Engine& engine, AssetManager& assets, const FileHandle& file)
+        : m_scene(scene), m_engine(engine), m_assets(assets), m_file(file), m_state(std::make_unique<State>()) {
+        State& state = *m_state;
+        state.ctx.assets = &assets;
+        state.bytes = file.read_bytes();
+
+        state.legacy = !SceneBinary::read_layout(state.bytes, engine, state.layout);
+        if(state.legacy){
+            // Reloaded whole by load_scene_binary() on the first pump()
+            state.bytes = {};
+            state.totalWork = 1;
+            return;
+        }
+
+        state.totalWork = state.layout.entityCount;
+        for(const SceneBinary::Column& column : state.layout.columns){
+            if(column.entry)
+                state.totalWork += column.recordCount;
+        }
+
+        state.ctx.idToEntity.reserve(state.layout.entityCount);
+        state.liveIds.reserve(state.layout.entityCount);
+        state.stagingIds.reserve(state.layout.entityCount);
+
+        if(!state.layout.columns.empty())
+            state.records = Binary::Reader(state.layout.columns.front().records);
+    }
+
+    SceneStreamLoader::~SceneStreamLoader(){
+        if(!m_state->finished)
+            m_scene.get_registry().destroy(m_state->liveIds.begin(), m_state->liveIds.end());
+    }
+
+    void SceneStreamLoader::set_completion_callback(CompletionCallback callback){
+        m_callback = std::move(callback);
+    }
+
+    bool SceneStreamLoader::pump(Time budget){
+        Clock clock;
+
+        while(!m_state->finished){
+            step();
+
+            if(clock.get_elapsed_time() >= budget)
+                break;
+        }
+
+        return m_state->finished;
+    }
+
+    bool SceneStreamLoader::is_finished() const {
+        return m_state->finished;
+    }
+
+    float SceneStreamLoader::get_progress() const {
+        if(m_state->totalWork == 0)
+            return m_state->finished ? 1.f : 0.f;
+
+        return static_cast<float>(m_state->doneWork) / static_cast<float>(m_state->totalWork);
+    }
+
+    void SceneStreamLoader::step(){
+        State& state = *m_state;
+
+        if(state.legacy){
+            load_scene_binary(m_scene, m_engine, m_assets, m_file);
+            finish();
+            return;
+        }
+
+        Serializer::ScopedContext<SceneSerializationContext> scope(state.ctx);
+
+        // Every entity comes first, so any reference a component holds resolves while decoding
+        if(state.liveIds.size() < state.layout.entityCount){
+            std::size_t end = std::min<std::size_t>(state.liveIds.size() + ENTITY_STEP, state.layout.entityCount);
+
+            for(std::size_t i = state.liveIds.size(); i < end; i++){
+                Entity entity = m_scene.create_entity();
+                state.ctx.idToEntity.push_back(entity);
+                state.liveIds.push_back(entity);
+                state.stagingIds.push_back(state.staging.create());
+
+                assert(entt::to_entity(state.stagingIds.back()) == i && "SceneStreamLoader: staging ids must match file ids");
+                state.doneWork++;
+            }
+
+            return;
+        }
+
+        if(state.column == state.layout.columns.size()){
+            finish();
+            return;
+        }
+
+        const SceneBinary::Column& column = state.layout.columns[state.column];
+        const uint32_t before = state.recordsDone;
+
+        if(!column.entry){
+            // Unregistered, skipped whole (and never counted towards progress)
+            state.recordsDone = column.recordCount;
+        } else if(column.layout == SceneBinary::ColumnLayout::Pool){
+            // Already just a copy, not worth slicing
+            column.entry->deserialize_pool(state.staging, state.stagingIds, column.records, column.recordCount);
+            state.recordsDone = column.recordCount;
+        } else {
+            uint32_t end = std::min(state.recordsDone + RECORD_STEP, column.recordCount);
+
+            state.payloads.clear();
+            state.entities.clear();
+
+            for(uint32_t r = state.recordsDone; r < end; r++){
+                uint32_t id = 0;
+                state.payloads.push_back(SceneBinary::read_record(state.records, state.layout.entityCount, id));
+                state.entities.push_back(state.stagingIds[id]);
+            }
+
+            if(!state.payloads.empty())
+                column.entry->emplace(state.staging, state.entities, *column.entry->decode(state.payloads));
+
+            state.recordsDone = end;
+        }
+
+        if(column.entry)
+            state.doneWork += state.recordsDone - before;
+
+        if(state.recordsDone == column.recordCount){
+            state.column++;
+            state.recordsDone = 0;
+
+            if(state.column < state.layout.columns.size())
+                state.records = Binary::Reader(state.layout.columns[state.column].records);
+        }
+    }
+
+    void SceneStreamLoader::finish(){
+        State& state = *m_state;
+
+        if(!state.legacy){
+            // Systems first, so their construct hooks see the components moved in after them,
+            // same order load_scene_binary() uses
+            SceneBinary::attach_systems(m_scene, state.layout.systems);
+
+            for(const SceneBinary::Column& column : state.layout.columns){
+                if(column.entry)
+                    column.entry->transfer(state.staging, m_scene.get_registry(), state.liveIds);
+            }
+
+            state.bytes = {};
+            state.staging.clear();
+        }
+
+        state.finished = true;
+        state.doneWork = state.totalWork;
+
+        if(m_callback)
+            m_callback(m_scene);
+    }
+}
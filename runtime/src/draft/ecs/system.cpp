@@ -1,28 +1,170 @@
 #include "draft/ecs/system.hpp"
 
+namespace {
+    bool overlaps(const std::vector<std::type_index>& lhs, const std::vector<std::type_index>& rhs){
+        for(auto& type : lhs){
+            if(std::find(rhs.begin(), rhs.end(), type) != rhs.end())
+                return true;
+        }
+
+        return false;
+    }
+}
+
 namespace Draft {
+    bool SystemAccess::conflicts_with(const SystemAccess& other) const {
+        return overlaps(writes, other.writes) || overlaps(writes, other.reads) || overlaps(reads, other.writes);
+    }
+
+    void SystemRegistry::insert(std::type_index type, std::unique_ptr<AbstractSystem> systemPtr){
+        AbstractSystem& ref = *systemPtr;
+
+        auto it = m_systems.find(type);
+        if(it == m_systems.end()){
+            m_order.push_back(type);
+            m_ordered.push_back(&ref);
+        } else {
+            if(m_attached)
+                it->second->on_detach();
+
+            auto index = std::find(m_order.begin(), m_order.end(), type) - m_order.begin();
+            m_ordered[index] = &ref;
+        }
+
+        m_systems[type] = std::move(systemPtr);
+        m_scheduleDirty = true;
+
+        if(m_attached)
+            ref.on_attach();
+    }
+
+    void SystemRegistry::set_worker_threads(std::size_t count){
+        if(count == get_worker_threads())
+            return;
+
+        m_pool = count > 0 ? std::make_unique<ThreadPool>(count) : nullptr;
+    }
+
     void SystemRegistry::update_all(Time dt){
-        for(auto& type : m_order){
-            auto it = m_systems.find(type);
-            if(it != m_systems.end())
-                it->second->update(dt);
+        if(!m_pool){
+            for(auto* system : m_ordered)
+                system->update(dt);
+
+            return;
+        }
+
+        if(m_scheduleDirty)
+            rebuild_schedule();
+
+        for(auto& segment : m_segments){
+            if(segment.parallel && segment.end - segment.begin > 1){
+                run_parallel(segment, dt);
+                continue;
+            }
+
+            for(std::size_t i = segment.begin; i < segment.end; i++)
+                m_schedule[i].system->update(dt);
+        }
+    }
+
+    void SystemRegistry::rebuild_schedule(){
+        m_schedule.clear();
+        m_segments.clear();
+        m_schedule.resize(m_ordered.size());
+        m_pendingPredecessors = std::make_unique<std::atomic<std::size_t>[]>(m_ordered.size());
+
+        for(std::size_t i = 0; i < m_ordered.size(); i++){
+            m_schedule[i].system = m_ordered[i];
+            m_schedule[i].access = m_ordered[i]->get_access();
+        }
+
+        // Undeclared systems split the order into segments, each one a barrier on its own
+        for(std::size_t i = 0; i < m_schedule.size();){
+            if(!m_schedule[i].access){
+                m_segments.push_back({i, i + 1, false});
+                i++;
+                continue;
+            }
+
+            ScheduleSegment segment{i, i, true};
+            while(segment.end < m_schedule.size() && m_schedule[segment.end].access)
+                segment.end++;
+
+            // Within a segment, a system waits on every earlier one it conflicts with
+            for(std::size_t later = segment.begin; later < segment.end; later++){
+                for(std::size_t earlier = segment.begin; earlier < later; earlier++){
+                    if(m_schedule[earlier].access->conflicts_with(*m_schedule[later].access)){
+                        m_schedule[earlier].successors.push_back(later);
+                        m_schedule[later].predecessors++;
+                    }
+                }
+            }
+
+            m_segments.push_back(segment);
+            i = segment.end;
         }
+
+        m_scheduleDirty = false;
+    }
+
+    void SystemRegistry::run_parallel(const ScheduleSegment& segment, Time dt){
+        m_remaining = segment.end - segment.begin;
+        m_error = nullptr;
+        m_failed = false;
+
+        for(std::size_t i = segment.begin; i < segment.end; i++)
+            m_pendingPredecessors[i] = m_schedule[i].predecessors;
+
+        for(std::size_t i = segment.begin; i < segment.end; i++){
+            if(m_schedule[i].predecessors == 0)
+                m_pool->submit([this, i, dt]{ run_node(i, dt); });
+        }
+
+        {
+            std::unique_lock lock(m_runMutex);
+            m_runCv.wait(lock, [this]{ return m_remaining == 0; });
+        }
+
+        if(m_error)
+            std::rethrow_exception(m_error);
+    }
+
+    void SystemRegistry::run_node(std::size_t index, Time dt){
+        auto& node = m_schedule[index];
+
+        if(!m_failed){
+            try {
+                node.system->update(dt);
+            } catch(...){
+                std::lock_guard lock(m_runMutex);
+                if(!m_error)
+                    m_error = std::current_exception();
+
+                m_failed = true;
+            }
+        }
+
+        // Successors still have to be released after a failure, so m_remaining reaches zero
+        for(auto successor : node.successors){
+            if(--m_pendingPredecessors[successor] == 0)
+                m_pool->submit([this, successor, dt]{ run_node(successor, dt); });
+        }
+
+        std::lock_guard lock(m_runMutex);
+        if(--m_remaining == 0)
+            m_runCv.notify_all();
     }
 
     void SystemRegistry::render_all(Time dt, RenderLayer layer){
-        for(auto& type : m_order){
-            auto it = m_systems.find(type);
-            if(it != m_systems.end() && has_layer(it->second->get_render_layers(), layer))
-                it->second->render(dt, layer);
+        for(auto* system : m_ordered){
+            if(has_layer(system->get_render_layers(), layer))
+                system->render(dt, layer);
         }
     }
 
     void SystemRegistry::attach_all(){
-        for(auto& type : m_order){
-            auto it = m_systems.find(type);
-            if(it != m_systems.end())
-                it->second->on_attach();
-        }
+        for(auto* system : m_ordered)
+            system->on_attach();
 
         m_attached = true;
     }
@@ -33,17 +175,13 @@ namespace Draft {
     }
 
     void SystemRegistry::notify_detach_all(){
-        for(auto& type : m_order){
-            auto it = m_systems.find(type);
-            if(it != m_systems.end())
-                it->second->on_detach();
-        }
+        for(auto* system : m_ordered)
+            system->on_detach();
     }
 
     bool SystemRegistry::dispatch_event(const Event& event){
-        for(auto& type : m_order){
-            auto it = m_systems.find(type);
-            if(it != m_systems.end() && it->second->on_event(event))
+        for(auto* system : m_ordered){
+            if(system->on_event(event))
                 return true;
         }
 
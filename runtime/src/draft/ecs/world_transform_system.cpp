@@ -0,0 +1,155 @@
+#include "draft/ecs/world_transform_system.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+
+namespace {
+    entt::entity parent_of(const Draft::Registry& reg, entt::entity rawEnt){
+        auto* child = reg.try_get<Draft::ChildComponent>(rawEnt);
+        if(!child || !child->parent.is_valid())
+            return entt::null;
+
+        entt::entity parent = child->parent;
+        return reg.valid(parent) ? parent : entt::null;
+    }
+}
+
+namespace Draft {
+    void WorldTransformSystem::construct_transform_func(Registry& reg, entt::entity rawEnt){
+        // Start out as if this entity were a root, the next pass fixes it up if it isn't
+        TransformComponent& transform = reg.get<TransformComponent>(rawEnt);
+        WorldTransformComponent& world = reg.emplace_or_replace<WorldTransformComponent>(rawEnt);
+        world.position = transform.position;
+        world.rotation = transform.rotation;
+        world.matrix = transform.get_transform();
+
+        // Children computed while this entity counted as the identity need refreshing too
+        mark_dirty(rawEnt);
+    }
+
+    void WorldTransformSystem::deconstruct_transform_func(Registry& reg, entt::entity rawEnt){
+        reg.remove<WorldTransformComponent>(rawEnt);
+
+        if(auto* parent = reg.try_get<ParentComponent>(rawEnt)){
+            for(auto& child : parent->children)
+                mark_dirty(child);
+        }
+    }
+
+    void WorldTransformSystem::hierarchy_changed_func(Registry& reg, entt::entity rawEnt){
+        mark_dirty(rawEnt);
+    }
+
+    void WorldTransformSystem::mark_dirty(entt::entity rawEnt){
+        if(auto* world = m_registryRef.try_get<WorldTransformComponent>(rawEnt))
+            world->m_dirty = true;
+
+        m_changed.push_back(rawEnt);
+    }
+
+    void WorldTransformSystem::update_subtree(entt::entity root){
+        // Find the nearest transformed ancestor's pose. If any ancestor is still dirty, its own
+        // subtree (which includes this one) is recomputed anyway, so skip the duplicate work
+        Vector2f parentPosition = {};
+        float parentRotation = 0.f;
+        bool foundParent = false;
+
+        for(entt::entity ancestor = parent_of(m_registryRef, root); ancestor != entt::null; ancestor = parent_of(m_registryRef, ancestor)){
+            auto* world = m_registryRef.try_get<WorldTransformComponent>(ancestor);
+            if(!world)
+                continue;
+
+            if(world->m_dirty)
+                return;
+
+            if(!foundParent){
+                parentPosition = world->position;
+                parentRotation = world->rotation;
+                foundParent = true;
+            }
+        }
+
+        m_stack.clear();
+        m_stack.push_back({root, parentPosition, parentRotation});
+
+        while(!m_stack.empty()){
+            PendingNode node = m_stack.back();
+            m_stack.pop_back();
+
+            Vector2f position = node.parentPosition;
+            float rotation = node.parentRotation;
+
+            if(auto* world = m_registryRef.try_get<WorldTransformComponent>(node.entity)){
+                const TransformComponent& local = m_registryRef.get<TransformComponent>(node.entity);
+
+                position = node.parentPosition + Math::rotate(local.position, node.parentRotation);
+                rotation = node.parentRotation + local.rotation;
+
+                world->position = position;
+                world->rotation = rotation;
+                world->matrix = Math::rotate(Math::translate(Matrix3(1.f), position), rotation);
+                world->m_localPosition = local.position;
+                world->m_localRotation = local.rotation;
+                world->m_dirty = false;
+            }
+
+            // Transform-less entities pass their parent's pose straight through
+            if(auto* parent = m_registryRef.try_get<ParentComponent>(node.entity)){
+                for(auto& child : parent->children)
+                    m_stack.push_back({child, position, rotation});
+            }
+        }
+    }
+
+    // Constructors
+    WorldTransformSystem::WorldTransformSystem(Scene& sceneRef) : m_registryRef(sceneRef.get_registry()) {
+        // Attach listeners
+        m_registryRef.on_construct<TransformComponent>().connect<&WorldTransformSystem::construct_transform_func>(this);
+        m_registryRef.on_destroy<TransformComponent>().connect<&WorldTransformSystem::deconstruct_transform_func>(this);
+        m_registryRef.on_construct<ChildComponent>().connect<&WorldTransformSystem::hierarchy_changed_func>(this);
+        m_registryRef.on_destroy<ChildComponent>().connect<&WorldTransformSystem::hierarchy_changed_func>(this);
+    }
+
+    WorldTransformSystem::~WorldTransformSystem(){
+        // Remove listeners
+        m_registryRef.on_construct<TransformComponent>().disconnect<&WorldTransformSystem::construct_transform_func>(this);
+        m_registryRef.on_destroy<TransformComponent>().disconnect<&WorldTransformSystem::deconstruct_transform_func>(this);
+        m_registryRef.on_construct<ChildComponent>().disconnect<&WorldTransformSystem::hierarchy_changed_func>(this);
+        m_registryRef.on_destroy<ChildComponent>().disconnect<&WorldTransformSystem::hierarchy_changed_func>(this);
+    }
+
+    // Functions
+    SystemAccess WorldTransformSystem::get_listener_access(){
+        return SystemAccess()
+            .read<TransformComponent, ParentComponent>()
+            .write<WorldTransformComponent, WorldTransformSystem>();
+    }
+
+    void WorldTransformSystem::update(){
+        // Local transforms are plain fields, written directly as often as through patch(), so
+        // catch changes by comparing against what each pose was last computed from
+        for(auto&& [raw, transform, world] : m_registryRef.view<TransformComponent, WorldTransformComponent>().each()){
+            // Re-queue anything still dirty too, a duplicate entry is skipped below once clean
+            if(world.m_dirty || transform.position != world.m_localPosition || transform.rotation != world.m_localRotation){
+                world.m_dirty = true;
+                m_changed.push_back(raw);
+            }
+        }
+
+        for(std::size_t i = 0; i < m_changed.size(); i++){
+            entt::entity raw = m_changed[i];
+            if(!m_registryRef.valid(raw))
+                continue;
+
+            // Already refreshed as part of an ancestor's subtree earlier in this pass
+            auto* world = m_registryRef.try_get<WorldTransformComponent>(raw);
+            if(world && !world->m_dirty)
+                continue;
+
+            update_subtree(raw);
+        }
+
+        m_changed.clear();
+    }
+}
@@ -1,5 +1,7 @@
 #include "draft/input/input_manager.hpp"
 
+#include <stdexcept>
+
 namespace Draft {
     namespace {
         const std::vector<InputBinding> EMPTY_BINDINGS;
@@ -20,6 +22,27 @@ namespace Draft {
 
     InputManager::InputManager(Keyboard& keyboardRef, Mouse& mouseRef) : keyboardRef(keyboardRef), mouseRef(mouseRef) {}
 
+    std::vector<InputBinding>& InputManager::bindings_for(ActionMap& actions, const std::string& action){
+        StringId id = StringId::intern(action);
+
+        // Checked against both maps, so the defaults and current bindings never disagree on a name
+        for(const ActionMap* map : {&m_defaultBindings, &m_bindings}){
+            auto it = map->find(id);
+            if(it != map->end() && it->second.name != action)
+                throw std::logic_error("InputManager: action '" + action + "' has the same id as '" + it->second.name + "'");
+        }
+
+        Action& entry = actions[id];
+        entry.name = action;
+        return entry.bindings;
+    }
+
+    const InputManager::Action* InputManager::find_action(const ActionMap& actions, const std::string& action){
+        // The name is checked too, in case @p action was never bound but shares an id with one that was
+        auto it = actions.find(StringId(action));
+        return it != actions.end() && it->second.name == action ? &it->second : nullptr;
+    }
+
     bool InputManager::is_binding_pressed(const InputBinding& binding) const {
         switch(binding.source){
             case InputSource::Keyboard: return keyboardRef.is_pressed(binding.code);
@@ -44,64 +67,76 @@ namespace Draft {
 
     void InputManager::bind_default(const std::string& action, std::initializer_list<InputBinding> bindings){
         std::vector<InputBinding> list(bindings);
-        m_defaultBindings[action] = list;
+        bindings_for(m_defaultBindings, action) = list;
 
         // Only seed the current binding on first registration, as to not affect already bound
-        if(!m_bindings.contains(action))
-            m_bindings[action] = std::move(list);
+        if(!find_action(m_bindings, action))
+            bindings_for(m_bindings, action) = std::move(list);
     }
 
     void InputManager::set_bindings(const std::string& action, std::vector<InputBinding> bindings){
-        m_bindings[action] = std::move(bindings);
+        bindings_for(m_bindings, action) = std::move(bindings);
     }
 
     void InputManager::add_binding(const std::string& action, InputBinding binding){
-        m_bindings[action].push_back(binding);
+        bindings_for(m_bindings, action).push_back(binding);
     }
 
     void InputManager::remove_binding(const std::string& action, const InputBinding& binding){
-        auto it = m_bindings.find(action);
-        if(it == m_bindings.end())
+        auto it = m_bindings.find(StringId(action));
+        if(it == m_bindings.end() || it->second.name != action)
             return;
 
-        std::erase(it->second, binding);
+        std::erase(it->second.bindings, binding);
     }
 
     void InputManager::clear_bindings(const std::string& action){
-        m_bindings[action].clear();
+        bindings_for(m_bindings, action).clear();
     }
 
     void InputManager::reset_to_defaults(){
-        for(auto& [action, bindings] : m_defaultBindings)
-            m_bindings[action] = bindings;
+        for(auto& [id, action] : m_defaultBindings)
+            m_bindings[id] = action;
     }
 
     void InputManager::reset_to_defaults(const std::string& action){
-        auto it = m_defaultBindings.find(action);
-        if(it != m_defaultBindings.end())
-            m_bindings[action] = it->second;
+        if(const Action* defaults = find_action(m_defaultBindings, action))
+            m_bindings[StringId(action)] = *defaults;
     }
 
     bool InputManager::has_action(const std::string& action) const {
+        return find_action(m_bindings, action) != nullptr;
+    }
+
+    bool InputManager::has_action(StringId action) const {
         return m_bindings.contains(action);
     }
 
     const std::vector<InputBinding>& InputManager::get_bindings(const std::string& action) const {
+        const Action* entry = find_action(m_bindings, action);
+        return entry ? entry->bindings : EMPTY_BINDINGS;
+    }
+
+    const std::vector<InputBinding>& InputManager::get_bindings(StringId action) const {
         auto it = m_bindings.find(action);
-        return it == m_bindings.end() ? EMPTY_BINDINGS : it->second;
+        return it == m_bindings.end() ? EMPTY_BINDINGS : it->second.bindings;
     }
 
     const std::vector<InputBinding>& InputManager::get_default_bindings(const std::string& action) const {
-        auto it = m_defaultBindings.find(action);
-        return it == m_defaultBindings.end() ? EMPTY_BINDINGS : it->second;
+        const Action* entry = find_action(m_defaultBindings, action);
+        return entry ? entry->bindings : EMPTY_BINDINGS;
     }
 
     bool InputManager::is_pressed(const std::string& action) const {
+        return has_action(action) && is_pressed(StringId(action));
+    }
+
+    bool InputManager::is_pressed(StringId action) const {
         auto it = m_bindings.find(action);
         if(it == m_bindings.end())
             return false;
 
-        for(const InputBinding& binding : it->second){
+        for(const InputBinding& binding : it->second.bindings){
             if(is_binding_pressed(binding))
                 return true;
         }
@@ -110,12 +145,16 @@ namespace Draft {
     }
 
     bool InputManager::is_just_pressed(const std::string& action) const {
+        return has_action(action) && is_just_pressed(StringId(action));
+    }
+
+    bool InputManager::is_just_pressed(StringId action) const {
         auto it = m_bindings.find(action);
         if(it == m_bindings.end())
             return false;
 
         bool result = false;
-        for(const InputBinding& binding : it->second)
+        for(const InputBinding& binding : it->second.bindings)
             result |= is_binding_just_pressed(binding);
 
         return result;
@@ -124,17 +163,17 @@ namespace Draft {
     JSON InputManager::save_bindings() const {
         JSON json = JSON::object();
 
-        for(auto& [action, bindings] : m_bindings){
+        for(auto& [id, action] : m_bindings){
             JSON array = JSON::array();
 
-            for(auto& binding : bindings){
+            for(auto& binding : action.bindings){
                 array.push_back(JSON::object({
                     {"source", source_to_string(binding.source)},
                     {"code", binding.code}
                 }));
             }
 
-            json[action] = std::move(array);
+            json[action.name] = std::move(array);
         }
 
         return json;
@@ -156,7 +195,7 @@ namespace Draft {
                 bindings.push_back(binding);
             }
 
-            m_bindings[action] = std::move(bindings);
+            bindings_for(m_bindings, action) = std::move(bindings);
         }
     }
 
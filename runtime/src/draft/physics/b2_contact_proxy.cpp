@@ -0,0 +1,91 @@
+#include "b2_contact_proxy_p.hpp"
+#include "draft/physics/vector2_p.hpp"
+#include "draft/physics/rigid_body.hpp"
+#include "box2d/b2_contact.h"
+#include "box2d/b2_fixture.h"
+
+#include <utility>
+
+namespace Draft {
+    // Private functions
+    bool B2ContactProxy::resolve(ContactEvent& event, b2Fixture* fixtureA, b2Fixture* fixtureB) const {
+        // Convert to draft, sensor first
+        if(!fixtureA->IsSensor() && fixtureB->IsSensor())
+            std::swap(fixtureA, fixtureB);
+
+        event.bodyA = world.get_body(fixtureA->GetBody());
+        event.bodyB = world.get_body(fixtureB->GetBody());
+
+        if(!event.bodyA || !event.bodyB)
+            return false;
+
+        event.fixtureA = event.bodyA->get_fixture(fixtureA);
+        event.fixtureB = event.bodyB->get_fixture(fixtureB);
+        return true;
+    }
+
+    // Constructors
+    B2ContactProxy::B2ContactProxy(const World& world, std::vector<ContactEvent>& events) : world(world), events(events) {};
+
+    // Functions
+    void B2ContactProxy::BeginContact(b2Contact* contact){
+        if(!recording)
+            return;
+
+        ContactEvent event;
+        bool sensor = contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor();
+        event.type = sensor ? ContactEventType::SENSOR_BEGIN : ContactEventType::BEGIN_CONTACT;
+
+        if(!resolve(event, contact->GetFixtureA(), contact->GetFixtureB()))
+            return;
+
+        if(!sensor){
+            b2WorldManifold manifold;
+            contact->GetWorldManifold(&manifold);
+            int32 count = contact->GetManifold()->pointCount;
+
+            for(int32 i = 0; i < count; i++)
+                event.point += b2_to_vector<float>(manifold.points[i]) / static_cast<float>(count);
+
+            event.normal = b2_to_vector<float>(manifold.normal);
+        }
+
+        events.push_back(event);
+    }
+
+    void B2ContactProxy::EndContact(b2Contact* contact){
+        if(!recording)
+            return;
+
+        ContactEvent event;
+        bool sensor = contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor();
+        event.type = sensor ? ContactEventType::SENSOR_END : ContactEventType::END_CONTACT;
+
+        if(resolve(event, contact->GetFixtureA(), contact->GetFixtureB()))
+            events.push_back(event);
+    }
+
+    void B2ContactProxy::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse){
+        // Never called for sensors
+        if(!recording)
+            return;
+
+        ContactEvent event;
+        event.type = ContactEventType::IMPULSE;
+
+        if(!resolve(event, contact->GetFixtureA(), contact->GetFixtureB()))
+            return;
+
+        b2WorldManifold manifold;
+        contact->GetWorldManifold(&manifold);
+        int32 count = contact->GetManifold()->pointCount;
+
+        for(int32 i = 0; i < count; i++){
+            event.point += b2_to_vector<float>(manifold.points[i]) / static_cast<float>(count);
+            event.normalImpulse += impulse->normalImpulses[i];
+        }
+
+        event.normal = b2_to_vector<float>(manifold.normal);
+        events.push_back(event);
+    }
+};
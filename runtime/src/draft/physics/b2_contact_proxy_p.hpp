@@ -0,0 +1,35 @@
+#pragma once
+
+#include "box2d/b2_world_callbacks.h"
+#include "draft/physics/contact_event.hpp"
+#include "draft/physics/world.hpp"
+
+#include <vector>
+
+class b2Fixture;
+
+namespace Draft {
+    class B2ContactProxy : public b2ContactListener {
+    private:
+        // Variables
+        const World& world;
+        std::vector<ContactEvent>& events;
+
+        // Private functions
+        bool resolve(ContactEvent& event, b2Fixture* fixtureA, b2Fixture* fixtureB) const;
+
+    public:
+        // Box2d also reports contacts ended by destroying a body or fixture, outside of Step().
+        // Those are dropped, an event must never outlive the bodies it points at.
+        bool recording = false;
+
+        // Constructors
+        B2ContactProxy(const World& world, std::vector<ContactEvent>& events);
+        ~B2ContactProxy() = default;
+
+        // Functions
+        virtual void BeginContact(b2Contact* contact) override;
+        virtual void EndContact(b2Contact* contact) override;
+        virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+    };
+};
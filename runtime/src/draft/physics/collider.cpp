@@ -25,52 +25,100 @@ namespace Draft {
         for(auto& shape : other.shapes){
             shapes.push_back(shape->clone());
         }
+
+        localShapes.clear();
     }
 
-    void Collider::set_new_transform(Vector2f newPosition, Vector2f newOrigin, Vector2f newScale, float newRotation){
-        // Move all the points back to the original position
-        Matrix4 worldToLocal = Math::inverse(Optimal::fast_model_matrix(position, rotation, scale, origin, 0));
-        Matrix4 localToNewWorld = Optimal::fast_model_matrix(newPosition, newRotation, newScale, newOrigin, 0);
-        Matrix4 transform = localToNewWorld * worldToLocal;
+    namespace {
+        // The transform fast_model_matrix() builds, as a 2D affine map: rotate and scale, then move
+        // so that @p origin lands on @p position
+        struct Affine2D {
+            Vector2f xAxis, yAxis, translation;
 
-        for(auto& shape : shapes){
-            switch(shape->type){
+            Affine2D(Vector2f position, float rotation, Vector2f scale, Vector2f origin){
+                float c = Math::cos(rotation);
+                float s = Math::sin(rotation);
+
+                xAxis = { scale.x * c, scale.x * s };
+                yAxis = { -scale.y * s, scale.y * c };
+                translation = { position.x - origin.x * c + origin.y * s, position.y - origin.x * s - origin.y * c };
+            }
+
+            Vector2f apply(Vector2f p) const { return xAxis * p.x + yAxis * p.y + translation; }
+
+            Vector2f invert(Vector2f p) const {
+                // Axes are orthogonal, so this is a dot product per axis
+                p -= translation;
+                return { Math::dot(p, xAxis) / Math::dot(xAxis, xAxis), Math::dot(p, yAxis) / Math::dot(yAxis, yAxis) };
+            }
+        };
+
+        // Writes @p from's geometry, mapped through @p map, into @p to. Both are the same type of shape
+        template<typename Map>
+        void map_shape(const Shape& from, Shape& to, Map&& map, float radiusScale){
+            switch(from.type){
                 case ShapeType::POLYGON: {
-                    PolygonShape* polygon = static_cast<PolygonShape*>(shape.get());
+                    auto& source = static_cast<const PolygonShape&>(from);
+                    auto& target = static_cast<PolygonShape&>(to);
 
-                    for(size_t i = 0; i < polygon->get_vertex_count(); i++)
-                        polygon->set_vertex(i, transform * Vector4f(polygon->get_vertex(i), 0, 1));
+                    for(size_t i = 0; i < source.get_vertex_count(); i++)
+                        target.set_vertex(i, map(source.get_vertex(i)));
 
                     break;
                 }
 
                 case ShapeType::CIRCLE: {
-                    CircleShape* circle = static_cast<CircleShape*>(shape.get());
-                    circle->set_position(transform * Vector4f(circle->get_position(), 0, 1));
-                    circle->set_radius(circle->get_radius() / Math::length(scale) * Math::length(newScale));
+                    auto& source = static_cast<const CircleShape&>(from);
+                    auto& target = static_cast<CircleShape&>(to);
+                    target.set_position(map(source.get_position()));
+                    target.set_radius(source.get_radius() * radiusScale);
                     break;
                 }
 
                 case ShapeType::EDGE: {
-                    EdgeShape* edge = static_cast<EdgeShape*>(shape.get());
-                    edge->set_start(transform * Vector4f(edge->get_start(), 0, 1));
-                    edge->set_end(transform * Vector4f(edge->get_end(), 0, 1));
+                    auto& source = static_cast<const EdgeShape&>(from);
+                    static_cast<EdgeShape&>(to).set(map(source.get_start()), map(source.get_end()));
                     break;
                 }
 
                 case ShapeType::CHAIN: {
-                    ChainShape* chain = static_cast<ChainShape*>(shape.get());
-                    auto points = chain->get_points();
-                    chain->clear();
+                    auto& source = static_cast<const ChainShape&>(from);
+                    auto& target = static_cast<ChainShape&>(to);
+                    auto points = source.get_points();
+                    target.clear();
 
-                    for(auto& p : points){
-                        chain->add(transform * Vector4f(p, 0, 1));
-                    }
+                    for(auto& p : points)
+                        target.add(map(p));
 
                     break;
                 }
             }
         }
+    }
+
+    void Collider::cache_local_shapes(){
+        Affine2D current(position, rotation, scale, origin);
+        float radiusScale = 1.f / Math::length(scale);
+
+        localShapes.clear();
+        localShapes.reserve(shapes.size());
+
+        for(auto& shape : shapes){
+            localShapes.push_back(shape->clone());
+            map_shape(*shape, *localShapes.back(), [&](Vector2f p){ return current.invert(p); }, radiusScale);
+        }
+    }
+
+    void Collider::set_new_transform(Vector2f newPosition, Vector2f newOrigin, Vector2f newScale, float newRotation){
+        // Undo the current transform once, every later change maps from the cached local shapes
+        if(localShapes.size() != shapes.size())
+            cache_local_shapes();
+
+        Affine2D transform(newPosition, newRotation, newScale, newOrigin);
+        float radiusScale = Math::length(newScale);
+
+        for(size_t i = 0; i < shapes.size(); i++)
+            map_shape(*localShapes[i], *shapes[i], [&](Vector2f p){ return transform.apply(p); }, radiusScale);
 
         // Save new data
         position = newPosition;
@@ -78,7 +126,8 @@ namespace Draft {
         scale = newScale;
         rotation = newRotation;
 
-        if(is_attached())
+        // Same shapes, same fixtures: their box2d shapes are rewritten rather than recreated
+        if(is_attached() && !rigidBodyPtr->reshape_fixtures(fixtures))
             update_collider();
     }
 
@@ -91,6 +140,7 @@ namespace Draft {
     // entt moving a ColliderComponent during pool compaction)
     void Collider::move_collider(Collider&& other){
         shapes = std::move(other.shapes);
+        localShapes = std::move(other.localShapes);
         position = other.position;
         origin = other.origin;
         scale = other.scale;
@@ -146,6 +196,7 @@ namespace Draft {
     Shape* Collider::add_shape(const Shape& shape){
         // Copy and add shape to this collider
         shapes.push_back(shape.clone());
+        localShapes.clear();
 
         if(is_attached())
             update_collider();
@@ -158,6 +209,7 @@ namespace Draft {
         for(size_t i = 0; i < shapes.size(); i++){
             if(shapes[i].get() == shapePtr){
                 shapes.erase(shapes.begin() + i);
+                localShapes.clear();
                 break;
             }
         }
@@ -169,6 +221,7 @@ namespace Draft {
     void Collider::clear(){
         // Remove every shape
         shapes.clear();
+        localShapes.clear();
 
         if(is_attached())
             update_collider();
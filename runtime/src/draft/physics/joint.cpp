@@ -19,6 +19,39 @@
 #include <memory>
 
 namespace Draft {
+    namespace {
+        // Box2D 2.4 only takes anchors, axes and reference angles from the joint def, but reads
+        // them fresh every step, so rewriting them between steps is as good as recreating the
+        // joint, minus the allocation and the lost warm starting. Deriving from the joint type is
+        // enough to name its protected members through a pointer-to-member.
+        template<typename B2Joint>
+        struct JointFields : B2Joint {
+            static void wake(B2Joint* joint){
+                joint->GetBodyA()->SetAwake(true);
+                joint->GetBodyB()->SetAwake(true);
+            }
+
+            static void set_anchors(B2Joint* joint, const Vector2f& anchorA, const Vector2f& anchorB){
+                joint->*(&JointFields::m_localAnchorA) = vector_to_b2(anchorA);
+                joint->*(&JointFields::m_localAnchorB) = vector_to_b2(anchorB);
+                wake(joint);
+            }
+
+            static void set_axis(B2Joint* joint, const Vector2f& axis){
+                b2Vec2 normalized = vector_to_b2(axis);
+                normalized.Normalize();
+                joint->*(&JointFields::m_localXAxisA) = normalized;
+                joint->*(&JointFields::m_localYAxisA) = b2Cross(1.f, normalized);
+                wake(joint);
+            }
+
+            static void set_reference_angle(B2Joint* joint, float angle){
+                joint->*(&JointFields::m_referenceAngle) = angle;
+                wake(joint);
+            }
+        };
+    }
+
     // Start Base Joint
     // pImpl
     struct Joint::Impl {
@@ -67,6 +100,7 @@ namespace Draft {
     float DistanceJoint::get_stiffness() const { return static_cast<const b2DistanceJoint*>(get_joint_ptr())->GetStiffness(); }
     float DistanceJoint::get_damping() const { return static_cast<const b2DistanceJoint*>(get_joint_ptr())->GetDamping(); }
 
+    void DistanceJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2DistanceJoint>::set_anchors(static_cast<b2DistanceJoint*>(get_joint_ptr()), anchorA, anchorB); }
     void DistanceJoint::set_length(float length){ static_cast<b2DistanceJoint*>(get_joint_ptr())->SetLength(length); }
     void DistanceJoint::set_min_length(float length){ static_cast<b2DistanceJoint*>(get_joint_ptr())->SetMinLength(length); }
     void DistanceJoint::set_max_length(float length){ static_cast<b2DistanceJoint*>(get_joint_ptr())->SetMaxLength(length); }
@@ -83,6 +117,7 @@ namespace Draft {
     float FrictionJoint::get_max_force() const { return static_cast<const b2FrictionJoint*>(get_joint_ptr())->GetMaxForce(); }
     float FrictionJoint::get_max_torque() const { return static_cast<const b2FrictionJoint*>(get_joint_ptr())->GetMaxTorque(); }
 
+    void FrictionJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2FrictionJoint>::set_anchors(static_cast<b2FrictionJoint*>(get_joint_ptr()), anchorA, anchorB); }
     void FrictionJoint::set_max_force(float force){ static_cast<b2FrictionJoint*>(get_joint_ptr())->SetMaxForce(force); }
     void FrictionJoint::set_max_torque(float torque){ static_cast<b2FrictionJoint*>(get_joint_ptr())->SetMaxTorque(torque); }
 
@@ -146,6 +181,9 @@ namespace Draft {
     bool PrismaticJoint::is_limit_enabled() const { return static_cast<const b2PrismaticJoint*>(get_joint_ptr())->IsLimitEnabled(); }
     bool PrismaticJoint::is_motor_enabled() const { return static_cast<const b2PrismaticJoint*>(get_joint_ptr())->IsMotorEnabled(); }
 
+    void PrismaticJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2PrismaticJoint>::set_anchors(static_cast<b2PrismaticJoint*>(get_joint_ptr()), anchorA, anchorB); }
+    void PrismaticJoint::set_local_axis(const Vector2f& axis){ JointFields<b2PrismaticJoint>::set_axis(static_cast<b2PrismaticJoint*>(get_joint_ptr()), axis); }
+    void PrismaticJoint::set_reference_angle(float angle){ JointFields<b2PrismaticJoint>::set_reference_angle(static_cast<b2PrismaticJoint*>(get_joint_ptr()), angle); }
     void PrismaticJoint::set_limits(float lower, float upper){ static_cast<b2PrismaticJoint*>(get_joint_ptr())->SetLimits(lower, upper); }
     void PrismaticJoint::set_motor_speed(float speed){ static_cast<b2PrismaticJoint*>(get_joint_ptr())->SetMotorSpeed(speed); }
     void PrismaticJoint::set_max_motor_force(float force){ static_cast<b2PrismaticJoint*>(get_joint_ptr())->SetMaxMotorForce(force); }
@@ -183,6 +221,8 @@ namespace Draft {
 
     void RevoluteJoint::enable_limit(bool flag){ static_cast<b2RevoluteJoint*>(get_joint_ptr())->EnableLimit(flag); }
     void RevoluteJoint::enable_motor(bool flag){ static_cast<b2RevoluteJoint*>(get_joint_ptr())->EnableMotor(flag); }
+    void RevoluteJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2RevoluteJoint>::set_anchors(static_cast<b2RevoluteJoint*>(get_joint_ptr()), anchorA, anchorB); }
+    void RevoluteJoint::set_reference_angle(float angle){ JointFields<b2RevoluteJoint>::set_reference_angle(static_cast<b2RevoluteJoint*>(get_joint_ptr()), angle); }
     void RevoluteJoint::set_limits(float lower, float upper){ static_cast<b2RevoluteJoint*>(get_joint_ptr())->SetLimits(lower, upper); }
     void RevoluteJoint::set_motor_speed(float speed){ static_cast<b2RevoluteJoint*>(get_joint_ptr())->SetMotorSpeed(speed); }
     void RevoluteJoint::set_max_motor_torque(float torque){ static_cast<b2RevoluteJoint*>(get_joint_ptr())->SetMaxMotorTorque(torque); }
@@ -197,6 +237,8 @@ namespace Draft {
     float WeldJoint::get_stiffness() const { return static_cast<const b2WeldJoint*>(get_joint_ptr())->GetStiffness(); }
     float WeldJoint::get_damping() const { return static_cast<const b2WeldJoint*>(get_joint_ptr())->GetDamping(); }
 
+    void WeldJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2WeldJoint>::set_anchors(static_cast<b2WeldJoint*>(get_joint_ptr()), anchorA, anchorB); }
+    void WeldJoint::set_reference_angle(float angle){ JointFields<b2WeldJoint>::set_reference_angle(static_cast<b2WeldJoint*>(get_joint_ptr()), angle); }
     void WeldJoint::set_stiffness(float hz){ static_cast<b2WeldJoint*>(get_joint_ptr())->SetStiffness(hz); }
     void WeldJoint::set_damping(float damping){ static_cast<b2WeldJoint*>(get_joint_ptr())->SetDamping(damping); }
 
@@ -223,6 +265,8 @@ namespace Draft {
 
     void WheelJoint::enable_limit(bool flag){ static_cast<b2WheelJoint*>(get_joint_ptr())->EnableLimit(flag); }
     void WheelJoint::enable_motor(bool flag){ static_cast<b2WheelJoint*>(get_joint_ptr())->EnableMotor(flag); }
+    void WheelJoint::set_local_anchors(const Vector2f& anchorA, const Vector2f& anchorB){ JointFields<b2WheelJoint>::set_anchors(static_cast<b2WheelJoint*>(get_joint_ptr()), anchorA, anchorB); }
+    void WheelJoint::set_local_axis(const Vector2f& axis){ JointFields<b2WheelJoint>::set_axis(static_cast<b2WheelJoint*>(get_joint_ptr()), axis); }
     void WheelJoint::set_limits(float lower, float upper){ static_cast<b2WheelJoint*>(get_joint_ptr())->SetLimits(lower, upper); }
     void WheelJoint::set_motor_speed(float speed){ static_cast<b2WheelJoint*>(get_joint_ptr())->SetMotorSpeed(speed); }
     void WheelJoint::set_max_motor_torque(float torque){ static_cast<b2WheelJoint*>(get_joint_ptr())->SetMaxMotorTorque(torque); }
@@ -15,6 +15,7 @@
 #include "draft/math/glm.hpp"
 #include "draft/physics/vector2_p.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <unordered_map>
@@ -140,6 +141,56 @@ namespace Draft {
         return fixture;
     }
 
+    bool RigidBody::reshape_fixtures(std::span<Fixture* const> fixtureList){
+        // Chains own a vertex buffer and a broadphase proxy per edge, so only same-sized ones
+        // can be written over
+        for(Fixture* fixture : fixtureList){
+            if(fixture->shapePtr->type != ShapeType::CHAIN)
+                continue;
+
+            // Loops repeat their first point at the end
+            auto* shape = static_cast<const ChainShape*>(fixture->shapePtr);
+            size_t count = shape->get_points().size() + (shape->get_chain_type() == ChainShape::LOOP ? 1 : 0);
+
+            if(count != static_cast<size_t>(static_cast<b2ChainShape*>(((b2Fixture*)fixture->get_fixture_ptr())->GetShape())->m_count))
+                return false;
+        }
+
+        for(Fixture* fixture : fixtureList){
+            b2Shape* shape = ((b2Fixture*)fixture->get_fixture_ptr())->GetShape();
+
+            switch(fixture->shapePtr->type){
+                case ShapeType::POLYGON:
+                    *static_cast<b2PolygonShape*>(shape) = shape_to_b2(*static_cast<const PolygonShape*>(fixture->shapePtr));
+                    break;
+
+                case ShapeType::CIRCLE:
+                    *static_cast<b2CircleShape*>(shape) = shape_to_b2(*static_cast<const CircleShape*>(fixture->shapePtr));
+                    break;
+
+                case ShapeType::EDGE:
+                    *static_cast<b2EdgeShape*>(shape) = shape_to_b2(*static_cast<const EdgeShape*>(fixture->shapePtr));
+                    break;
+
+                case ShapeType::CHAIN: {
+                    // Not assignable, it would share the temporary's buffer
+                    auto* chain = static_cast<b2ChainShape*>(shape);
+                    b2ChainShape fresh = shape_to_b2(*static_cast<const ChainShape*>(fixture->shapePtr));
+                    std::copy(fresh.m_vertices, fresh.m_vertices + fresh.m_count, chain->m_vertices);
+                    chain->m_prevVertex = fresh.m_prevVertex;
+                    chain->m_nextVertex = fresh.m_nextVertex;
+                    break;
+                }
+            }
+        }
+
+        // New mass from the new geometry, and setting the transform to itself moves every
+        // proxy to its new AABB and has the next step look for new contacts
+        ptr->body->ResetMassData();
+        ptr->body->SetTransform(ptr->body->GetPosition(), ptr->body->GetAngle());
+        return true;
+    }
+
     Fixture* RigidBody::get_fixture(void* ptr) const {
         // Converts a b2 fixture pointer to a draft fixture pointer
         if(!ptr)
@@ -163,7 +214,7 @@ namespace Draft {
             // Find the pointer responsible
             if(ptr.get() == fixturePtr){
                 // This is the one, erase it. This also handles deletion because of unique_ptr
-                this->ptr->b2ToFixturePtrs[fixturePtr->get_fixture_ptr()] = nullptr;
+                this->ptr->b2ToFixturePtrs.erase(fixturePtr->get_fixture_ptr());
                 fixtures.erase(fixtures.begin() + i);
                 break;
             }
@@ -1,8 +1,12 @@
 #include "box2d/b2_body.h"
+#include "box2d/b2_collision.h"
+#include "box2d/b2_distance.h"
+#include "box2d/b2_fixture.h"
 #include "box2d/b2_joint.h"
 #include "box2d/b2_world.h"
 
 #include "draft/physics/vector2_p.hpp"
+#include "draft/physics/b2_contact_proxy_p.hpp"
 #include "draft/physics/b2_raycast_proxy_p.hpp"
 #include "draft/physics/conversions_p.hpp"
 #include "draft/physics/world.hpp"
@@ -11,24 +15,154 @@
 #include "draft/physics/rigid_body.hpp"
 #include "draft/rendering/phys_renderer_p.hpp"
 #include "draft/rendering/pipeline/renderer.hpp"
+#include "draft/util/thread_pool.hpp"
 #include "glm/ext/matrix_transform.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <stdexcept>
-#include <unordered_map>
 
 namespace Draft {
+    namespace {
+        // Queries handed to each parallel_for() index, so one task isn't a single raycast
+        constexpr size_t QUERY_CHUNK = 64;
+
+        bool passes(const b2Fixture* fixture, const QueryFilter& filter){
+            if(fixture->IsSensor() && !filter.includeSensors)
+                return false;
+
+            return (fixture->GetFilterData().categoryBits & filter.maskBits) != 0;
+        }
+
+        Fixture* to_fixture(const World& world, b2Fixture* fixture){
+            return world.get_body(fixture->GetBody())->get_fixture(fixture);
+        }
+
+        // Keeps only the closest hit, unlike B2RaycastProxy which hands every one to a callback
+        class ClosestRayCallback : public b2RayCastCallback {
+        public:
+            const QueryFilter& filter;
+            b2Fixture* fixture = nullptr;
+            b2Vec2 point{0.f, 0.f};
+            b2Vec2 normal{0.f, 0.f};
+            float fraction = 1.f;
+
+            ClosestRayCallback(const QueryFilter& filter) : filter(filter) {}
+
+            float ReportFixture(b2Fixture* hit, const b2Vec2& hitPoint, const b2Vec2& hitNormal, float hitFraction) override {
+                if(!passes(hit, filter))
+                    return -1.f;
+
+                fixture = hit;
+                point = hitPoint;
+                normal = hitNormal;
+                fraction = hitFraction;
+                return hitFraction;
+            }
+        };
+
+        // Narrows the broadphase's AABB matches down to fixtures actually overlapping the box
+        class OverlapCallback : public b2QueryCallback {
+        public:
+            const World& world;
+            const QueryFilter& filter;
+            const b2PolygonShape& box;
+            std::span<Fixture*> results;
+            size_t count = 0;
+
+            OverlapCallback(const World& world, const QueryFilter& filter, const b2PolygonShape& box, std::span<Fixture*> results)
+                : world(world), filter(filter), box(box), results(results) {}
+
+            bool ReportFixture(b2Fixture* fixture) override {
+                if(!passes(fixture, filter))
+                    return true;
+
+                const b2Shape* shape = fixture->GetShape();
+                const b2Transform& transform = fixture->GetBody()->GetTransform();
+
+                for(int32 child = 0; child < shape->GetChildCount(); child++){
+                    if(b2TestOverlap(shape, child, &box, 0, transform, b2Transform(b2Vec2_zero, b2Rot(0.f)))){
+                        if(count < results.size())
+                            results[count] = to_fixture(world, fixture);
+
+                        count++;
+                        break;
+                    }
+                }
+
+                return true;
+            }
+        };
+
+        // Runs the swept shape against every fixture the broadphase finds along the sweep
+        class ShapeCastCallback : public b2QueryCallback {
+        public:
+            const QueryFilter& filter;
+            b2ShapeCastInput input{};
+            b2Fixture* fixture = nullptr;
+            b2ShapeCastOutput output{};
+
+            ShapeCastCallback(const QueryFilter& filter) : filter(filter) {
+                output.lambda = 1.f;
+            }
+
+            bool ReportFixture(b2Fixture* candidate) override {
+                if(!passes(candidate, filter))
+                    return true;
+
+                const b2Shape* shape = candidate->GetShape();
+                input.transformA = candidate->GetBody()->GetTransform();
+
+                for(int32 child = 0; child < shape->GetChildCount(); child++){
+                    input.proxyA.Set(shape, child);
+
+                    b2ShapeCastOutput result;
+                    if(b2ShapeCast(&result, &input) && result.lambda < output.lambda){
+                        fixture = candidate;
+                        output = result;
+                    }
+                }
+
+                return true;
+            }
+        };
+
+        // Calls fn(i) for every query, in chunks across the pool if there is one
+        template<typename Fn>
+        void run_queries(size_t count, ThreadPool* pool, Fn&& fn){
+            if(!pool){
+                for(size_t i = 0; i < count; i++)
+                    fn(i);
+
+                return;
+            }
+
+            pool->parallel_for((count + QUERY_CHUNK - 1) / QUERY_CHUNK, [&](size_t chunk){
+                size_t end = std::min(count, (chunk + 1) * QUERY_CHUNK);
+
+                for(size_t i = chunk * QUERY_CHUNK; i < end; i++)
+                    fn(i);
+            });
+        }
+    }
+
     // pImpl
     struct World::Impl {
         b2World world = b2World({0, 0});
-        std::unordered_map<void*, RigidBody*> b2ToBodyPtrs;
         std::unique_ptr<PhysicsDebugRender> physRenderer;
+
+        // Refilled by every step(), never shrunk
+        std::vector<ContactEvent> contactEvents;
+        B2ContactProxy contactProxy;
+
+        Impl(const World& owner) : contactProxy(owner, contactEvents) {}
     };
 
     // Constructors
-    World::World(const Vector2f& gravity) : ptr(std::make_unique<Impl>()) {
+    World::World(const Vector2f& gravity) : ptr(std::make_unique<Impl>(*this)) {
         ptr->world.SetGravity(vector_to_b2(gravity));
+        ptr->world.SetContactListener(&ptr->contactProxy);
     }
 
     World::~World(){}
@@ -40,9 +174,25 @@ namespace Draft {
 
         b2BodyDef tmp = bodydef_to_b2(cpy);
         b2Body* body = ptr->world.CreateBody(&tmp);
-        rigidBodies.push_back(std::unique_ptr<RigidBody>(new RigidBody(this, body)));
-        ptr->b2ToBodyPtrs[body] = rigidBodies.back().get();
-        return rigidBodies.back().get();
+
+        // Reuse a free slot if there is one
+        uint32_t index;
+        if(freeBodySlots.empty()){
+            index = static_cast<uint32_t>(bodySlots.size());
+            bodySlots.emplace_back();
+        } else {
+            index = freeBodySlots.back();
+            freeBodySlots.pop_back();
+        }
+
+        BodySlot& slot = bodySlots[index];
+        slot.body = std::unique_ptr<RigidBody>(new RigidBody(this, body));
+        slot.body->handle = BodyHandle{index, slot.generation};
+        bodyCount++;
+
+        // Lets get_body() go straight from the b2 body back to this one
+        body->GetUserData().pointer = reinterpret_cast<uintptr_t>(slot.body.get());
+        return slot.body.get();
     }
 
     RigidBody* World::get_body(void* ptr) const {
@@ -50,29 +200,39 @@ namespace Draft {
         if(!ptr)
             return nullptr;
 
-        auto iter = this->ptr->b2ToBodyPtrs.find(ptr);
-        return iter != this->ptr->b2ToBodyPtrs.end() ? iter->second : nullptr;
+        return reinterpret_cast<RigidBody*>(static_cast<b2Body*>(ptr)->GetUserData().pointer);
+    }
+
+    RigidBody* World::get_body(BodyHandle handle) const {
+        if(handle.index >= bodySlots.size())
+            return nullptr;
+
+        const BodySlot& slot = bodySlots[handle.index];
+        return slot.generation == handle.generation ? slot.body.get() : nullptr;
     }
 
     void World::destroy_body(RigidBody* rigidBodyPtr){
         assert(rigidBodyPtr && "rigidBodyPtr cannot be null");
+        assert(get_body(rigidBodyPtr->handle) == rigidBodyPtr && "rigidBodyPtr doesn't belong to this world");
         ptr->world.DestroyBody((b2Body*)rigidBodyPtr->get_body_ptr());
 
-        for(size_t i = 0; i < rigidBodies.size(); i++){
-            auto& ptr = rigidBodies[i];
+        // Free the slot, this also handles deletion because of unique_ptr. Bumping the
+        // generation invalidates every handle still pointing here
+        uint32_t index = rigidBodyPtr->handle.index;
+        BodySlot& slot = bodySlots[index];
+        slot.body.reset();
+        slot.generation++;
+        freeBodySlots.push_back(index);
+        bodyCount--;
+    }
 
-            // Find the pointer responsible
-            if(ptr.get() == rigidBodyPtr){
-                // This is the one, erase it. This also handles deletion because of unique_ptr
-                this->ptr->b2ToBodyPtrs[rigidBodyPtr] = nullptr;
-                rigidBodies.erase(rigidBodies.begin() + i);
-                break;
-            }
-        }
+    void World::destroy_body(BodyHandle handle){
+        if(RigidBody* body = get_body(handle))
+            destroy_body(body);
     }
 
     size_t World::get_body_count() const {
-        return rigidBodies.size();
+        return bodyCount;
     }
 
     Joint* World::create_joint(const JointDef& def){
@@ -193,8 +353,19 @@ namespace Draft {
         offsetShift += shift;
     }
 
+    void World::rebase_origin(const Vector2f& shift){
+        ptr->world.ShiftOrigin(vector_to_b2(shift));
+    }
+
     void World::step(Time timeStep, int32_t velocityIterations, int32_t positionIterations){
+        ptr->contactEvents.clear();
+        ptr->contactProxy.recording = true;
         ptr->world.Step(timeStep.as_seconds(), velocityIterations, positionIterations);
+        ptr->contactProxy.recording = false;
+    }
+
+    std::span<const ContactEvent> World::get_contact_events() const {
+        return ptr->contactEvents;
     }
 
     void World::raycast(RaycastCallback callback, const Vector2f& point1, const Vector2f& point2) const {
@@ -208,10 +379,13 @@ namespace Draft {
     }
 
     RigidBody* World::test_point(const Vector2f& position) const {
-        for(const auto& body : rigidBodies){
-            for(const auto& fixture : body->get_fixture_list()){
+        for(const auto& slot : bodySlots){
+            if(!slot.body)
+                continue;
+
+            for(const auto& fixture : slot.body->get_fixture_list()){
                 if(fixture->test_point(position)){
-                    return body.get();
+                    return slot.body.get();
                 }
             }
         }
@@ -219,6 +393,107 @@ namespace Draft {
         return nullptr;
     }
 
+    void World::raycast_batch(std::span<const RayQuery> rays, std::span<QueryHit> hits, const QueryFilter& filter, ThreadPool* pool) const {
+        if(hits.size() != rays.size())
+            throw std::invalid_argument("World::raycast_batch(): hits must be as long as rays");
+
+        Vector2f shift = static_cast<Vector2f>(offsetShift);
+
+        run_queries(rays.size(), pool, [&](size_t i){
+            ClosestRayCallback callback(filter);
+            ptr->world.RayCast(&callback, vector_to_b2(rays[i].start - shift), vector_to_b2(rays[i].end - shift));
+
+            QueryHit& hit = hits[i];
+            hit = QueryHit{};
+
+            if(callback.fixture){
+                hit.fixture = to_fixture(*this, callback.fixture);
+                hit.point = b2_to_vector<float>(callback.point) + shift;
+                hit.normal = b2_to_vector<float>(callback.normal);
+                hit.fraction = callback.fraction;
+            }
+        });
+    }
+
+    void World::overlap_batch(std::span<const FloatRect> boxes, std::span<Fixture*> results, std::span<size_t> counts, const QueryFilter& filter, ThreadPool* pool) const {
+        if(counts.size() != boxes.size())
+            throw std::invalid_argument("World::overlap_batch(): counts must be as long as boxes");
+
+        if(boxes.empty())
+            return;
+
+        Vector2f shift = static_cast<Vector2f>(offsetShift);
+        size_t capacity = results.size() / boxes.size();
+
+        run_queries(boxes.size(), pool, [&](size_t i){
+            const FloatRect& rect = boxes[i];
+            b2Vec2 lower = vector_to_b2(Vector2f(rect.x, rect.y) - shift);
+            b2Vec2 upper = lower + b2Vec2(rect.width, rect.height);
+
+            b2PolygonShape box;
+            box.SetAsBox(rect.width * 0.5f, rect.height * 0.5f, 0.5f * (lower + upper), 0.f);
+
+            OverlapCallback callback(*this, filter, box, results.subspan(i * capacity, capacity));
+            ptr->world.QueryAABB(&callback, b2AABB{lower, upper});
+            counts[i] = callback.count;
+        });
+    }
+
+    void World::shape_cast_batch(std::span<const ShapeCastQuery> casts, std::span<QueryHit> hits, const QueryFilter& filter, ThreadPool* pool) const {
+        if(hits.size() != casts.size())
+            throw std::invalid_argument("World::shape_cast_batch(): hits must be as long as casts");
+
+        // Checked up front, rather than on whichever worker gets to it
+        for(const ShapeCastQuery& cast : casts){
+            if(!cast.shape || (cast.shape->type != ShapeType::CIRCLE && cast.shape->type != ShapeType::POLYGON))
+                throw std::invalid_argument("World::shape_cast_batch(): every cast needs a circle or polygon shape");
+        }
+
+        Vector2f shift = static_cast<Vector2f>(offsetShift);
+
+        run_queries(casts.size(), pool, [&](size_t i){
+            const ShapeCastQuery& cast = casts[i];
+
+            // Proxies point into the shape, so both have to outlive the query
+            b2CircleShape circle;
+            b2PolygonShape polygon;
+            const b2Shape* shape = nullptr;
+
+            if(cast.shape->type == ShapeType::CIRCLE){
+                circle = shape_to_b2(static_cast<const CircleShape&>(*cast.shape));
+                shape = &circle;
+            } else {
+                polygon = shape_to_b2(static_cast<const PolygonShape&>(*cast.shape));
+                shape = &polygon;
+            }
+
+            ShapeCastCallback callback(filter);
+            callback.input.proxyB.Set(shape, 0);
+            callback.input.transformB = transform_to_b2(cast.position - shift, cast.rotation);
+            callback.input.translationB = vector_to_b2(cast.translation);
+
+            // Everything the shape could touch on its way
+            b2AABB start, end;
+            shape->ComputeAABB(&start, callback.input.transformB, 0);
+            end.lowerBound = start.lowerBound + callback.input.translationB;
+            end.upperBound = start.upperBound + callback.input.translationB;
+
+            b2AABB swept;
+            swept.Combine(start, end);
+            ptr->world.QueryAABB(&callback, swept);
+
+            QueryHit& hit = hits[i];
+            hit = QueryHit{};
+
+            if(callback.fixture){
+                hit.fixture = to_fixture(*this, callback.fixture);
+                hit.point = b2_to_vector<float>(callback.output.point) + shift;
+                hit.normal = b2_to_vector<float>(callback.output.normal);
+                hit.fraction = callback.output.lambda;
+            }
+        });
+    }
+
     void World::set_debug_renderer(){
         ptr->physRenderer.reset();
         ptr->physRenderer = std::unique_ptr<PhysicsDebugRender>(new PhysicsDebugRender());
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <filesystem>
 #include <stdexcept>
+#include <string>
 
 namespace Draft {
     namespace {
@@ -96,7 +97,8 @@ namespace Draft {
                     tag.color = Color(entry["color"].get<std::string>());
 
                 build_tag_playback(tag);
-                tags.emplace(tag.name, std::move(tag));
+                StringId id = StringId::intern(tag.name);
+                tags.emplace(id, std::move(tag));
             }
         }
 
@@ -194,6 +196,12 @@ namespace Draft {
         }
     }
 
+    const AnimationTag* Animation::find_tag(const std::string& name) const {
+        // The name is checked too, in case @p name isn't a tag but shares an id with one that is
+        auto it = tags.find(StringId(name));
+        return it != tags.end() && it->second.name == name ? &it->second : nullptr;
+    }
+
     TextureRegion Animation::make_region(size_t frameIndex) const {
         const AnimationFrame& frame = frames[frameIndex];
         float textureHeight = texture->get_properties().size.y;
@@ -230,13 +238,20 @@ namespace Draft {
     }
 
     TextureRegion Animation::get_frame(const std::string& tagName, float frameTime) const {
-        auto it = tags.find(tagName);
-        if(it == tags.end())
+        if(!find_tag(tagName))
             throw std::runtime_error("Animation::get_frame(): unknown tag \"" + tagName + "\"");
 
+        return get_frame(StringId(tagName), frameTime);
+    }
+
+    TextureRegion Animation::get_frame(StringId tagId, float frameTime) const {
+        auto it = tags.find(tagId);
+        if(it == tags.end())
+            throw std::runtime_error("Animation::get_frame(): unknown tag id " + std::to_string(tagId.value()));
+
         const AnimationTag& tag = it->second;
         if(tag.playbackFrames.empty())
-            throw std::runtime_error("Animation::get_frame(): tag \"" + tagName + "\" has no frames");
+            throw std::runtime_error("Animation::get_frame(): tag \"" + tag.name + "\" has no frames");
 
         if(tag.totalPlaybackTime > 0.f)
             frameTime = fmodf(frameTime, tag.totalPlaybackTime);
@@ -251,10 +266,18 @@ namespace Draft {
     }
 
     const AnimationTag& Animation::get_tag(const std::string& name) const {
-        auto it = tags.find(name);
-        if(it == tags.end())
+        const AnimationTag* tag = find_tag(name);
+        if(!tag)
             throw std::runtime_error("Animation::get_tag(): unknown tag \"" + name + "\"");
 
+        return *tag;
+    }
+
+    const AnimationTag& Animation::get_tag(StringId tagId) const {
+        auto it = tags.find(tagId);
+        if(it == tags.end())
+            throw std::runtime_error("Animation::get_tag(): unknown tag id " + std::to_string(tagId.value()));
+
         return it->second;
     }
 }
@@ -1,67 +1,120 @@
 #include "draft/rendering/mesh.hpp"
 #include "glad/gl.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <utility>
 
 namespace Draft {
+    // Mesh indices
+    MeshIndices::MeshIndices(std::vector<std::uint16_t> indexArray) : shortIndices(std::move(indexArray)) {}
+
+    MeshIndices::MeshIndices(std::vector<std::uint32_t> indexArray){
+        const bool fitsShort = std::all_of(indexArray.begin(), indexArray.end(), [](std::uint32_t i){ return i <= 0xFFFF; });
+
+        if(fitsShort){
+            shortIndices.assign(indexArray.begin(), indexArray.end());
+        } else {
+            longIndices = std::move(indexArray);
+        }
+    }
+
+    int MeshIndices::gl_type() const {
+        return is_short() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
+    // Private functions
+    void Mesh::interleave(const std::vector<Vector3f>& vertexArray, const std::vector<Vector2f>* uvArray, const std::vector<Vector3f>* colorArray){
+        vertices.resize(vertexArray.size());
+
+        for(size_t i = 0; i < vertexArray.size(); i++){
+            MeshVertex& vertex = vertices[i];
+            vertex.position = vertexArray[i];
+
+            if(uvArray && i < uvArray->size())
+                vertex.texCoord = (*uvArray)[i];
+
+            if(colorArray && i < colorArray->size())
+                vertex.color = (*colorArray)[i];
+        }
+    }
+
+    void Mesh::set_indices(const std::vector<int>& indexArray){
+        indices = MeshIndices(std::vector<std::uint32_t>(indexArray.begin(), indexArray.end()));
+    }
+
     // Constructors
     Mesh::Mesh(){}
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray) : indexedMesh(false), uvMapped(false), colorMapped(false) { // Raw mesh constructor
-        vertices = vertexArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray) : uvMapped(false), indexedMesh(false), colorMapped(false) { // Raw mesh constructor
+        interleave(vertexArray, nullptr, nullptr);
+    }
+
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray) : uvMapped(false), indexedMesh(true), colorMapped(false) { // Indexed mesh
+        interleave(vertexArray, nullptr, nullptr);
+        set_indices(indexArray);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray) : indexedMesh(true), uvMapped(false), colorMapped(false) { // Indexed mesh
-        vertices = vertexArray;
-        indices = indexArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<Vector2f>& uvArray) : uvMapped(true), indexedMesh(false), colorMapped(false) { // Unindexed uv-mapped mesh
+        interleave(vertexArray, &uvArray, nullptr);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<Vector2f>& uvArray) : indexedMesh(false), uvMapped(true), colorMapped(false) { // Unindexed uv-mapped mesh
-        vertices = vertexArray;
-        texCoords = uvArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector2f>& uvArray) : uvMapped(true), indexedMesh(true), colorMapped(false) { // Indexed uv-mapped mesh
+        interleave(vertexArray, &uvArray, nullptr);
+        set_indices(indexArray);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector2f>& uvArray) : indexedMesh(true), uvMapped(true), colorMapped(false) { // Indexed uv-mapped mesh
-        vertices = vertexArray;
-        indices = indexArray;
-        texCoords = uvArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<Vector3f>& colorArray) : uvMapped(false), indexedMesh(false), colorMapped(true) { // Unindexed color-mapped mesh
+        interleave(vertexArray, nullptr, &colorArray);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<Vector3f>& colorArray) : indexedMesh(false), uvMapped(false), colorMapped(true) { // Unindexed color-mapped mesh
-        vertices = vertexArray;
-        colors = colorArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector3f>& colorArray) : uvMapped(false), indexedMesh(true), colorMapped(true) { // Indexed color-mapped mesh
+        interleave(vertexArray, nullptr, &colorArray);
+        set_indices(indexArray);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector3f>& colorArray) : indexedMesh(true), uvMapped(false), colorMapped(true) { // Indexed color-mapped mesh
-        vertices = vertexArray;
-        indices = indexArray;
-        colors = colorArray;
+    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector2f>& uvArray, const std::vector<Vector3f>& colorArray) : uvMapped(true), indexedMesh(true), colorMapped(true) { // Indexed uv-mapped color-mapped mesh
+        interleave(vertexArray, &uvArray, &colorArray);
+        set_indices(indexArray);
     }
 
-    Mesh::Mesh(const std::vector<Vector3f>& vertexArray, const std::vector<int>& indexArray, const std::vector<Vector2f>& uvArray, const std::vector<Vector3f>& colorArray) : indexedMesh(true), uvMapped(true), colorMapped(true) { // Indexed uv-mapped color-mapped mesh
-        vertices = vertexArray;
-        indices = indexArray;
-        texCoords = uvArray;
-        colors = colorArray;
+    Mesh::Mesh(std::vector<MeshVertex> vertexArray, MeshIndices indexArray, bool uvMapped, bool colorMapped)
+        : vertices(std::move(vertexArray)), indices(std::move(indexArray)), uvMapped(uvMapped), indexedMesh(!indices.empty()), colorMapped(colorMapped) {
     }
 
     // Functions
-    const std::vector<Vector3f>& Mesh::get_vertices() const {
+    const std::vector<MeshVertex>& Mesh::get_vertex_data() const {
         return vertices;
     }
 
-    const std::vector<int>& Mesh::get_indices() const {
+    const MeshIndices& Mesh::get_indices() const {
         assert(is_indexed() && "Mesh cannot be indexed");
         return indices;
     }
 
-    const std::vector<Vector2f>& Mesh::get_tex_coords() const {
+    std::vector<Vector3f> Mesh::get_vertices() const {
+        std::vector<Vector3f> positions(vertices.size());
+        for(size_t i = 0; i < vertices.size(); i++)
+            positions[i] = vertices[i].position;
+        return positions;
+    }
+
+    std::vector<Vector2f> Mesh::get_tex_coords() const {
         assert(is_uv_mapped() && "Mesh is not UV-mapped");
+
+        std::vector<Vector2f> texCoords(vertices.size());
+        for(size_t i = 0; i < vertices.size(); i++)
+            texCoords[i] = vertices[i].texCoord;
         return texCoords;
     }
 
-    const std::vector<Vector3f>& Mesh::get_colors() const {
+    std::vector<Vector3f> Mesh::get_colors() const {
         assert(is_color_mapped() && "Mesh is not color-mapped");
+
+        std::vector<Vector3f> colors(vertices.size());
+        for(size_t i = 0; i < vertices.size(); i++)
+            colors[i] = vertices[i].color;
         return colors;
     }
 
@@ -86,13 +139,15 @@ namespace Draft {
     }
 
     void DrawableMesh::generate_vertex_array(){
-        // Positions (0), uv (1), colors (2) always exist as attributes
-        auto& vertices = mesh.get_vertices();
+        // Positions (0), uv (1), colors (2) always exist as attributes, all interleaved in one buffer
+        constexpr unsigned long stride = sizeof(MeshVertex);
 
         std::vector<std::variant<StaticBuffer, DynamicBuffer>> buffers{
-            StaticBuffer({{0, GL_FLOAT, 3, sizeof(Vector3f), 0}}),
-            StaticBuffer({{1, GL_FLOAT, 2, sizeof(Vector2f), 0}}),
-            StaticBuffer({{2, GL_FLOAT, 3, sizeof(Vector3f), 0}}),
+            StaticBuffer({
+                {0, GL_FLOAT, 3, stride, offsetof(MeshVertex, position)},
+                {1, GL_FLOAT, 2, stride, offsetof(MeshVertex, texCoord)},
+                {2, GL_FLOAT, 3, stride, offsetof(MeshVertex, color)},
+            }),
         };
 
         if(mesh.is_indexed()){
@@ -100,24 +155,16 @@ namespace Draft {
         }
 
         vao.create(buffers);
-        vao.set_data(0, vertices);
-
-        if(mesh.is_uv_mapped()){
-            vao.set_data(1, mesh.get_tex_coords());
-        } else {
-            std::vector<Vector2f> tempUV(vertices.size(), Vector2f{0, 0});
-            vao.set_data(1, tempUV);
-        }
-
-        if(mesh.is_color_mapped()){
-            vao.set_data(2, mesh.get_colors());
-        } else {
-            std::vector<Vector3f> tempColors(vertices.size(), Vector3f{1, 1, 1});
-            vao.set_data(2, tempColors);
-        }
+        vao.set_data(0, mesh.get_vertex_data());
 
         if(mesh.is_indexed()){
-            vao.set_data(3, mesh.get_indices());
+            const MeshIndices& indices = mesh.get_indices();
+
+            if(indices.is_short()){
+                vao.set_data(1, indices.get_short());
+            } else {
+                vao.set_data(1, indices.get_long());
+            }
         }
     }
 
@@ -129,9 +176,10 @@ namespace Draft {
         vao.bind();
 
         if(mesh.is_indexed()){
-            glDrawElements(GL_TRIANGLES, mesh.get_indices().size(), GL_UNSIGNED_INT, 0);
+            const MeshIndices& indices = mesh.get_indices();
+            glDrawElements(GL_TRIANGLES, indices.size(), indices.gl_type(), 0);
         } else {
-            glDrawArrays(GL_TRIANGLES, 0, mesh.get_vertices().size());
+            glDrawArrays(GL_TRIANGLES, 0, mesh.get_vertex_data().size());
         }
 
         vao.unbind();
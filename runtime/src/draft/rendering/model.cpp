@@ -15,11 +15,26 @@
 #include "draft/util/logger.hpp"
 #include "glad/gl.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <functional>
 #include <stdexcept>
 #include <vector>
 
+namespace {
+    // Distance between consecutive elements of an accessor, honouring an interleaved source
+    // buffer view's byteStride instead of assuming the attribute is tightly packed
+    size_t attribute_stride(const tinygltf::Accessor& accessor, const tinygltf::BufferView& bufferView){
+        const int stride = accessor.ByteStride(bufferView);
+        if(stride <= 0)
+            throw std::runtime_error("Model: accessor has an invalid byte stride");
+
+        return static_cast<size_t>(stride);
+    }
+}
+
 namespace Draft {
     // TODO: Implement FileHandle stuff so it can load embedded and packed data
     tinygltf::Model Model::load_raw_model(const FileHandle& handle){
@@ -45,33 +60,35 @@ namespace Draft {
         return mdl;
     }
 
-    void Model::load_materials(const FileHandle& handle, std::vector<Material3D>& materials, std::vector<std::shared_ptr<Texture>>& embeddedTextures, const tinygltf::Model& mdl){
+    void Model::load_materials(const FileHandle& handle, std::vector<ModelData::MaterialData>& materials, std::vector<Image>& images, const tinygltf::Model& mdl){
         // See load_raw_model() for why this uses std::filesystem::path::parent_path() directly
         // rather than FileHandle::parent() (which throws on an empty parent path).
         const std::filesystem::path basePath = std::filesystem::path(handle.get_path()).parent_path();
 
-        auto load_texture = [&](int index) -> Texture* {
-            if(index == -1) return nullptr;
+        auto load_image = [&](int index) -> int {
+            if(index == -1) return -1;
 
             const auto& texData = mdl.textures[index];
             const auto& img = mdl.images[texData.source];
 
             if(img.uri.empty()){
                 // Embedded (already decoded by tinygltf's own stb_image usage)
-                Image image({(unsigned)img.width, (unsigned)img.height}, channels_to_color_format(img.component), reinterpret_cast<const std::byte*>(img.image.data()));
-                embeddedTextures.push_back(std::make_shared<Texture>(image));
+                images.emplace_back(Vector2u{(unsigned)img.width, (unsigned)img.height}, channels_to_color_format(img.component), reinterpret_cast<const std::byte*>(img.image.data()));
             } else {
-                // External file, resolved relative to the model's own directory
+                // External file, resolved relative to the model's own directory, flipped the
+                // same way Texture(FileHandle) would
                 FileHandle imageHandle = HostFileSystem().open((basePath / img.uri).string());
-                embeddedTextures.push_back(std::make_shared<Texture>(imageHandle));
+                images.emplace_back(imageHandle);
+                images.back().flip_vertically();
             }
 
-            return embeddedTextures.back().get();
+            return (int)images.size() - 1;
         };
 
         for(const auto& mat : mdl.materials){
-            materials.push_back(Material3D{ mat.name });
-            Material3D& material = materials.back();
+            materials.push_back(ModelData::MaterialData{ Material3D{ mat.name } });
+            ModelData::MaterialData& data = materials.back();
+            Material3D& material = data.material;
 
             material.baseColor = { mat.pbrMetallicRoughness.baseColorFactor[0], mat.pbrMetallicRoughness.baseColorFactor[1], mat.pbrMetallicRoughness.baseColorFactor[2], mat.pbrMetallicRoughness.baseColorFactor[3] };
             material.emissiveFactor = { mat.emissiveFactor[0], mat.emissiveFactor[1], mat.emissiveFactor[2] };
@@ -80,56 +97,51 @@ namespace Draft {
             material.normalScale = mat.normalTexture.scale;
             material.occlusionStrength = mat.occlusionTexture.strength;
 
-            material.baseTexture = load_texture(mat.pbrMetallicRoughness.baseColorTexture.index);
-            material.normalTexture = load_texture(mat.normalTexture.index);
-            material.emissiveTexture = load_texture(mat.emissiveTexture.index);
-            material.occlusionTexture = load_texture(mat.occlusionTexture.index);
-            material.roughnessTexture = load_texture(mat.pbrMetallicRoughness.metallicRoughnessTexture.index);
+            data.baseTexture = load_image(mat.pbrMetallicRoughness.baseColorTexture.index);
+            data.normalTexture = load_image(mat.normalTexture.index);
+            data.emissiveTexture = load_image(mat.emissiveTexture.index);
+            data.occlusionTexture = load_image(mat.occlusionTexture.index);
+            data.roughnessTexture = load_image(mat.pbrMetallicRoughness.metallicRoughnessTexture.index);
         }
 
         // Dummy fallback material for primitives with primitive.material == -1
-        materials.push_back(Material3D{ "missing_material_draft" });
+        materials.push_back(ModelData::MaterialData{ Material3D{ "missing_material_draft" } });
     }
 
     // Reads N unsigned indices of the accessor's real component type (glTF indices are always
     // unsigned byte, short, or int), instead of assuming unsigned short regardless of what the
-    // file actually declares.
-    std::vector<int> Model::read_indices(const unsigned char* data, int componentType, size_t count){
-        std::vector<int> indices;
-        indices.reserve(count);
-
+    // file actually declares. Only int indices are kept 32 bits wide.
+    MeshIndices Model::read_indices(const unsigned char* data, int componentType, size_t count){
         switch(componentType){
             case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
-                for(size_t i = 0; i < count; i++) indices.push_back(data[i]);
-                break;
+                return MeshIndices(std::vector<std::uint16_t>(data, data + count));
             }
             case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
-                const unsigned short* arr = reinterpret_cast<const unsigned short*>(data);
-                for(size_t i = 0; i < count; i++) indices.push_back(arr[i]);
-                break;
+                std::vector<std::uint16_t> indices(count);
+                std::memcpy(indices.data(), data, count * sizeof(std::uint16_t));
+                return MeshIndices(std::move(indices));
             }
             case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
-                const unsigned int* arr = reinterpret_cast<const unsigned int*>(data);
-                for(size_t i = 0; i < count; i++) indices.push_back((int)arr[i]);
-                break;
+                std::vector<std::uint32_t> indices(count);
+                std::memcpy(indices.data(), data, count * sizeof(std::uint32_t));
+                return MeshIndices(std::move(indices));
             }
             default:
                 throw std::runtime_error("Model: index accessor has an unsupported component type");
         }
-
-        return indices;
     }
 
-    // Flattens every primitive of every glTF mesh into one entry each in meshes
+    // Flattens every primitive of every glTF mesh into one entry each in meshes, converting
+    // straight into the interleaved layout DrawableMesh uploads
     void Model::load_meshes(std::vector<Mesh>& meshes, std::vector<int>& meshToMaterialMap, std::vector<Matrix4>& meshToMatrixMap, std::vector<std::pair<size_t, size_t>>& meshPrimitiveRanges, const tinygltf::Model& mdl){
-        std::vector<Vector3f> vertices;
-        std::vector<Vector2f> texCoord;
-        std::vector<int> indices;
-
         for(const auto& mesh : mdl.meshes){
             const size_t rangeStart = meshes.size();
 
             for(const auto& primitive : mesh.primitives){
+                std::vector<MeshVertex> vertices;
+                MeshIndices indices;
+                bool uvMapped = false;
+
                 {
                     auto it = primitive.attributes.find("POSITION");
                     if(it == primitive.attributes.end())
@@ -138,10 +150,14 @@ namespace Draft {
                     const auto& accessor = mdl.accessors[it->second];
                     const auto& bufferView = mdl.bufferViews[accessor.bufferView];
                     const auto& buffer = mdl.buffers[bufferView.buffer];
-                    const float* positions = reinterpret_cast<const float*>(&buffer.data[bufferView.byteOffset + accessor.byteOffset]);
+                    const unsigned char* base = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
+                    const size_t stride = attribute_stride(accessor, bufferView);
 
-                    for(size_t i = 0; i < accessor.count; i++)
-                        vertices.push_back({ positions[i * 3 + 0], positions[i * 3 + 1], positions[i * 3 + 2] });
+                    vertices.resize(accessor.count);
+                    for(size_t i = 0; i < accessor.count; i++){
+                        const float* position = reinterpret_cast<const float*>(base + i * stride);
+                        vertices[i].position = { position[0], position[1], position[2] };
+                    }
                 }
 
                 // TEXCOORD_0 is optional per the glTF spec, a primitive may have no UVs
@@ -150,10 +166,16 @@ namespace Draft {
                     const auto& accessor = mdl.accessors[texCoordIt->second];
                     const auto& bufferView = mdl.bufferViews[accessor.bufferView];
                     const auto& buffer = mdl.buffers[bufferView.buffer];
-                    const float* coords = reinterpret_cast<const float*>(&buffer.data[bufferView.byteOffset + accessor.byteOffset]);
+                    const unsigned char* base = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
+                    const size_t stride = attribute_stride(accessor, bufferView);
+                    const size_t count = std::min<size_t>(accessor.count, vertices.size());
+
+                    for(size_t i = 0; i < count; i++){
+                        const float* coord = reinterpret_cast<const float*>(base + i * stride);
+                        vertices[i].texCoord = { coord[0], 1 - coord[1] };
+                    }
 
-                    for(size_t i = 0; i < accessor.count; i++)
-                        texCoord.push_back({ coords[i * 2 + 0], 1 - coords[i * 2 + 1] });
+                    uvMapped = true;
                 }
 
                 // indices is optional per the glTF spec, non-indexed geometry is legal
@@ -165,21 +187,9 @@ namespace Draft {
                     indices = read_indices(base, accessor.componentType, accessor.count);
                 }
 
-                if(indices.empty() && texCoord.empty()){
-                    meshes.push_back(Mesh(vertices));
-                } else if(indices.empty()){
-                    meshes.push_back(Mesh(vertices, texCoord));
-                } else if(texCoord.empty()){
-                    meshes.push_back(Mesh(vertices, indices));
-                } else {
-                    meshes.push_back(Mesh(vertices, indices, texCoord));
-                }
-
+                meshes.emplace_back(std::move(vertices), std::move(indices), uvMapped, false);
                 meshToMaterialMap.push_back(primitive.material);
                 meshToMatrixMap.push_back(Matrix4(1.f));
-                vertices.clear();
-                texCoord.clear();
-                indices.clear();
             }
 
             meshPrimitiveRanges.push_back({ rangeStart, meshes.size() });
@@ -252,13 +262,20 @@ namespace Draft {
     // Constructors
     Model::Model() : reloadable(false) {}
 
-    Model::Model(const FileHandle& handle) : reloadable(true), handle(handle) {
-        load(handle);
+    Model::Model(const FileHandle& handle) : Model(decode(handle)) {}
+
+    Model::Model(ModelData data) : reloadable(data.handle.has_value()), handle(data.handle) {
+        upload(std::move(data));
     }
 
     Model::Model(const Model& other) : reloadable(other.reloadable), handle(other.handle), meshes(other.meshes), materials(other.materials), meshToMaterialMap(other.meshToMaterialMap), meshToMatrixMap(other.meshToMatrixMap), embeddedTextures(other.embeddedTextures) {
     }
 
+    Model::Model(Model&& other) noexcept
+        : reloadable(other.reloadable), handle(std::move(other.handle)), meshes(std::move(other.meshes)), materials(std::move(other.materials)),
+          meshToMaterialMap(std::move(other.meshToMaterialMap)), meshToMatrixMap(std::move(other.meshToMatrixMap)), embeddedTextures(std::move(other.embeddedTextures)) {
+    }
+
     // Operators
     Model& Model::operator=(const Model& other){
         reloadable = other.reloadable;
@@ -282,34 +299,68 @@ namespace Draft {
         return *this;
     }
 
-    void Model::load(const FileHandle& handle){
+    void Model::upload_materials(std::vector<ModelData::MaterialData>& materialData, std::vector<Image>& images){
+        // One texture per image, in the same order, so MaterialData's indices carry over
+        const size_t textureBase = embeddedTextures.size();
+        for(const Image& image : images)
+            embeddedTextures.push_back(std::make_shared<Texture>(image));
+
+        auto texture_at = [&](int index) -> Texture* {
+            return (index == -1) ? nullptr : embeddedTextures[textureBase + index].get();
+        };
+
+        materials.reserve(materials.size() + materialData.size());
+        for(auto& data : materialData){
+            materials.push_back(std::move(data.material));
+            Material3D& material = materials.back();
+
+            material.baseTexture = texture_at(data.baseTexture);
+            material.normalTexture = texture_at(data.normalTexture);
+            material.emissiveTexture = texture_at(data.emissiveTexture);
+            material.occlusionTexture = texture_at(data.occlusionTexture);
+            material.roughnessTexture = texture_at(data.roughnessTexture);
+        }
+    }
+
+    void Model::upload(ModelData&& data){
         materials.clear();
         meshes.clear();
-        meshToMaterialMap.clear();
-        meshToMatrixMap.clear();
         embeddedTextures.clear();
 
-        tinygltf::Model mdl = load_raw_model(handle);
+        upload_materials(data.materials, data.images);
+        meshToMaterialMap = std::move(data.meshToMaterialMap);
+        meshToMatrixMap = std::move(data.meshToMatrixMap);
 
-        std::vector<Mesh> cpuMeshes;
+        meshes.reserve(data.meshes.size());
+        for(const auto& mesh : data.meshes)
+            meshes.emplace_back(mesh);
+    }
+
+    // Functions
+    ModelData Model::decode(const FileHandle& handle){
+        ModelData data;
+        data.handle = handle;
+
+        tinygltf::Model mdl = load_raw_model(handle);
         std::vector<std::pair<size_t, size_t>> meshPrimitiveRanges;
 
-        load_materials(handle, materials, embeddedTextures, mdl);
-        load_meshes(cpuMeshes, meshToMaterialMap, meshToMatrixMap, meshPrimitiveRanges, mdl);
-        load_nodes(meshToMatrixMap, meshPrimitiveRanges, mdl);
+        load_materials(handle, data.materials, data.images, mdl);
+        load_meshes(data.meshes, data.meshToMaterialMap, data.meshToMatrixMap, meshPrimitiveRanges, mdl);
+        load_nodes(data.meshToMatrixMap, meshPrimitiveRanges, mdl);
 
-        meshes.reserve(cpuMeshes.size());
-        for(const auto& mesh : cpuMeshes)
-            meshes.emplace_back(mesh);
+        return data;
     }
 
-    // Functions
     void Model::reload_materials(){
         if(!reloadable) return;
 
         tinygltf::Model mdl = load_raw_model(*handle);
+        std::vector<ModelData::MaterialData> materialData;
+        std::vector<Image> images;
+        load_materials(*handle, materialData, images, mdl);
+
         materials.clear();
-        load_materials(*handle, materials, embeddedTextures, mdl);
+        upload_materials(materialData, images);
     }
 
     void Model::render(const Shader& shader, const Matrix4& modelMatrix) const {
@@ -326,6 +377,6 @@ namespace Draft {
 
     void Model::reload(){
         if(!reloadable || !handle->exists()) return;
-        load(*handle);
+        upload(decode(*handle));
     }
 }
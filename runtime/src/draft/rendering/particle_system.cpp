@@ -49,6 +49,13 @@ namespace Draft {
         }
     }
 
+    void ParticleSystem::translate(const Vector2f& offset){
+        for(auto& particle : particlePool){
+            if(particle.active)
+                particle.position += offset;
+        }
+    }
+
     ParticleSystem::VisualState ParticleSystem::compute_visual_state(float startSize, float endSize, const Vector4f& colorBegin, const Vector4f& colorEnd, float lifeFraction){
         float age = 1.f - lifeFraction;
 
@@ -1,12 +1,79 @@
+#define GLFW_INCLUDE_NONE
+
 #include "draft/rendering/shader.hpp"
+#include "draft/rendering/shader_cache.hpp"
 #include "draft/util/files/file_handle.hpp"
 #include "draft/util/logger.hpp"
+#include "GLFW/glfw3.h"
 #include "glad/gl.h"
 
+#include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
 namespace {
+    // GL_KHR_parallel_shader_compile isn't part of the generated glad core profile, so its
+    // enums and entry point are resolved by hand. GL_ARB_parallel_shader_compile shares them.
+    constexpr GLenum GL_COMPLETION_STATUS_KHR = 0x91B1;
+    using MaxShaderCompilerThreadsFn = void (GLAD_API_PTR*)(GLuint count);
+
+    bool has_extension(const char* name){
+        int count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for(int i = 0; i < count; i++){
+            const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if(ext && std::strcmp(ext, name) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool parallel_compile_supported(){
+        static const bool supported = has_extension("GL_KHR_parallel_shader_compile") || has_extension("GL_ARB_parallel_shader_compile");
+        return supported;
+    }
+
+    void enable_parallel_compile(){
+        static const bool enabled = [](){
+            if(!parallel_compile_supported())
+                return false;
+
+            auto fn = reinterpret_cast<MaxShaderCompilerThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+            if(!fn)
+                fn = reinterpret_cast<MaxShaderCompilerThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+
+            // 0xFFFFFFFF lets the driver pick its own thread count
+            if(fn)
+                fn(0xFFFFFFFF);
+
+            return fn != nullptr;
+        }();
+        (void)enabled;
+    }
+
+    void store_program_binary(unsigned int program, const std::string& key){
+        auto cache = Draft::ShaderBinaryCache::get_default();
+        if(!cache)
+            return;
+
+        int length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if(length <= 0)
+            return; // Driver exposes no binary formats
+
+        Draft::ShaderBinary binary;
+        binary.data.resize(static_cast<size_t>(length));
+
+        GLenum format = 0;
+        glGetProgramBinary(program, length, nullptr, &format, binary.data.data());
+        binary.format = format;
+
+        cache->store(key, binary);
+    }
+
     Draft::ShaderDataType map_gl_type(GLenum type){
         switch(type){
             case GL_FLOAT: return Draft::ShaderDataType::Float;
@@ -34,10 +101,40 @@ namespace {
 namespace Draft {
     // Private functions
     void Shader::cleanup(){
+        if(pendingVertex != 0){
+            glDeleteShader(pendingVertex);
+            glDeleteShader(pendingFragment);
+            pendingVertex = 0;
+            pendingFragment = 0;
+        }
+
         glDeleteProgram(shaderId);
     }
 
-    void Shader::load_shaders(const char* vertexSrc, const char* fragmentSrc){
+    void Shader::load_shaders(const char* vertexSrc, const char* fragmentSrc, ShaderLinkMode mode){
+        // Try the binary cache first, a hit skips compiling and linking altogether
+        std::shared_ptr<ShaderBinaryCache> cache = ShaderBinaryCache::get_default();
+        std::string cacheKey;
+
+        if(cache){
+            cacheKey = cache->make_key(vertexSrc, fragmentSrc);
+
+            if(auto binary = cache->load(cacheKey)){
+                shaderId = glCreateProgram();
+                glProgramBinary(shaderId, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+
+                int success = 0;
+                glGetProgramiv(shaderId, GL_LINK_STATUS, &success);
+                if(success)
+                    return;
+
+                // The driver rejected the image (e.g. it was updated since), rebuild from source and overwrite it
+                glDeleteProgram(shaderId);
+            }
+        }
+
+        enable_parallel_compile();
+
         // Allocate shaders
         unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
         unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
@@ -48,70 +145,90 @@ namespace Draft {
         glCompileShader(vertexShader);
         glCompileShader(fragmentShader);
 
+        // Link to program, without waiting on the compile results. A failed compile just
+        // fails the link too, and finish_link() reports the compile log first.
+        shaderId = glCreateProgram();
+        if(cache)
+            glProgramParameteri(shaderId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        glAttachShader(shaderId, vertexShader);
+        glAttachShader(shaderId, fragmentShader);
+        glLinkProgram(shaderId);
+
+        pendingVertex = vertexShader;
+        pendingFragment = fragmentShader;
+        pendingCacheKey = std::move(cacheKey);
+
+        if(mode == ShaderLinkMode::Immediate)
+            finish_link(true);
+    }
+
+    void Shader::load_from_handle(const FileHandle& shaderHandle){
+        ShaderSource source = read_source(shaderHandle);
+
+        // Send data to OpenGL
+        load_shaders(source.vertex.c_str(), source.fragment.c_str(), ShaderLinkMode::Immediate);
+    }
+
+    bool Shader::finish_link(bool throwOnError) const {
+        if(pendingVertex == 0)
+            return shaderId != 0;
+
+        auto fail = [&](const std::string& message){
+            Logger::println(LogLevel::Severe, "Shader", message);
+            glDeleteShader(pendingVertex);
+            glDeleteShader(pendingFragment);
+            glDeleteProgram(shaderId);
+            pendingVertex = 0;
+            pendingFragment = 0;
+            pendingCacheKey.clear();
+            shaderId = 0;
+
+            if(throwOnError)
+                throw std::runtime_error(message);
+
+            return false;
+        };
+
         // Error check
         int success;
         char infoLog[512];
-        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+        glGetShaderiv(pendingVertex, GL_COMPILE_STATUS, &success);
 
         if(!success){
-            glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-            std::string message = "Unable to compile vertex shader " + handle.filename() + " because\n" + infoLog;
-            Logger::println(LogLevel::Severe, "Shader", message);
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-            throw std::runtime_error(message);
+            glGetShaderInfoLog(pendingVertex, 512, nullptr, infoLog);
+            return fail("Unable to compile vertex shader " + handle.filename() + " because\n" + infoLog);
         }
 
-        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+        glGetShaderiv(pendingFragment, GL_COMPILE_STATUS, &success);
 
         if(!success){
-            glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-            std::string message = "Unable to compile fragment shader " + handle.filename() + " because\n" + infoLog;
-            Logger::println(LogLevel::Severe, "Shader", message);
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-            throw std::runtime_error(message);
+            glGetShaderInfoLog(pendingFragment, 512, nullptr, infoLog);
+            return fail("Unable to compile fragment shader " + handle.filename() + " because\n" + infoLog);
         }
 
-        // Link to program
-        shaderId = glCreateProgram();
-        glAttachShader(shaderId, vertexShader);
-        glAttachShader(shaderId, fragmentShader);
-        glLinkProgram(shaderId);
-
         glGetProgramiv(shaderId, GL_LINK_STATUS, &success);
         if(!success){
             glGetProgramInfoLog(shaderId, 512, nullptr, infoLog);
-            std::string message = "Unable to link shader " + handle.filename() + " because\n" + infoLog;
-            Logger::println(LogLevel::Severe, "Shader", message);
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-            glDeleteProgram(shaderId);
-            shaderId = 0;
-            throw std::runtime_error(message);
+            return fail("Unable to link shader " + handle.filename() + " because\n" + infoLog);
         }
 
         // Cleanup
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-    }
-
-    void Shader::load_from_handle(const FileHandle& shaderHandle){
-        // Build paths for files
-        FileHandle vertexHandle = shaderHandle + "/vertex.glsl";
-        FileHandle fragmentHandle = shaderHandle + "/fragment.glsl";
-
-        auto vertexSrc = vertexHandle.read_bytes();
-        auto fragmentSrc = fragmentHandle.read_bytes();
-        vertexSrc.push_back(std::byte{'\0'});
-        fragmentSrc.push_back(std::byte{'\0'});
+        glDeleteShader(pendingVertex);
+        glDeleteShader(pendingFragment);
+        pendingVertex = 0;
+        pendingFragment = 0;
+
+        if(!pendingCacheKey.empty()){
+            store_program_binary(shaderId, pendingCacheKey);
+            pendingCacheKey.clear();
+        }
 
-        // Send data to OpenGL
-        load_shaders(reinterpret_cast<const char*>(vertexSrc.data()), reinterpret_cast<const char*>(fragmentSrc.data()));
+        return true;
     }
 
     // Constructors
-    Shader::Shader(const FileHandle& vertexHandle, const FileHandle& fragmentHandle) : reloadable(false), handle(vertexHandle){
+    Shader::Shader(const FileHandle& vertexHandle, const FileHandle& fragmentHandle, ShaderLinkMode mode) : reloadable(false), handle(vertexHandle){
         // Load shader data
         auto vertexSrc = vertexHandle.read_bytes();
         auto fragmentSrc = fragmentHandle.read_bytes();
@@ -119,28 +236,24 @@ namespace Draft {
         fragmentSrc.push_back(std::byte{'\0'});
 
         // Send data to OpenGL
-        load_shaders(reinterpret_cast<const char*>(vertexSrc.data()), reinterpret_cast<const char*>(fragmentSrc.data()));
+        load_shaders(reinterpret_cast<const char*>(vertexSrc.data()), reinterpret_cast<const char*>(fragmentSrc.data()), mode);
     }
 
-    Shader::Shader(const FileHandle& handle) : reloadable(true), handle(handle) {
-        // Build paths for files
-        FileHandle vertexHandle = handle + "/vertex.glsl";
-        FileHandle fragmentHandle = handle + "/fragment.glsl";
-
-        auto vertexSrc = vertexHandle.read_bytes();
-        auto fragmentSrc = fragmentHandle.read_bytes();
-        vertexSrc.push_back(std::byte{'\0'});
-        fragmentSrc.push_back(std::byte{'\0'});
+    Shader::Shader(const FileHandle& handle, ShaderLinkMode mode) : Shader(handle, read_source(handle), mode) {}
 
+    Shader::Shader(const FileHandle& handle, const ShaderSource& source, ShaderLinkMode mode) : reloadable(true), handle(handle) {
         // Send data to OpenGL
-        load_shaders(reinterpret_cast<const char*>(vertexSrc.data()), reinterpret_cast<const char*>(fragmentSrc.data()));
+        load_shaders(source.vertex.c_str(), source.fragment.c_str(), mode);
     }
 
     Shader::Shader(Shader&& other) noexcept
-        : shaderId(other.shaderId), reloadable(other.reloadable), handle(std::move(other.handle)), memo(std::move(other.memo))
+        : shaderId(other.shaderId), reloadable(other.reloadable), handle(std::move(other.handle)), memo(std::move(other.memo)),
+          pendingVertex(other.pendingVertex), pendingFragment(other.pendingFragment), pendingCacheKey(std::move(other.pendingCacheKey))
     {
         // Stop the r-value from deleting the program when it's destroyed
         other.shaderId = 0;
+        other.pendingVertex = 0;
+        other.pendingFragment = 0;
     }
 
     Shader::~Shader(){
@@ -148,7 +261,29 @@ namespace Draft {
     }
 
     // Functions
+    ShaderSource Shader::read_source(const FileHandle& handle){
+        // Build paths for files
+        FileHandle vertexHandle = handle + "/vertex.glsl";
+        FileHandle fragmentHandle = handle + "/fragment.glsl";
+
+        return ShaderSource{vertexHandle.read_string(), fragmentHandle.read_string()};
+    }
+
+    bool Shader::is_ready() const {
+        if(pendingVertex == 0 || !parallel_compile_supported())
+            return true;
+
+        int done = 0;
+        glGetProgramiv(shaderId, GL_COMPLETION_STATUS_KHR, &done);
+        return done != 0;
+    }
+
+    bool Shader::wait() const {
+        return finish_link(false);
+    }
+
     void Shader::bind() const {
+        finish_link(false);
         glUseProgram(shaderId);
     }
 
@@ -164,6 +299,8 @@ namespace Draft {
     }
 
     int Shader::get_location(const std::string& name) const {
+        finish_link(false);
+
         // Check for memoized value first
         auto it = memo.find(name);
         if(it != memo.end())
@@ -179,9 +316,13 @@ namespace Draft {
         return loc;
     }
 
-    bool Shader::has_uniform(const std::string& name) const { return (glGetUniformLocation(shaderId, name.c_str()) != -1); }
+    bool Shader::has_uniform(const std::string& name) const {
+        finish_link(false);
+        return (glGetUniformLocation(shaderId, name.c_str()) != -1);
+    }
 
     std::vector<ShaderAttribute> Shader::reflect_attributes() const {
+        finish_link(false);
         std::vector<ShaderAttribute> attributes;
 
         int count = 0;
@@ -210,6 +351,7 @@ namespace Draft {
     }
 
     std::vector<ShaderUniform> Shader::reflect_uniforms() const {
+        finish_link(false);
         std::vector<ShaderUniform> uniforms;
 
         int count = 0;
@@ -238,6 +380,7 @@ namespace Draft {
     }
 
     std::vector<ShaderStorageBlock> Shader::reflect_storage_blocks() const {
+        finish_link(false);
         std::vector<ShaderStorageBlock> blocks;
 
         int count = 0;
@@ -0,0 +1,106 @@
+#include "draft/rendering/shader_cache.hpp"
+#include "draft/util/logger.hpp"
+#include "draft/util/serialization/binary.hpp"
+#include "glad/gl.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+namespace {
+    // "DSBC", then format and payload size, then the payload itself
+    constexpr std::uint32_t CACHE_MAGIC = 0x43425344;
+    constexpr std::size_t HEADER_SIZE = sizeof(std::uint32_t) * 3;
+
+    std::mutex defaultMutex;
+    std::shared_ptr<Draft::ShaderBinaryCache> defaultCache;
+
+    void fnv1a(std::uint64_t& hash, std::string_view data){
+        for(char c : data){
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ull;
+        }
+
+        // Terminate each field so ("ab", "c") and ("a", "bc") don't collide
+        hash ^= 0xff;
+        hash *= 0x100000001b3ull;
+    }
+
+    std::string_view gl_string(GLenum name){
+        const GLubyte* str = glGetString(name);
+        return str ? std::string_view(reinterpret_cast<const char*>(str)) : std::string_view();
+    }
+}
+
+namespace Draft {
+    ShaderBinaryCache::ShaderBinaryCache(FileHandle directory) : m_directory(std::move(directory)) {}
+
+    std::string ShaderBinaryCache::make_key(std::string_view vertexSrc, std::string_view fragmentSrc) const {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        fnv1a(hash, vertexSrc);
+        fnv1a(hash, fragmentSrc);
+        fnv1a(hash, gl_string(GL_VENDOR));
+        fnv1a(hash, gl_string(GL_RENDERER));
+        fnv1a(hash, gl_string(GL_VERSION));
+
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+        return std::string(buffer);
+    }
+
+    std::optional<ShaderBinary> ShaderBinaryCache::load(const std::string& key) const {
+        FileHandle entry = m_directory / (key + ".bin");
+        if(!entry.exists())
+            return std::nullopt;
+
+        Binary::ByteArray bytes;
+        try {
+            bytes = entry.read_bytes();
+        } catch(const std::exception&){
+            return std::nullopt;
+        }
+
+        Binary::Reader reader(bytes);
+        if(reader.remaining() < HEADER_SIZE)
+            return std::nullopt;
+
+        std::uint32_t magic = reader.read<std::uint32_t>();
+        std::uint32_t format = reader.read<std::uint32_t>();
+        std::uint32_t size = reader.read<std::uint32_t>();
+
+        if(magic != CACHE_MAGIC || reader.remaining() != size)
+            return std::nullopt;
+
+        // The payload is everything after the header, so drop the header in place rather than copy the rest out
+        bytes.erase(bytes.begin(), bytes.begin() + HEADER_SIZE);
+        return ShaderBinary{format, std::move(bytes)};
+    }
+
+    void ShaderBinaryCache::store(const std::string& key, const ShaderBinary& binary) const {
+        Binary::ByteArray bytes;
+        Binary::Writer writer(bytes);
+        writer.reserve(HEADER_SIZE + binary.data.size());
+        writer.write(CACHE_MAGIC);
+        writer.write(static_cast<std::uint32_t>(binary.format));
+        writer.write(static_cast<std::uint32_t>(binary.data.size()));
+        writer.write_bytes(binary.data);
+
+        try {
+            (m_directory / (key + ".bin")).write_bytes(bytes);
+        } catch(const std::exception& e){
+            Logger::println(LogLevel::Warning, "ShaderBinaryCache", "Unable to write program binary " + key + " because " + e.what());
+        }
+    }
+
+    void ShaderBinaryCache::set_default(std::shared_ptr<ShaderBinaryCache> cache){
+        std::lock_guard lock(defaultMutex);
+        defaultCache = std::move(cache);
+    }
+
+    std::shared_ptr<ShaderBinaryCache> ShaderBinaryCache::get_default(){
+        std::lock_guard lock(defaultMutex);
+        return defaultCache;
+    }
+}
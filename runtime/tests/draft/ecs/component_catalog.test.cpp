@@ -2,6 +2,7 @@
 #include "draft/ecs/component_catalog.hpp"
 #include "draft/ecs/scene.hpp"
 
+#include <optional>
 #include <stdexcept>
 #include <typeindex>
 #include <vector>
@@ -70,6 +71,16 @@ TEST(ComponentCatalog, RegisterThenByNameReturnsTheSameEntry)
     ASSERT_EQ(catalog.by_name("Position"), catalog.by_type<Position>());
 }
 
+TEST(ComponentCatalog, ByNameAcceptsAStringIdForTheSameEntry)
+{
+    ComponentCatalog catalog;
+    ASSERT_EQ(catalog.by_name("Position"_sid), nullptr);
+
+    catalog.register_component<Position>();
+    ASSERT_EQ(catalog.by_name("Position"_sid), catalog.by_type<Position>());
+    ASSERT_EQ(StringId("Position").str(), "Position");
+}
+
 TEST(ComponentCatalog, AllReturnsRegisteredTypesInRegistrationOrder)
 {
     ComponentCatalog catalog;
@@ -228,3 +239,64 @@ TEST(ComponentCatalog, GenericBinarySerializeRoundTripsThroughComponentTypeInter
     ASSERT_FLOAT_EQ(dst.get_component<Position>().x, 5.f);
     ASSERT_FLOAT_EQ(dst.get_component<Position>().y, 6.f);
 }
+
+namespace {
+    // Opaque to the off-thread check, its own members could reach anything while decoding
+    struct Opaque {
+        int value = 0;
+
+        static void serialize(const Opaque& o, Binary::ByteArray& out){ Serializer::serialize(o.value, out); }
+        static void deserialize(Opaque& o, Binary::ByteView span){ Serializer::deserialize(o.value, span); }
+    };
+
+    struct Holder {
+        DRAFT_REFLECTED(std::vector<std::optional<Opaque>>, items);
+
+        DRAFT_REFLECTABLE(Holder, items)
+    };
+
+    struct Link {
+        DRAFT_REFLECTED(Entity, target);
+        DRAFT_REFLECTED(std::vector<Position>, path);
+
+        DRAFT_REFLECTABLE(Link, target, path)
+    };
+}
+
+TEST(ComponentCatalog, OffThreadDecodingFollowsFieldsAndTemplateArguments)
+{
+    static_assert(is_decodable_off_thread<Position>());
+    static_assert(is_decodable_off_thread<Link>());
+    static_assert(!is_decodable_off_thread<Opaque>());
+    static_assert(!is_decodable_off_thread<Holder>());
+
+    ComponentCatalog catalog;
+    catalog.register_component<Link>();
+    EXPECT_TRUE(catalog.by_type<Link>()->decodes_off_thread());
+}
+
+TEST(ComponentCatalog, DecodeThenEmplaceMatchesDeserialize)
+{
+    ComponentCatalog catalog;
+    catalog.register_component<Position>();
+    ComponentTypeInterface* entry = catalog.by_type<Position>();
+
+    Scene scene;
+    Entity fresh = scene.create_entity();
+    Entity existing = scene.create_entity();
+    existing.add_component<Position>(Position{5.f, 6.f});
+
+    // JSON merges into an existing component, so the missing "y" keeps its value
+    JSON freshJson = JSON::object({{"x", 1.f}, {"y", 2.f}});
+    JSON partialJson = JSON::object({{"x", 3.f}});
+    std::vector<JSON*> payloads{&freshJson, &partialJson};
+    std::vector<entt::entity> entities{fresh, existing};
+
+    auto decoded = entry->decode(payloads);
+    entry->emplace(scene, entities, *decoded);
+
+    EXPECT_FLOAT_EQ(fresh.get_component<Position>().x, 1.f);
+    EXPECT_FLOAT_EQ(fresh.get_component<Position>().y, 2.f);
+    EXPECT_FLOAT_EQ(existing.get_component<Position>().x, 3.f);
+    EXPECT_FLOAT_EQ(existing.get_component<Position>().y, 6.f);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "draft/ecs/floating_origin_system.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/physics_system.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/components/camera_component.hpp"
+#include "draft/components/collider_component.hpp"
+#include "draft/components/rigid_body_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/physics/shapes/polygon_shape.hpp"
+#include "draft/physics/world.hpp"
+
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    Camera make_ortho_camera(const Vector3f& position){
+        return Camera::make_orthographic(position, Vector3f{0, 0, -1}, -1.f, 1.f, -1.f, 1.f);
+    }
+
+    // A kinematic player sliding along a floor while boxes land on it ahead of it, returning
+    // every box's final position in the scene's starting coordinates
+    std::vector<Vector2f> run_drops(bool floatingOrigin, bool threaded, int* rebases = nullptr){
+        World world({0.f, -10.f});
+        Scene scene;
+        PhysicsSystem& physics = scene.get_systems().add<PhysicsSystem>(scene, world);
+        physics.set_threaded(threaded);
+
+        PolygonShape floorShape;
+        floorShape.set_as_box(200.f, 0.5f);
+        PolygonShape boxShape;
+        boxShape.set_as_box(0.5f, 0.5f);
+
+        Entity floor = scene.create_entity();
+        floor.add_component<TransformComponent>(TransformComponent{{150.f, 0.f}, 0.f});
+        floor.add_component<RigidBodyComponent>();
+        floor.add_component<ColliderComponent>(ColliderComponent(floorShape));
+
+        Entity player = scene.create_entity();
+        player.add_component<TransformComponent>(TransformComponent{{0.f, 5.f}, 0.f});
+        player.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::KINEMATIC, .linearVelocity = {25.f, 0.f}});
+
+        std::vector<Entity> boxes;
+        for(int i = 0; i < 6; i++){
+            Entity box = scene.create_entity();
+            box.add_component<TransformComponent>(TransformComponent{{20.f + i * 20.f, 3.f + i}, 0.f});
+            box.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+            box.add_component<ColliderComponent>(ColliderComponent(boxShape));
+            boxes.push_back(box);
+        }
+
+        FloatingOriginSystem* origin = nullptr;
+        if(floatingOrigin){
+            origin = &scene.get_systems().add<FloatingOriginSystem>(scene);
+            origin->threshold = 16.f;
+            origin->set_target(player);
+        }
+
+        int shifts = 0;
+        if(origin)
+            origin->add_shift_callback([&](const Vector2f&){ shifts++; });
+
+        for(int i = 0; i < 300; i++)
+            scene.update(Time::seconds(1.f / 60.f));
+
+        physics.finish_step();
+
+        if(rebases)
+            *rebases = shifts;
+
+        Vector2d offset = origin ? origin->get_origin() : Vector2d{};
+        EXPECT_LE(Math::length(player.get_component<TransformComponent>().position), origin ? 17.f : 200.f);
+
+        std::vector<Vector2f> positions;
+        for(Entity& box : boxes)
+            positions.push_back(Vector2f(Vector2d(box.get_component<TransformComponent>().position) + offset));
+
+        return positions;
+    }
+}
+
+TEST(FloatingOriginSystem, ShiftedRunMatchesUnshiftedRun)
+{
+    std::vector<Vector2f> reference = run_drops(false, false);
+
+    for(bool threaded : {false, true}){
+        int rebases = 0;
+        std::vector<Vector2f> shifted = run_drops(true, threaded, &rebases);
+
+        // 125 units travelled past a 16 unit threshold
+        EXPECT_GE(rebases, 6);
+        ASSERT_EQ(shifted.size(), reference.size());
+
+        for(size_t i = 0; i < reference.size(); i++){
+            EXPECT_NEAR(shifted[i].x, reference[i].x, 1e-3f) << "box " << i << (threaded ? " (threaded)" : "");
+            EXPECT_NEAR(shifted[i].y, reference[i].y, 1e-3f) << "box " << i << (threaded ? " (threaded)" : "");
+        }
+    }
+}
+
+TEST(FloatingOriginSystem, RebaseMovesRootsCamerasAndOverride)
+{
+    Scene scene;
+    FloatingOriginSystem& origin = scene.get_systems().add<FloatingOriginSystem>(scene);
+
+    Entity root = scene.create_entity();
+    root.add_component<TransformComponent>(TransformComponent{{100.f, 50.f}, 0.f});
+
+    Entity child = scene.create_entity();
+    child.add_component<TransformComponent>(TransformComponent{{1.f, 2.f}, 0.f});
+    child.add_component<ChildComponent>(ChildComponent{root});
+
+    Entity freeCamera = scene.create_entity();
+    freeCamera.add_component<CameraComponent>(CameraComponent{true, 0, make_ortho_camera({90.f, 40.f, 5.f})});
+
+    Vector2f shifted;
+    origin.add_shift_callback([&](const Vector2f& shift){ shifted = shift; });
+    origin.rebase({100.f, 50.f});
+    scene.update_world_transforms();
+
+    // Children are relative to their parent, so only the root moved but both ended up shifted
+    EXPECT_EQ(root.get_component<TransformComponent>().position, Vector2f(0.f, 0.f));
+    EXPECT_EQ(child.get_component<TransformComponent>().position, Vector2f(1.f, 2.f));
+    EXPECT_EQ(child.get_component<WorldTransformComponent>().position, Vector2f(1.f, 2.f));
+
+    EXPECT_EQ(freeCamera.get_component<CameraComponent>().camera.get_position(), Vector3f(-10.f, -10.f, 5.f));
+    EXPECT_EQ(shifted, Vector2f(100.f, 50.f));
+
+    scene.set_active_camera_override(make_ortho_camera({3.f, 4.f, 1.f}));
+    origin.rebase({1.f, 1.f});
+    EXPECT_EQ(scene.get_active_camera()->get_position(), Vector3f(2.f, 3.f, 1.f));
+    EXPECT_EQ(origin.get_origin(), Vector2d(101.0, 51.0));
+}
+
+TEST(FloatingOriginSystem, FollowsTheActiveCameraWithoutATarget)
+{
+    Scene scene;
+    FloatingOriginSystem& origin = scene.get_systems().add<FloatingOriginSystem>(scene);
+    origin.threshold = 10.f;
+
+    Entity camera = scene.create_entity();
+    camera.add_component<TransformComponent>(TransformComponent{{8.f, 0.f}, 0.f});
+    camera.add_component<CameraComponent>(CameraComponent{true, 0, make_ortho_camera({0.f, 0.f, 5.f})});
+
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_EQ(origin.get_origin(), Vector2d(0.0, 0.0));
+
+    camera.get_component<TransformComponent>().position = {12.4f, -3.6f};
+    scene.update(Time::seconds(1.f / 60.f));
+
+    // Rounded to whole units
+    EXPECT_EQ(origin.get_origin(), Vector2d(12.0, -4.0));
+    EXPECT_NEAR(camera.get_component<TransformComponent>().position.x, 0.4f, 1e-5f);
+    EXPECT_NEAR(camera.get_component<TransformComponent>().position.y, 0.4f, 1e-5f);
+}
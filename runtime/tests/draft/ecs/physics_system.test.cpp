@@ -7,9 +7,20 @@
 #include "draft/components/rigid_body_component.hpp"
 #include "draft/components/tag_component.hpp"
 #include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/ecs/relationship_components.hpp"
 #include "draft/physics/shapes/circle_shape.hpp"
 #include "draft/physics/shapes/polygon_shape.hpp"
 #include "draft/physics/world.hpp"
+#include "draft/util/thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
 
 using namespace Draft;
 
@@ -125,7 +136,7 @@ TEST(PhysicsSystem, JointComponentPairCreatesALiveJointAndConstrainsBothEntities
 }
 
 // Regression test for box2d setting values for joints
-TEST(PhysicsSystem, EditingAJointAnchorAfterConstructionRebuildsTheNativeJoint)
+TEST(PhysicsSystem, EditingAJointAnchorAfterConstructionUpdatesTheNativeJointInPlace)
 {
     World world({0.f, 0.f});
     Scene scene;
@@ -149,6 +160,7 @@ TEST(PhysicsSystem, EditingAJointAnchorAfterConstructionRebuildsTheNativeJoint)
 
     // bodyA sits at the origin with no rotation, so its world anchor starts at {0, 0} too.
     ASSERT_FLOAT_EQ(jointEntity.get_component<RevoluteJointComponent>().get_world_anchor_a().x, 0.f);
+    Joint* joint = jointEntity.get_component<RevoluteJointComponent::NativeType>().jointPtr;
 
     // Simulate an inspector edit
     jointEntity.get_component<RevoluteJointComponent>().localAnchorA = Vector2f{1.f, 0.f};
@@ -158,16 +170,59 @@ TEST(PhysicsSystem, EditingAJointAnchorAfterConstructionRebuildsTheNativeJoint)
     ASSERT_TRUE(jointEntity.has_component<RevoluteJointComponent::NativeType>());
     EXPECT_EQ(jointEntity.get_component<RevoluteJointComponent>().localAnchorA, (Vector2f{1.f, 0.f}));
 
-    // The native joint must have actually been rebuilt with the new anchor
+    // The same native joint must have actually picked up the new anchor
+    EXPECT_EQ(jointEntity.get_component<RevoluteJointComponent::NativeType>().jointPtr, joint);
     EXPECT_NEAR(jointEntity.get_component<RevoluteJointComponent>().get_world_anchor_a().x, 1.f, 0.001f);
 
-    // The rebuild must also refresh ConstrainedComponent's link on each body
+    // ConstrainedComponent's link on each body is untouched
     ASSERT_TRUE(bodyA.has_component<ConstrainedComponent>());
     EXPECT_EQ(bodyA.get_component<ConstrainedComponent>().constraints.size(), 1u);
     ASSERT_TRUE(bodyB.has_component<ConstrainedComponent>());
     EXPECT_EQ(bodyB.get_component<ConstrainedComponent>().constraints.size(), 1u);
 }
 
+TEST(PhysicsSystem, RetargetingJointGeometryEveryUpdateNeverRebuildsTheJoint)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity bodyA = scene.create_entity();
+    bodyA.add_component<TransformComponent>();
+    bodyA.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::STATIC});
+
+    Entity bodyB = scene.create_entity();
+    bodyB.add_component<TransformComponent>(TransformComponent{{2.f, 0.f}, 0.f});
+    bodyB.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    Entity jointEntity = scene.create_entity();
+    PrismaticJointComponent jointData;
+    jointData.entityA = bodyA;
+    jointData.entityB = bodyB;
+    jointEntity.add_component<PrismaticJointComponent>(jointData);
+
+    auto& native = jointEntity.get_component<PrismaticJointComponent::NativeType>();
+    Joint* joint = native.jointPtr;
+
+    for(int i = 1; i <= 10; i++){
+        auto& component = jointEntity.get_component<PrismaticJointComponent>();
+        component.anchorA = {0.f, 0.1f * i};
+        component.localAxisA = {0.f, 2.f};
+        component.referenceAngle = 0.01f * i;
+
+        scene.update(Time::seconds(1.f / 60.f));
+
+        ASSERT_EQ(native.jointPtr, joint);
+        auto* prismatic = native.get_as<PrismaticJoint>();
+        EXPECT_FLOAT_EQ(prismatic->get_local_anchor_a().y, 0.1f * i);
+        EXPECT_FLOAT_EQ(prismatic->get_reference_angle(), 0.01f * i);
+
+        // The axis is normalized on the way in, and the component sees the value box2d uses
+        EXPECT_FLOAT_EQ(prismatic->get_local_axis().y, 1.f);
+        EXPECT_FLOAT_EQ(jointEntity.get_component<PrismaticJointComponent>().localAxisA.y, 1.f);
+    }
+}
+
 // Regression test for crashing on clear
 TEST(PhysicsSystem, ClearingTheRegistryWithALiveJointDoesNotCrash)
 {
@@ -281,6 +336,76 @@ TEST(PhysicsSystem, OneShotTorqueComponentIsConsumedAfterOneUpdate)
     EXPECT_FALSE(entity.has_component<TorqueComponent>());
 }
 
+TEST(PhysicsSystem, ForceAccumulatorMatchesOneShotComponentsAndStaysAttached)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    CircleShape circle;
+    circle.set_radius(0.5f);
+
+    auto make_body = [&](Vector2f position){
+        Entity entity = scene.create_entity();
+        entity.add_component<TransformComponent>(TransformComponent{position, 0.f});
+        entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+        entity.add_component<ColliderComponent>(ColliderComponent(circle));
+        return entity;
+    };
+
+    // Far enough apart to never touch, off the origin so the moment arms matter
+    Entity oneShot = make_body({10.f, 10.f});
+    Entity accumulated = make_body({-10.f, -10.f});
+    accumulated.add_component<ForceAccumulatorComponent>();
+
+    for(int i = 0; i < 3; i++){
+        oneShot.add_component<ImpulseComponent>(ImpulseComponent{{1.f, 0.f}, {10.f, 11.f}, 0.5f, true});
+        oneShot.add_component<ForceComponent>(ForceComponent{{0.f, 4.f}, {11.f, 10.f}, true});
+
+        auto& accumulator = accumulated.get_component<ForceAccumulatorComponent>();
+        accumulator.add_impulse({0.5f, 0.f}, {-10.f, -9.f});
+        accumulator.add_impulse({0.5f, 0.f}, {-10.f, -9.f});
+        accumulator.add_angular_impulse(0.5f);
+        accumulator.add_force({0.f, 4.f}, {-9.f, -10.f});
+
+        scene.update(Time::seconds(1.f / 60.f));
+
+        ASSERT_TRUE(accumulated.has_component<ForceAccumulatorComponent>());
+        EXPECT_TRUE(accumulated.get_component<ForceAccumulatorComponent>().is_empty());
+
+        const auto& expected = oneShot.get_component<RigidBodyComponent>();
+        const auto& actual = accumulated.get_component<RigidBodyComponent>();
+        EXPECT_NEAR(actual.linearVelocity.x, expected.linearVelocity.x, 1e-4f);
+        EXPECT_NEAR(actual.linearVelocity.y, expected.linearVelocity.y, 1e-4f);
+        EXPECT_NEAR(actual.angularVelocity, expected.angularVelocity, 1e-4f);
+    }
+
+    EXPECT_GT(accumulated.get_component<RigidBodyComponent>().linearVelocity.x, 0.f);
+    EXPECT_LT(accumulated.get_component<RigidBodyComponent>().angularVelocity, 0.f);
+}
+
+TEST(PhysicsSystem, EmptyForceAccumulatorLeavesSleepingBodiesAlone)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+    entity.add_component<ForceAccumulatorComponent>();
+    RigidBody* body = entity.get_component<NativeBodyComponent>();
+
+    for(int i = 0; i < 120; i++)
+        scene.update(Time::seconds(1.f / 60.f));
+
+    EXPECT_FALSE(body->is_awake());
+
+    entity.get_component<ForceAccumulatorComponent>().add_torque(1.f);
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_TRUE(body->is_awake());
+}
+
 TEST(PhysicsSystem, ContinuousForceComponentIsNotConsumed)
 {
     World world({0.f, 0.f});
@@ -423,3 +548,452 @@ TEST(PhysicsSystem, DestroyingAMiddleBodyDoesNotDetachALaterBodysCollider)
     circle2.destroy();
     EXPECT_EQ(world.get_body_count(), 4u);
 }
+
+TEST(PhysicsSystem, ContactEventsAreResolvedToTheirEntities)
+{
+    World world({0.f, -10.f});
+    Scene scene;
+    PhysicsSystem& physics = scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity ground = scene.create_entity();
+    ground.add_component<TransformComponent>(TransformComponent{{0.f, -0.5f}, 0.f});
+    ground.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::STATIC});
+    PolygonShape groundShape;
+    groundShape.set_as_box(5.f, 0.5f);
+    ground.add_component<ColliderComponent>(ColliderComponent(groundShape));
+
+    Entity ball = scene.create_entity();
+    ball.add_component<TransformComponent>(TransformComponent{{-2.f, 2.f}, 0.f});
+    ball.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+    CircleShape circle;
+    circle.set_radius(0.5f);
+    ball.add_component<ColliderComponent>(ColliderComponent(circle));
+
+    // A body no entity owns lands too, its events are only on the world
+    BodyDef strayDef;
+    strayDef.type = BodyType::DYNAMIC;
+    strayDef.position = {2.f, 2.f};
+    RigidBody* stray = world.create_rigid_body(strayDef);
+    stray->create_fixture(&circle, 1.f);
+
+    bool began = false;
+    size_t worldBegins = 0;
+    for(int i = 0; i < 120 && !began; i++){
+        scene.update(Time::seconds(1.f / 60.f));
+
+        for(const ContactEvent& event : world.get_contact_events())
+            worldBegins += event.type == ContactEventType::BEGIN_CONTACT;
+
+        for(const EntityContactEvent& contact : physics.get_contact_events()){
+            EXPECT_TRUE((contact.entityA == ground && contact.entityB == ball) || (contact.entityA == ball && contact.entityB == ground));
+            began |= contact.event.type == ContactEventType::BEGIN_CONTACT;
+        }
+    }
+
+    EXPECT_TRUE(began);
+    EXPECT_EQ(worldBegins, 2u);
+}
+
+TEST(PhysicsSystem, FirstSyncDoesNotReapplyConstructionValues)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC, .linearDamping = 0.5f, .gravityScale = 2.f});
+
+    scene.update(Time::seconds(1.f / 60.f));
+
+    RigidBody* body = entity.get_component<NativeBodyComponent>();
+    EXPECT_FLOAT_EQ(body->get_linear_damping(), 0.5f);
+    EXPECT_FLOAT_EQ(body->get_gravity_scale(), 2.f);
+}
+
+TEST(PhysicsSystem, SleepingBodiesOnlySyncWhenPatched)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+    RigidBody* body = entity.get_component<NativeBodyComponent>();
+
+    // Nothing moves it, so box2d puts it to sleep and the component is told once it does
+    for(int i = 0; i < 120; i++)
+        scene.update(Time::seconds(1.f / 60.f));
+
+    ASSERT_FALSE(body->is_awake());
+    EXPECT_FALSE(entity.get_component<RigidBodyComponent>().awake);
+
+    // A raw write isn't seen while it sleeps
+    entity.get_component<RigidBodyComponent>().linearVelocity = {1.f, 0.f};
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_FLOAT_EQ(body->get_linear_velocity().x, 0.f);
+
+    // Patching it is, and wakes the body
+    entity.modify_component<RigidBodyComponent>([](RigidBodyComponent& c){ c.linearVelocity = {1.f, 0.f}; });
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_FLOAT_EQ(body->get_linear_velocity().x, 1.f);
+    EXPECT_TRUE(body->is_awake());
+    EXPECT_TRUE(entity.get_component<RigidBodyComponent>().awake);
+
+    // Awake again, so it moves its transform without any help
+    float x = entity.get_component<TransformComponent>().position.x;
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_GT(entity.get_component<TransformComponent>().position.x, x);
+}
+
+TEST(PhysicsSystem, ThreadedSteppingLagsInlineSteppingByOneUpdate)
+{
+    World inlineWorld({0.f, -10.f});
+    World threadedWorld({0.f, -10.f});
+    Scene inlineScene;
+    Scene threadedScene;
+    inlineScene.get_systems().add<PhysicsSystem>(inlineScene, inlineWorld);
+    PhysicsSystem& threaded = threadedScene.get_systems().add<PhysicsSystem>(threadedScene, threadedWorld);
+    threaded.set_threaded(true);
+    ASSERT_TRUE(threaded.is_threaded());
+
+    Entity inlineBody = inlineScene.create_entity();
+    inlineBody.add_component<TransformComponent>();
+    inlineBody.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    Entity threadedBody = threadedScene.create_entity();
+    threadedBody.add_component<TransformComponent>();
+    threadedBody.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    // The first threaded update only starts a step, so it syncs nothing new
+    threadedScene.update(Time::seconds(1.f / 60.f));
+    EXPECT_FLOAT_EQ(threadedBody.get_component<TransformComponent>().position.y, 0.f);
+
+    for(int i = 0; i < 30; i++){
+        inlineScene.update(Time::seconds(1.f / 60.f));
+        threadedScene.update(Time::seconds(1.f / 60.f));
+
+        ASSERT_FLOAT_EQ(threadedBody.get_component<TransformComponent>().position.y, inlineBody.get_component<TransformComponent>().position.y);
+        ASSERT_FLOAT_EQ(threadedBody.get_component<RigidBodyComponent>().linearVelocity.y, inlineBody.get_component<RigidBodyComponent>().linearVelocity.y);
+    }
+
+    // Back on the calling thread, the step in flight is finished and nothing is lost
+    threaded.set_threaded(false);
+    EXPECT_FALSE(threaded.is_threaded());
+
+    inlineScene.update(Time::seconds(1.f / 60.f));
+    threadedScene.update(Time::seconds(1.f / 60.f));
+    EXPECT_LT(threadedBody.get_component<TransformComponent>().position.y, inlineBody.get_component<TransformComponent>().position.y);
+}
+
+TEST(PhysicsSystem, ComponentHooksWaitForTheStepInFlight)
+{
+    World world({0.f, -10.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world).set_threaded(true);
+
+    // Creating and destroying bodies between threaded updates is safe
+    std::vector<Entity> entities;
+    for(int i = 0; i < 50; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TransformComponent>(TransformComponent{{static_cast<float>(i), 0.f}, 0.f});
+        entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+        entities.push_back(entity);
+
+        scene.update(Time::seconds(1.f / 60.f));
+    }
+
+    for(size_t i = 0; i < entities.size(); i += 2){
+        entities[i].remove_component<RigidBodyComponent>();
+        scene.update(Time::seconds(1.f / 60.f));
+    }
+
+    EXPECT_EQ(world.get_body_count(), 25u);
+}
+
+TEST(PhysicsSystem, PreviousPoseTrailsTheLastStep)
+{
+    World world({0.f, -10.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>(TransformComponent{{0.f, 5.f}, 0.f});
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    NativeBodyComponent& native = entity.get_component<NativeBodyComponent>();
+    EXPECT_FLOAT_EQ(native.previousPosition.y, 5.f);
+
+    // Falling, the previous pose is where the step before left it
+    scene.update(Time::seconds(1.f / 60.f));
+    float y = entity.get_component<TransformComponent>().position.y;
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_FLOAT_EQ(native.previousPosition.y, y);
+    EXPECT_LT(entity.get_component<TransformComponent>().position.y, y);
+
+    // Teleporting it doesn't interpolate across the jump
+    entity.modify_component<TransformComponent>([](TransformComponent& c){ c.position = {100.f, 100.f}; });
+    scene.update(Time::seconds(1.f / 60.f));
+    EXPECT_FLOAT_EQ(native.previousPosition.x, 100.f);
+    EXPECT_FLOAT_EQ(native.previousPosition.y, 100.f);
+}
+
+TEST(PhysicsSystem, PreviousPoseSettlesOnceABodySleeps)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    scene.get_systems().add<PhysicsSystem>(scene, world);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC, .linearVelocity = {1.f, 0.f}, .linearDamping = 5.f});
+    RigidBody* body = entity.get_component<NativeBodyComponent>();
+
+    for(int i = 0; i < 300 && body->is_awake(); i++)
+        scene.update(Time::seconds(1.f / 60.f));
+
+    ASSERT_FALSE(body->is_awake());
+    scene.update(Time::seconds(1.f / 60.f));
+
+    NativeBodyComponent& native = entity.get_component<NativeBodyComponent>();
+    const TransformComponent& transform = entity.get_component<TransformComponent>();
+    EXPECT_FLOAT_EQ(native.previousPosition.x, transform.position.x);
+    EXPECT_FLOAT_EQ(native.previousPosition.y, transform.position.y);
+}
+
+namespace {
+    // A floor per world with a box falling onto it, stepped with @p pool (or inline), returning
+    // every box's height after @p updates and which worlds the landing contacts came from
+    struct RoomsResult {
+        std::vector<float> heights;
+        std::vector<uint32_t> eventWorlds;
+    };
+
+    RoomsResult run_rooms(int rooms, int updates, ThreadPool* pool){
+        std::vector<std::unique_ptr<World>> worlds;
+        Scene scene;
+        PhysicsSystem& system = scene.get_systems().add<PhysicsSystem>(scene, *worlds.emplace_back(std::make_unique<World>(Vector2f{0.f, -10.f})));
+        system.set_thread_pool(pool);
+
+        for(int i = 1; i < rooms; i++)
+            EXPECT_EQ(system.add_world(*worlds.emplace_back(std::make_unique<World>(Vector2f{0.f, -10.f}))), static_cast<uint32_t>(i));
+
+        PolygonShape floorShape;
+        floorShape.set_as_box(5.f, 0.5f);
+        PolygonShape boxShape;
+        boxShape.set_as_box(0.5f, 0.5f);
+
+        std::vector<Entity> boxes;
+        for(int i = 0; i < rooms; i++){
+            // Every room in the same spot, they only stay apart by being in different worlds
+            Entity floor = scene.create_entity();
+            floor.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{static_cast<uint32_t>(i)});
+            floor.add_component<TransformComponent>();
+            floor.add_component<RigidBodyComponent>();
+            floor.add_component<ColliderComponent>(ColliderComponent(floorShape));
+
+            Entity box = scene.create_entity();
+            box.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{static_cast<uint32_t>(i)});
+            box.add_component<TransformComponent>(TransformComponent{{0.f, 3.f}, 0.f});
+            box.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+            box.add_component<ColliderComponent>(ColliderComponent(boxShape));
+            boxes.push_back(box);
+        }
+
+        RoomsResult result;
+        for(int i = 0; i < updates; i++){
+            scene.update(Time::seconds(1.f / 60.f));
+
+            std::vector<uint32_t> eventWorlds;
+            for(const EntityContactEvent& event : system.get_contact_events()){
+                if(event.event.type == ContactEventType::BEGIN_CONTACT)
+                    eventWorlds.push_back(event.entityA.get_component<PhysicsWorldComponent>().world);
+            }
+
+            if(!eventWorlds.empty())
+                result.eventWorlds = eventWorlds;
+        }
+
+        for(Entity& box : boxes)
+            result.heights.push_back(box.get_component<TransformComponent>().position.y);
+
+        for(auto& world : worlds)
+            EXPECT_EQ(world->get_body_count(), 2u);
+
+        return result;
+    }
+}
+
+TEST(PhysicsSystem, WorldsStepIndependentlyAndConcurrently)
+{
+    RoomsResult inlineResult = run_rooms(4, 90, nullptr);
+
+    // Every box rests on its own floor, all landing in the same update
+    for(float height : inlineResult.heights)
+        EXPECT_NEAR(height, 1.f, 0.05f);
+
+    EXPECT_EQ(inlineResult.eventWorlds, (std::vector<uint32_t>{0, 1, 2, 3}));
+
+    ThreadPool pool(3);
+    RoomsResult pooledResult = run_rooms(4, 90, &pool);
+
+    // Same answer to the bit, events in world order whichever world finished first
+    EXPECT_EQ(pooledResult.heights, inlineResult.heights);
+    EXPECT_EQ(pooledResult.eventWorlds, inlineResult.eventWorlds);
+}
+
+TEST(PhysicsSystem, PhysicsWorldComponentMovesBodiesBetweenWorlds)
+{
+    World first({0.f, 0.f});
+    World second({0.f, 0.f});
+    Scene scene;
+    PhysicsSystem& system = scene.get_systems().add<PhysicsSystem>(scene, first);
+    ASSERT_EQ(system.add_world(second), 1u);
+    ASSERT_EQ(system.get_world_count(), 2u);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>(TransformComponent{{3.f, 4.f}, 0.f});
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC, .linearVelocity = {1.f, 0.f}});
+    EXPECT_EQ(first.get_body_count(), 1u);
+
+    entity.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{1});
+    EXPECT_EQ(first.get_body_count(), 0u);
+    EXPECT_EQ(second.get_body_count(), 1u);
+
+    RigidBody* body = entity.get_component<NativeBodyComponent>();
+    EXPECT_EQ(body->get_world(), &second);
+    EXPECT_FLOAT_EQ(body->get_position().x, 3.f);
+    EXPECT_FLOAT_EQ(body->get_linear_velocity().x, 1.f);
+
+    entity.remove_component<PhysicsWorldComponent>();
+    EXPECT_EQ(first.get_body_count(), 1u);
+    EXPECT_EQ(second.get_body_count(), 0u);
+
+    // A world that isn't added yet waits in world 0, then moves over once it is
+    entity.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{2});
+    EXPECT_EQ(first.get_body_count(), 1u);
+
+    World third({0.f, 0.f});
+    ASSERT_EQ(system.add_world(third), 2u);
+    EXPECT_EQ(first.get_body_count(), 0u);
+    EXPECT_EQ(third.get_body_count(), 1u);
+}
+
+TEST(PhysicsSystem, JointsFollowTheirBodiesBetweenWorlds)
+{
+    World first({0.f, 0.f});
+    World second({0.f, 0.f});
+    Scene scene;
+    PhysicsSystem& system = scene.get_systems().add<PhysicsSystem>(scene, first);
+    system.add_world(second);
+
+    Entity bodyA = scene.create_entity();
+    bodyA.add_component<TransformComponent>();
+    bodyA.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    Entity bodyB = scene.create_entity();
+    bodyB.add_component<TransformComponent>(TransformComponent{{2.f, 0.f}, 0.f});
+    bodyB.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    Entity jointEntity = scene.create_entity();
+    DistanceJointComponent jointData;
+    jointData.entityA = bodyA;
+    jointData.entityB = bodyB;
+    jointData.length = 2.f;
+    jointEntity.add_component<DistanceJointComponent>(jointData);
+    ASSERT_TRUE(jointEntity.has_component<DistanceJointComponent::NativeType>());
+
+    // Split across worlds the joint is kept but has nothing to act on
+    bodyA.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{1});
+    ASSERT_TRUE(jointEntity.is_valid());
+    EXPECT_FALSE(jointEntity.has_component<DistanceJointComponent::NativeType>());
+
+    // Back together, in the other world, it's rebuilt there
+    bodyB.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{1});
+    ASSERT_TRUE(jointEntity.has_component<DistanceJointComponent::NativeType>());
+    EXPECT_EQ(jointEntity.get_component<DistanceJointComponent::NativeType>().jointPtr->get_world(), &second);
+    EXPECT_EQ(bodyA.get_component<ConstrainedComponent>().constraints[0], jointEntity);
+}
+
+TEST(PhysicsSystem, AccessCoversWhatItsHooksTouch)
+{
+    World world({0.f, 0.f});
+    Scene scene;
+    PhysicsSystem& physics = scene.get_systems().add<PhysicsSystem>(scene, world);
+    SystemAccess access = *physics.get_access();
+
+    EXPECT_TRUE(access.conflicts_with(SystemAccess().write<PhysicsWorldComponent>()));
+    EXPECT_TRUE(access.conflicts_with(SystemAccess().read<ColliderComponent>()));
+    EXPECT_TRUE(access.conflicts_with(SystemAccess().read<WorldTransformComponent>()));
+    EXPECT_TRUE(access.conflicts_with(SystemAccess().read<ParentComponent>()));
+}
+
+namespace {
+    // Flags when update() ran, and whether the camera below had already finished by then
+    struct SignalingPhysics : PhysicsSystem {
+        using PhysicsSystem::PhysicsSystem;
+
+        std::atomic<bool> updated = false;
+        const std::atomic<bool>* cameraDone = nullptr;
+        bool sawCameraDone = false;
+
+        void update(Time dt) override {
+            sawCameraDone = *cameraDone;
+            PhysicsSystem::update(dt);
+            updated = true;
+        }
+    };
+
+    struct ScoreBoard {};
+
+    // Stays in update() until physics has run. Physics is registered after it, so that only
+    // happens if both are in the same parallel batch. Bounded, so a failure can't hang
+    struct ScoreSystem : AbstractSystem {
+        const std::atomic<bool>* physicsUpdated = nullptr;
+        bool ranAlongsidePhysics = false;
+
+        void update(Time) override {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while(!*physicsUpdated && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::yield();
+
+            ranAlongsidePhysics = *physicsUpdated;
+        }
+
+        std::optional<SystemAccess> get_access() const override { return SystemAccess().write<ScoreBoard>(); }
+    };
+
+    // Reads transforms, so physics has to wait for it
+    struct CameraSystem : AbstractSystem {
+        std::atomic<bool> done = false;
+
+        void update(Time) override { done = true; }
+        std::optional<SystemAccess> get_access() const override { return SystemAccess().read<TransformComponent>(); }
+    };
+}
+
+TEST(PhysicsSystem, RunsInTheSameBatchAsSystemsThatDontTouchBodies)
+{
+    World world({0.f, -10.f});
+    Scene scene;
+    SystemRegistry& systems = scene.get_systems();
+    systems.set_worker_threads(2);
+
+    auto& scoring = systems.add<ScoreSystem>();
+    auto& camera = systems.add<CameraSystem>();
+    auto& physics = systems.add<SignalingPhysics>(scene, world);
+    scoring.physicsUpdated = &physics.updated;
+    physics.cameraDone = &camera.done;
+
+    Entity ball = scene.create_entity();
+    ball.add_component<TransformComponent>(TransformComponent{{0.f, 10.f}, 0.f});
+    ball.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+
+    scene.update(Time::seconds(1.f / 60.f));
+
+    // Didn't wait for the score keeper, but did wait for the camera reading transforms
+    EXPECT_TRUE(scoring.ranAlongsidePhysics);
+    EXPECT_TRUE(physics.sawCameraDone);
+    EXPECT_LT(ball.get_component<TransformComponent>().position.y, 10.f);
+}
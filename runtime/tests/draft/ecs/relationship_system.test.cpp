@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
 #include "draft/ecs/entity.hpp"
 #include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/relationship_system.hpp"
 #include "draft/ecs/scene.hpp"
 
+#include <algorithm>
+#include <vector>
+
 using namespace Draft;
 
 TEST(RelationshipSystem, AddingChildComponentRegistersWithParent)
@@ -109,3 +115,121 @@ TEST(RelationshipSystem, DestroyingParentSurvivesASiblingCascadeDestroyingAnothe
     ASSERT_FALSE(childA.is_valid());
     ASSERT_FALSE(childB.is_valid());
 }
+
+TEST(RelationshipSystem, RemovingAMiddleChildMovesTheLastOneIntoItsSlot)
+{
+    Scene scene;
+    Entity parent = scene.create_entity();
+    std::vector<Entity> kids;
+
+    for(int i = 0; i < 5; i++){
+        kids.push_back(scene.create_entity());
+        kids.back().add_component<ChildComponent>(ChildComponent{parent});
+    }
+
+    kids[2].remove_component<ChildComponent>();
+
+    auto& children = parent.get_component<ParentComponent>().children;
+    ASSERT_EQ(children, (std::vector<Entity>{kids[0], kids[1], kids[4], kids[3]}));
+
+    for(std::size_t i = 0; i < children.size(); i++)
+        EXPECT_EQ(children[i].get_component<ChildComponent>().indexInParent, i);
+
+    // The moved sibling is still found through its updated index
+    kids[4].remove_component<ChildComponent>();
+    ASSERT_EQ(children, (std::vector<Entity>{kids[0], kids[1], kids[3]}));
+}
+
+TEST(RelationshipSystem, DetachingRewritesAtMostOneSiblingIndex)
+{
+    constexpr int COUNT = 1000;
+
+    Scene scene;
+    Entity parent = scene.create_entity();
+    std::vector<Entity> kids;
+
+    for(int i = 0; i < COUNT; i++){
+        kids.push_back(scene.create_entity());
+        kids.back().add_component<ChildComponent>(ChildComponent{parent});
+    }
+
+    // Oldest first, the order an erase would have to shift every remaining sibling for
+    for(int i = 0; i < COUNT; i++){
+        auto& children = parent.get_component<ParentComponent>().children;
+        std::vector<std::size_t> before;
+        for(Entity& child : children)
+            before.push_back(child.get_component<ChildComponent>().indexInParent);
+
+        std::vector<Entity> remaining(children.begin(), children.end());
+        kids[i].remove_component<ChildComponent>();
+
+        int rewritten = 0;
+        for(std::size_t j = 0; j < remaining.size(); j++){
+            if(remaining[j] != kids[i] && remaining[j].get_component<ChildComponent>().indexInParent != before[j])
+                rewritten++;
+        }
+
+        ASSERT_LE(rewritten, 1) << "detaching child " << i;
+    }
+
+    EXPECT_FALSE(parent.has_component<ParentComponent>());
+}
+
+TEST(RelationshipSystem, RemovingAChildAfterChildrenWasRewrittenStillWorks)
+{
+    Scene scene;
+    Entity parent = scene.create_entity();
+    Entity childA = scene.create_entity();
+    Entity childB = scene.create_entity();
+    childA.add_component<ChildComponent>(ChildComponent{parent});
+    childB.add_component<ChildComponent>(ChildComponent{parent});
+
+    // Rewritten directly (as deserializing over an existing ParentComponent does), so the
+    // stored indices no longer match
+    auto& children = parent.get_component<ParentComponent>().children;
+    std::reverse(children.begin(), children.end());
+
+    childA.remove_component<ChildComponent>();
+    ASSERT_EQ(children, (std::vector<Entity>{childB}));
+}
+
+TEST(RelationshipSystem, ReparentingALargeGroupKeepsEveryChildLinked)
+{
+    constexpr int COUNT = 10000;
+
+    Scene scene;
+    Entity from = scene.create_entity();
+    Entity to = scene.create_entity();
+    std::vector<Entity> bullets;
+
+    for(int i = 0; i < COUNT; i++){
+        bullets.push_back(scene.create_entity());
+        bullets.back().add_component<ChildComponent>(ChildComponent{from});
+    }
+
+    for(Entity& bullet : bullets){
+        bullet.remove_component<ChildComponent>();
+        bullet.add_component<ChildComponent>(ChildComponent{to});
+    }
+
+    ASSERT_FALSE(from.has_component<ParentComponent>());
+
+    // Nothing was removed from the destination, so it's in attach order
+    auto& children = to.get_component<ParentComponent>().children;
+    ASSERT_EQ(children, bullets);
+
+    for(std::size_t i = 0; i < children.size(); i++)
+        ASSERT_EQ(children[i].get_component<ChildComponent>().indexInParent, i);
+}
+
+TEST(RelationshipSystem, ListenerAccessCoversTheHierarchyAndWorldTransforms)
+{
+    SystemAccess listeners = RelationshipSystem::get_listener_access();
+
+    EXPECT_TRUE(listeners.conflicts_with(SystemAccess().read<ParentComponent>()));
+    EXPECT_TRUE(listeners.conflicts_with(SystemAccess().read<WorldTransformComponent>()));
+
+    // Local transforms are only read, by WorldTransformSystem
+    EXPECT_FALSE(listeners.conflicts_with(SystemAccess().read<TransformComponent>()));
+    EXPECT_TRUE(listeners.conflicts_with(SystemAccess().write<TransformComponent>()));
+}
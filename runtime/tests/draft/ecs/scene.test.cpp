@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
+#include "draft/asset/asset_manager.hpp"
 #include "draft/components/camera_component.hpp"
+#include "draft/components/tag_component.hpp"
 #include "draft/components/transform_component.hpp"
+#include "draft/core/engine.hpp"
 #include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
 #include "draft/ecs/scene.hpp"
 #include "draft/ecs/system.hpp"
 #include "draft/rendering/camera.hpp"
+#include "draft/util/reflectable.hpp"
 
+#include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 using namespace Draft;
 
@@ -32,6 +40,14 @@ namespace {
         int eventCalls = 0;
         bool on_event(const Event&) override { eventCalls++; return true; }
     };
+
+    // Reflected system data, including an entity reference, for snapshot()/restore()
+    struct FollowSystem : AbstractSystem {
+        DRAFT_REFLECTED(float, speed) = 1.f;
+        DRAFT_REFLECTED(Entity, target);
+
+        DRAFT_REFLECTABLE(FollowSystem, speed, target)
+    };
 }
 
 TEST(Scene, CreateEntityReturnsAValidEntityBoundToThisScene)
@@ -204,3 +220,160 @@ TEST(Scene, ClearingCameraOverrideFallsBackToCameraComponent)
 
     ASSERT_EQ(scene.get_active_camera(), &entity.get_component<CameraComponent>().camera);
 }
+
+TEST(Scene, PatchingAnotherCameraReselectsTheActiveOne)
+{
+    Scene scene;
+
+    Entity current = scene.create_entity();
+    current.add_component<CameraComponent>(CameraComponent{true, 0, make_ortho_camera(1.f)});
+
+    Entity standby = scene.create_entity();
+    standby.add_component<CameraComponent>(CameraComponent{false, 10, make_ortho_camera(2.f)});
+
+    ASSERT_EQ(scene.get_active_camera(), &current.get_component<CameraComponent>().camera);
+
+    standby.modify_component<CameraComponent>([](CameraComponent& cam){ cam.active = true; });
+    ASSERT_EQ(scene.get_active_camera(), &standby.get_component<CameraComponent>().camera);
+}
+
+TEST(Scene, RemovingTheActiveCameraFallsBackToTheNextBest)
+{
+    Scene scene;
+
+    Entity low = scene.create_entity();
+    low.add_component<CameraComponent>(CameraComponent{true, 0, make_ortho_camera(1.f)});
+
+    Entity high = scene.create_entity();
+    high.add_component<CameraComponent>(CameraComponent{true, 5, make_ortho_camera(2.f)});
+
+    ASSERT_EQ(scene.get_active_camera(), &high.get_component<CameraComponent>().camera);
+
+    high.destroy();
+    ASSERT_EQ(scene.get_active_camera(), &low.get_component<CameraComponent>().camera);
+
+    low.remove_component<CameraComponent>();
+    ASSERT_EQ(scene.get_active_camera(), nullptr);
+}
+
+TEST(Scene, DirectlyDeactivatingTheCachedCameraIsStillNoticed)
+{
+    Scene scene;
+
+    Entity low = scene.create_entity();
+    low.add_component<CameraComponent>(CameraComponent{true, 0, make_ortho_camera(1.f)});
+
+    Entity high = scene.create_entity();
+    high.add_component<CameraComponent>(CameraComponent{true, 5, make_ortho_camera(2.f)});
+
+    ASSERT_EQ(scene.get_active_camera(), &high.get_component<CameraComponent>().camera);
+
+    // Plain field write, no patch()
+    high.get_component<CameraComponent>().active = false;
+    ASSERT_EQ(scene.get_active_camera(), &low.get_component<CameraComponent>().camera);
+}
+
+TEST(Scene, RestoringASnapshotBringsBackEveryRegisteredComponentUnderTheSameIds)
+{
+    Engine engine;
+    engine.systems().register_system<FollowSystem>([](Scene&){ return std::make_unique<FollowSystem>(); });
+
+    AssetManager assets;
+    Scene scene;
+
+    std::vector<Entity> entities;
+    for(int i = 0; i < 200; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TagComponent>(TagComponent{"Entity" + std::to_string(i)});
+
+        if(i % 3 != 0)
+            entity.add_component<TransformComponent>(TransformComponent{{float(i), float(-i)}, i * 0.1f});
+
+        if(i % 5 == 4)
+            entity.add_component<ChildComponent>(ChildComponent{entities[i - 4]});
+
+        entities.push_back(entity);
+    }
+
+    FollowSystem& follow = scene.get_systems().add<FollowSystem>();
+    follow.speed = 4.f;
+    follow.target = entities[7];
+
+    const std::vector<entt::entity> transformOrder(
+        scene.get_registry().storage<TransformComponent>().data(),
+        scene.get_registry().storage<TransformComponent>().data() + scene.get_registry().storage<TransformComponent>().size());
+
+    SceneSnapshot snapshot = scene.snapshot(engine, assets);
+    ASSERT_FALSE(snapshot.empty());
+    ASSERT_EQ(snapshot.entity_count(), entities.size());
+
+    // Play: move things, destroy some, spawn others, drop the system
+    for(auto [raw, transform] : scene.get_registry().view<TransformComponent>().each())
+        transform.position.x += 100.f;
+
+    entities[10].get_component<TagComponent>().tag = "Renamed";
+    entities[2].destroy();
+    entities[9].remove_component<ChildComponent>();
+    entities[11].add_component<ChildComponent>(ChildComponent{entities[0]});
+
+    for(int i = 0; i < 50; i++)
+        scene.create_entity().add_component<TagComponent>(TagComponent{"Spawned"});
+
+    scene.get_systems().remove<FollowSystem>();
+
+    scene.restore(snapshot);
+
+    // Exactly the original entities, under their original handles
+    std::size_t alive = 0;
+    for(entt::entity raw : scene.get_registry().storage<entt::entity>())
+        alive += scene.get_registry().valid(raw);
+
+    ASSERT_EQ(alive, entities.size());
+
+    for(int i = 0; i < 200; i++){
+        Entity entity = entities[i];
+        ASSERT_TRUE(entity.is_valid()) << i;
+        EXPECT_EQ(entity.get_component<TagComponent>().tag, "Entity" + std::to_string(i));
+
+        ASSERT_EQ(entity.has_component<TransformComponent>(), i % 3 != 0) << i;
+        if(i % 3 != 0){
+            EXPECT_FLOAT_EQ(entity.get_component<TransformComponent>().position.x, float(i));
+            EXPECT_FLOAT_EQ(entity.get_component<TransformComponent>().position.y, float(-i));
+            EXPECT_FLOAT_EQ(entity.get_component<TransformComponent>().rotation, i * 0.1f);
+        }
+
+        ASSERT_EQ(entity.has_component<ChildComponent>(), i % 5 == 4) << i;
+        if(i % 5 == 4)
+            EXPECT_EQ(entity.get_component<ChildComponent>().parent, entities[i - 4]);
+
+        if(i % 5 == 0){
+            // Each parent's children rebuilt exactly once, not duplicated by the construct hooks
+            ASSERT_TRUE(entity.has_component<ParentComponent>()) << i;
+            ASSERT_EQ(entity.get_component<ParentComponent>().children.size(), 1u);
+            EXPECT_EQ(entity.get_component<ParentComponent>().children[0], entities[i + 4]);
+        } else {
+            EXPECT_FALSE(entity.has_component<ParentComponent>()) << i;
+        }
+    }
+
+    // Storage order survives too, so views iterate in the same order as before
+    const auto& transforms = scene.get_registry().storage<TransformComponent>();
+    EXPECT_EQ(std::vector<entt::entity>(transforms.data(), transforms.data() + transforms.size()), transformOrder);
+
+    ASSERT_TRUE(scene.get_systems().has<FollowSystem>());
+    EXPECT_FLOAT_EQ(scene.get_systems().get<FollowSystem>().speed, 4.f);
+    EXPECT_EQ(scene.get_systems().get<FollowSystem>().target, entities[7]);
+}
+
+TEST(Scene, RestoreRejectsASnapshotFromAnotherScene)
+{
+    Engine engine;
+    AssetManager assets;
+
+    Scene scene;
+    Scene other;
+
+    SceneSnapshot snapshot = other.snapshot(engine, assets);
+    EXPECT_THROW(scene.restore(snapshot), std::runtime_error);
+    EXPECT_THROW(scene.restore(SceneSnapshot{}), std::runtime_error);
+}
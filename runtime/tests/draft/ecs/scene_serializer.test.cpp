@@ -15,9 +15,15 @@
 #include "draft/physics/shapes/circle_shape.hpp"
 #include "draft/physics/world.hpp"
 #include "draft/util/files/disk_file_provider.hpp"
+#include "draft/util/json.hpp"
+#include "draft/util/serialization/serializer.hpp"
 #include "../audio/wav_test_helper.hpp"
 
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace Draft;
 using namespace Draft::Testing;
@@ -34,6 +40,13 @@ namespace {
         DRAFT_REFLECTABLE(GravitySystem, strength)
     };
 
+    // A component only the saving side registers, to check a whole unknown column is skipped
+    struct HealthComponent {
+        DRAFT_REFLECTED(float, hitPoints) = 100.f;
+
+        DRAFT_REFLECTABLE(HealthComponent, hitPoints)
+    };
+
     // Finds the live entity carrying a TagComponent equal to @p tag, or an invalid Entity if none does.
     Entity find_by_tag(Scene& scene, const std::string& tag){
         for(entt::entity raw : scene.get_registry().storage<entt::entity>()){
@@ -256,6 +269,149 @@ TEST(SceneSerializer, PhysicsBodyAndColliderMaterializeAutomaticallyOnLoad)
     EXPECT_TRUE(loaded.get_component<ColliderComponent>().collider.is_attached());
 }
 
+namespace {
+    struct ConstructionCounter {
+        int count = 0;
+
+        void on_construct(Registry&, entt::entity){ count++; }
+    };
+}
+
+TEST(SceneSerializer, BodiesInASecondWorldRoundTrip)
+{
+    AssetManager assets;
+    World first({0.f, 0.f});
+    World second({0.f, 0.f});
+
+    // The extra world isn't part of the file, whatever builds the PhysicsSystem adds it
+    Engine engine;
+    engine.systems().register_system<PhysicsSystem>([&](Scene& scene){
+        auto system = std::make_unique<PhysicsSystem>(scene, first);
+        system->add_world(second);
+        return system;
+    });
+
+    Scene scene;
+    engine.systems().by_type<PhysicsSystem>()->add(scene);
+
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>(TransformComponent{{3.f, 4.f}, 0.f});
+    entity.add_component<RigidBodyComponent>(RigidBodyComponent{.type = BodyType::DYNAMIC});
+    entity.add_component<PhysicsWorldComponent>(PhysicsWorldComponent{1});
+    ASSERT_EQ(second.get_body_count(), 1u);
+
+    FileHandle json = DiskFileProvider().open("scene_serializer_second_world.json");
+    FileHandle binary = DiskFileProvider().open("scene_serializer_second_world.bin");
+    save_scene(scene, engine, assets, json);
+    save_scene_binary(scene, engine, assets, binary);
+    entity.destroy();
+    ASSERT_EQ(second.get_body_count(), 0u);
+
+    // Built straight into its own world, never in world 0 first
+    {
+        Scene loaded;
+        ConstructionCounter bodiesBuilt;
+        loaded.get_registry().on_construct<NativeBodyComponent>().connect<&ConstructionCounter::on_construct>(bodiesBuilt);
+
+        load_scene(loaded, engine, assets, json);
+        EXPECT_EQ(bodiesBuilt.count, 1);
+        EXPECT_EQ(first.get_body_count(), 0u);
+        EXPECT_EQ(second.get_body_count(), 1u);
+
+        // Systems don't take their bodies with them when the scene goes away
+        auto view = loaded.get_registry().view<NativeBodyComponent>();
+        std::vector<entt::entity> bodies(view.begin(), view.end());
+        loaded.get_registry().destroy(bodies.begin(), bodies.end());
+        ASSERT_EQ(second.get_body_count(), 0u);
+    }
+
+    // Without the world added, the body waits in world 0 rather than failing the load
+    Engine plainEngine;
+    plainEngine.systems().register_system<PhysicsSystem>([&](Scene& scene){ return std::make_unique<PhysicsSystem>(scene, first); });
+
+    Scene loaded;
+    ASSERT_NO_THROW(load_scene_binary(loaded, plainEngine, assets, binary));
+    EXPECT_EQ(first.get_body_count(), 1u);
+    EXPECT_EQ(second.get_body_count(), 0u);
+
+    loaded.get_systems().get<PhysicsSystem>().add_world(second);
+    EXPECT_EQ(first.get_body_count(), 0u);
+    ASSERT_EQ(second.get_body_count(), 1u);
+
+    for(auto [raw, native] : loaded.get_registry().view<NativeBodyComponent>().each()){
+        EXPECT_FLOAT_EQ(native->get_position().x, 3.f);
+        EXPECT_FLOAT_EQ(native->get_position().y, 4.f);
+    }
+
+    json.remove();
+    binary.remove();
+}
+
+TEST(SceneSerializer, CompactJsonHoldsTheSameDocumentAndLoadsTheSame)
+{
+    Engine engine;
+    engine.systems().register_system<GravitySystem>([](Scene&){ return std::make_unique<GravitySystem>(); });
+
+    AssetManager assets;
+
+    Scene scene;
+    scene.get_systems().add<GravitySystem>().strength = 3.f;
+
+    // Enough entities that the writer flushes to the file more than once
+    Entity root = scene.create_entity();
+    root.add_component<TagComponent>(TagComponent{"Root"});
+
+    for(int i = 0; i < 2000; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TagComponent>(TagComponent{"Entity" + std::to_string(i)});
+        entity.add_component<TransformComponent>(TransformComponent{{float(i), 1.f}, 0.f});
+        entity.add_component<ChildComponent>(ChildComponent{root});
+    }
+
+    FileHandle pretty = DiskFileProvider().open("scene_serializer_pretty.json");
+    FileHandle compact = DiskFileProvider().open("scene_serializer_compact.json");
+    save_scene(scene, engine, assets, pretty);
+
+    SceneSaveOptions options;
+    options.compact = true;
+    save_scene(scene, engine, assets, compact, options);
+
+    std::string compactText = compact.read_string();
+    EXPECT_EQ(compactText.find('\n'), std::string::npos);
+    EXPECT_LT(compactText.size(), pretty.read_string().size());
+    EXPECT_EQ(JSON(compact), JSON(pretty));
+
+    Scene loaded;
+    load_scene(loaded, engine, assets, compact);
+    pretty.remove();
+    compact.remove();
+
+    ASSERT_TRUE(loaded.get_systems().has<GravitySystem>());
+    EXPECT_FLOAT_EQ(loaded.get_systems().get<GravitySystem>().strength, 3.f);
+
+    Entity loadedRoot = find_by_tag(loaded, "Root");
+    ASSERT_TRUE(loadedRoot.is_valid());
+    ASSERT_EQ(loadedRoot.get_component<ParentComponent>().children.size(), 2000u);
+
+    Entity last = find_by_tag(loaded, "Entity1999");
+    ASSERT_TRUE(last.is_valid());
+    EXPECT_FLOAT_EQ(last.get_component<TransformComponent>().position.x, 1999.f);
+    EXPECT_EQ(last.get_component<ChildComponent>().parent, loadedRoot);
+}
+
+TEST(SceneSerializer, JsonWithoutEntitiesIsRejected)
+{
+    Engine engine;
+    AssetManager assets;
+
+    FileHandle file = DiskFileProvider().open("scene_serializer_not_a_scene.json");
+    file.write_string(R"({"systems": []})");
+
+    Scene loaded;
+    EXPECT_THROW(load_scene(loaded, engine, assets, file), std::runtime_error);
+    file.remove();
+}
+
 TEST(SceneSerializer, SoundComponentRoundTripsItsBufferAsAResourceKey)
 {
     Engine engine;
@@ -338,3 +494,190 @@ TEST(SceneSerializer, StoppingWithALiveJointDoesNotCrash)
 
     EXPECT_EQ(world.get_body_count(), 2u);
 }
+
+TEST(SceneSerializer, BinaryLoadsFilesWrittenInTheVersionOneLayout)
+{
+    Engine engine;
+    AssetManager assets;
+
+    // Version 1: system count, entity count, then per entity a component count and
+    // name + byte length + blob for each component
+    Binary::ByteArray bytes;
+    Serializer::serialize(uint32_t(0), bytes);
+    Serializer::serialize(uint32_t(1), bytes);
+    Serializer::serialize(uint32_t(2), bytes);
+
+    Binary::ByteArray tagData;
+    Serializer::serialize(TagComponent{"Legacy"}, tagData);
+    Serializer::serialize(std::string(TagComponent::reflect_name()), bytes);
+    Serializer::serialize(static_cast<uint64_t>(tagData.size()), bytes);
+    bytes.insert(bytes.end(), tagData.begin(), tagData.end());
+
+    Binary::ByteArray unknownData(3, std::byte{0xAB});
+    Serializer::serialize(std::string("NoSuchComponent"), bytes);
+    Serializer::serialize(static_cast<uint64_t>(unknownData.size()), bytes);
+    bytes.insert(bytes.end(), unknownData.begin(), unknownData.end());
+
+    FileHandle file = DiskFileProvider().open("scene_serializer_v1.bin");
+    file.write_bytes(bytes);
+
+    Scene loaded;
+    ASSERT_NO_THROW(load_scene_binary(loaded, engine, assets, file));
+    file.remove();
+
+    EXPECT_TRUE(find_by_tag(loaded, "Legacy").is_valid());
+}
+
+TEST(SceneSerializer, BinarySkipsAWholeColumnOfAnUnregisteredComponent)
+{
+    Engine saver;
+    saver.components().register_component<HealthComponent>();
+
+    Engine loader;
+    AssetManager assets;
+
+    Scene scene;
+    for(int i = 0; i < 3; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<HealthComponent>();
+        entity.add_component<TagComponent>(TagComponent{"Unit" + std::to_string(i)});
+    }
+
+    FileHandle file = DiskFileProvider().open("scene_serializer_unknown_column.bin");
+    save_scene_binary(scene, saver, assets, file);
+
+    Scene loaded;
+    ASSERT_NO_THROW(load_scene_binary(loaded, loader, assets, file));
+    file.remove();
+
+    for(int i = 0; i < 3; i++){
+        Entity entity = find_by_tag(loaded, "Unit" + std::to_string(i));
+        ASSERT_TRUE(entity.is_valid());
+        EXPECT_FALSE(entity.has_component<HealthComponent>());
+    }
+}
+
+TEST(SceneSerializer, BinaryRoundTripsWholePoolsOfBulkCopyableComponents)
+{
+    Engine engine;
+    engine.components().register_component<HealthComponent>();
+    ASSERT_TRUE(engine.components().by_type<TransformComponent>()->is_bulk_copyable());
+    ASSERT_FALSE(engine.components().by_type<ChildComponent>()->is_bulk_copyable());
+
+    AssetManager assets;
+
+    // Spans several EnTT pages, with a few holes punched in so the packed order isn't creation order
+    Scene scene;
+    std::vector<Entity> entities;
+    for(int i = 0; i < 3000; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TagComponent>(TagComponent{"Unit" + std::to_string(i)});
+        entity.add_component<TransformComponent>(TransformComponent{{float(i), float(-i)}, i * 0.01f});
+
+        if(i % 3 == 0)
+            entity.add_component<HealthComponent>(HealthComponent{float(i) + 0.5f});
+
+        entities.push_back(entity);
+    }
+
+    for(int i = 0; i < 3000; i += 7)
+        entities[i].remove_component<TransformComponent>();
+
+    FileHandle file = DiskFileProvider().open("scene_serializer_bulk_pools.bin");
+    save_scene_binary(scene, engine, assets, file);
+
+    Scene loaded;
+    load_scene_binary(loaded, engine, assets, file);
+    file.remove();
+
+    ASSERT_EQ(loaded.get_registry().storage<TransformComponent>().size(), scene.get_registry().storage<TransformComponent>().size());
+
+    std::unordered_map<std::string, Entity> byTag;
+    for(auto [raw, tag] : loaded.get_registry().view<TagComponent>().each())
+        byTag[tag.tag] = Entity(&loaded, raw);
+
+    for(int i = 0; i < 3000; i++){
+        Entity entity = byTag["Unit" + std::to_string(i)];
+        ASSERT_TRUE(entity.is_valid());
+
+        ASSERT_EQ(entity.has_component<TransformComponent>(), i % 7 != 0);
+        if(i % 7 != 0){
+            const auto& transform = entity.get_component<TransformComponent>();
+            EXPECT_FLOAT_EQ(transform.position.x, float(i));
+            EXPECT_FLOAT_EQ(transform.position.y, float(-i));
+            EXPECT_FLOAT_EQ(transform.rotation, i * 0.01f);
+        }
+
+        ASSERT_EQ(entity.has_component<HealthComponent>(), i % 3 == 0);
+        if(i % 3 == 0)
+            EXPECT_FLOAT_EQ(entity.get_component<HealthComponent>().hitPoints, float(i) + 0.5f);
+    }
+}
+
+TEST(SceneSerializer, ParallelDecodeLoadsTheSameSceneAsASerialLoad)
+{
+    Engine engine;
+    engine.components().register_component<HealthComponent>();
+
+    AssetManager assets;
+
+    // Enough entities for several decode chunks per type, with cross-references between them
+    Scene scene;
+    std::vector<Entity> entities;
+    for(int i = 0; i < 10000; i++){
+        Entity entity = scene.create_entity();
+        entity.add_component<TagComponent>(TagComponent{"Unit" + std::to_string(i)});
+        entity.add_component<HealthComponent>(HealthComponent{float(i)});
+
+        if(i % 10 != 0)
+            entity.add_component<ChildComponent>(ChildComponent{entities[i - i % 10]});
+
+        entities.push_back(entity);
+    }
+
+    FileHandle json = DiskFileProvider().open("scene_serializer_parallel.json");
+    FileHandle binary = DiskFileProvider().open("scene_serializer_parallel.bin");
+    save_scene(scene, engine, assets, json);
+    save_scene_binary(scene, engine, assets, binary);
+
+    auto expect_same = [](Scene& serial, Scene& parallel){
+        std::unordered_map<std::string, Entity> byTag;
+        for(auto [raw, tag] : parallel.get_registry().view<TagComponent>().each())
+            byTag[tag.tag] = Entity(&parallel, raw);
+
+        ASSERT_EQ(byTag.size(), 10000u);
+
+        for(auto [raw, tag] : serial.get_registry().view<TagComponent>().each()){
+            Entity expected(&serial, raw);
+            Entity actual = byTag.at(tag.tag);
+
+            ASSERT_FLOAT_EQ(actual.get_component<HealthComponent>().hitPoints, expected.get_component<HealthComponent>().hitPoints);
+            ASSERT_EQ(actual.has_component<ChildComponent>(), expected.has_component<ChildComponent>());
+
+            if(expected.has_component<ParentComponent>()){
+                const auto& expectedChildren = expected.get_component<ParentComponent>().children;
+                const auto& actualChildren = actual.get_component<ParentComponent>().children;
+                ASSERT_EQ(actualChildren.size(), expectedChildren.size());
+
+                for(std::size_t c = 0; c < expectedChildren.size(); c++){
+                    Entity expectedChild = expectedChildren[c];
+                    Entity actualChild = actualChildren[c];
+                    ASSERT_EQ(actualChild.get_component<TagComponent>().tag, expectedChild.get_component<TagComponent>().tag);
+                }
+            }
+        }
+    };
+
+    Scene serialJson, parallelJson;
+    load_scene(serialJson, engine, assets, json);
+    load_scene(parallelJson, engine, assets, json, SceneLoadOptions{4});
+    expect_same(serialJson, parallelJson);
+
+    Scene serialBinary, parallelBinary;
+    load_scene_binary(serialBinary, engine, assets, binary);
+    load_scene_binary(parallelBinary, engine, assets, binary, SceneLoadOptions{4});
+    expect_same(serialBinary, parallelBinary);
+
+    json.remove();
+    binary.remove();
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "draft/ecs/scene_stream_loader.hpp"
+#include "draft/asset/asset_manager.hpp"
+#include "draft/components/tag_component.hpp"
+#include "draft/components/transform_component.hpp"
+#include "draft/core/engine.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+#include "draft/ecs/scene_serializer.hpp"
+#include "draft/util/files/disk_file_provider.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Draft;
+
+namespace {
+    // A few thousand entities in families of four, enough for many pump() steps
+    void populate(Scene& scene, int count){
+        std::vector<Entity> entities;
+
+        for(int i = 0; i < count; i++){
+            Entity entity = scene.create_entity();
+            entity.add_component<TagComponent>(TagComponent{"Unit" + std::to_string(i)});
+            entity.add_component<TransformComponent>(TransformComponent{{float(i), 0.f}, 0.f});
+
+            if(i % 4 != 0)
+                entity.add_component<ChildComponent>(ChildComponent{entities[i - i % 4]});
+
+            entities.push_back(entity);
+        }
+    }
+
+    std::unordered_map<std::string, Entity> by_tag(Scene& scene){
+        std::unordered_map<std::string, Entity> result;
+        for(auto [raw, tag] : scene.get_registry().view<TagComponent>().each())
+            result[tag.tag] = Entity(&scene, raw);
+
+        return result;
+    }
+}
+
+TEST(SceneStreamLoader, PumpingToCompletionMatchesAOneShotLoad)
+{
+    Engine engine;
+    AssetManager assets;
+
+    Scene scene;
+    populate(scene, 5000);
+
+    FileHandle file = DiskFileProvider().open("scene_stream_loader.bin");
+    save_scene_binary(scene, engine, assets, file);
+
+    Scene streamed;
+    SceneStreamLoader loader(streamed, engine, assets, file);
+
+    int completions = 0;
+    loader.set_completion_callback([&](Scene& s){
+        EXPECT_EQ(&s, &streamed);
+        completions++;
+    });
+
+    int pumps = 0;
+    float lastProgress = 0.f;
+
+    while(!loader.pump(Time::microseconds(0))){
+        pumps++;
+
+        // Nothing staged is visible before the load finishes
+        ASSERT_EQ(streamed.get_registry().view<TagComponent>().size_hint(), 0u);
+        ASSERT_GE(loader.get_progress(), lastProgress);
+        lastProgress = loader.get_progress();
+    }
+
+    EXPECT_GT(pumps, 10);
+    EXPECT_EQ(completions, 1);
+    EXPECT_FLOAT_EQ(loader.get_progress(), 1.f);
+
+    Scene oneShot;
+    load_scene_binary(oneShot, engine, assets, file);
+    file.remove();
+
+    auto expected = by_tag(oneShot);
+    auto actual = by_tag(streamed);
+    ASSERT_EQ(actual.size(), expected.size());
+
+    for(auto& [tag, expectedEntity] : expected){
+        Entity entity = actual.at(tag);
+
+        EXPECT_FLOAT_EQ(entity.get_component<TransformComponent>().position.x, expectedEntity.get_component<TransformComponent>().position.x);
+        ASSERT_EQ(entity.has_component<ChildComponent>(), expectedEntity.has_component<ChildComponent>());
+
+        if(entity.has_component<ChildComponent>()){
+            // References point into the live scene, not the staging registry
+            Entity parent = entity.get_component<ChildComponent>().parent;
+            Entity expectedParent = expectedEntity.get_component<ChildComponent>().parent;
+            EXPECT_EQ(parent.get_scene(), &streamed);
+            EXPECT_EQ(parent.get_component<TagComponent>().tag, expectedParent.get_component<TagComponent>().tag);
+        }
+
+        if(expectedEntity.has_component<ParentComponent>())
+            EXPECT_EQ(entity.get_component<ParentComponent>().children.size(), expectedEntity.get_component<ParentComponent>().children.size());
+    }
+}
+
+TEST(SceneStreamLoader, AGenerousBudgetFinishesInOnePump)
+{
+    Engine engine;
+    AssetManager assets;
+
+    Scene scene;
+    populate(scene, 100);
+
+    FileHandle file = DiskFileProvider().open("scene_stream_loader_one_pump.bin");
+    save_scene_binary(scene, engine, assets, file);
+
+    Scene streamed;
+    SceneStreamLoader loader(streamed, engine, assets, file);
+    EXPECT_TRUE(loader.pump(Time::seconds(10.f)));
+    EXPECT_TRUE(loader.is_finished());
+    file.remove();
+
+    EXPECT_EQ(by_tag(streamed).size(), 100u);
+}
+
+TEST(SceneStreamLoader, AbandoningALoadRemovesItsEntities)
+{
+    Engine engine;
+    AssetManager assets;
+
+    Scene scene;
+    populate(scene, 3000);
+
+    FileHandle file = DiskFileProvider().open("scene_stream_loader_abandoned.bin");
+    save_scene_binary(scene, engine, assets, file);
+
+    Scene streamed;
+    Entity existing = streamed.create_entity();
+
+    {
+        SceneStreamLoader loader(streamed, engine, assets, file);
+        loader.pump(Time::microseconds(0));
+        loader.pump(Time::microseconds(0));
+        ASSERT_FALSE(loader.is_finished());
+    }
+
+    file.remove();
+
+    std::size_t alive = 0;
+    for(entt::entity raw : streamed.get_registry().storage<entt::entity>())
+        alive += streamed.get_registry().valid(raw);
+
+    EXPECT_EQ(alive, 1u);
+    EXPECT_TRUE(streamed.get_registry().valid(existing));
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include "draft/ecs/system.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace Draft;
@@ -25,6 +28,60 @@ namespace {
         int calls = 0;
         void update(Time) override { calls++; }
     };
+
+    struct ComponentA {};
+    struct ComponentB {};
+
+    // Stamps when update() started and finished on a shared counter, so tests can check which
+    // systems overlapped. Templated purely so each instantiation is its own registry key.
+    template<int N>
+    struct TimedSystem : AbstractSystem {
+        std::atomic<int>* clock;
+        std::optional<SystemAccess> access;
+        std::chrono::milliseconds work;
+        int started = -1;
+        int finished = -1;
+        std::thread::id thread;
+
+        TimedSystem(std::atomic<int>& clock, std::optional<SystemAccess> access, std::chrono::milliseconds work = std::chrono::milliseconds(0))
+            : clock(&clock), access(std::move(access)), work(work) {}
+
+        void update(Time) override {
+            started = (*clock)++;
+            thread = std::this_thread::get_id();
+            std::this_thread::sleep_for(work);
+            finished = (*clock)++;
+        }
+
+        std::optional<SystemAccess> get_access() const override { return access; }
+    };
+
+    // Waits (bounded) for `expected` systems to be inside update() at the same time
+    template<int N>
+    struct RendezvousSystem : AbstractSystem {
+        std::atomic<int>* inside;
+        int expected;
+        bool metOthers = false;
+
+        RendezvousSystem(std::atomic<int>& inside, int expected) : inside(&inside), expected(expected) {}
+
+        void update(Time) override {
+            (*inside)++;
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while(*inside < expected && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::yield();
+
+            metOthers = *inside >= expected;
+        }
+
+        std::optional<SystemAccess> get_access() const override { return SystemAccess().read<ComponentA>(); }
+    };
+
+    struct ThrowingSystem : AbstractSystem {
+        void update(Time) override { throw std::runtime_error("update failed"); }
+        std::optional<SystemAccess> get_access() const override { return SystemAccess().write<ComponentA>(); }
+    };
 }
 
 TEST(SystemRegistry, AddReturnsAReferenceToTheConstructedSystem)
@@ -437,3 +494,85 @@ TEST(SystemRegistry, DispatchEventStopsAtTheFirstSystemThatConsumesIt)
     EXPECT_EQ(systems.get<ConsumingSystem>().eventCalls, 1);
     EXPECT_EQ(systems.get<ObservingSystem>().eventCalls, 0);
 }
+
+TEST(SystemAccess, ConflictsOnlyWhenSomeoneWrites)
+{
+    auto readA = SystemAccess().read<ComponentA>();
+    auto writeA = SystemAccess().write<ComponentA>();
+    auto writeB = SystemAccess().write<ComponentB>();
+
+    EXPECT_FALSE(readA.conflicts_with(readA));
+    EXPECT_TRUE(readA.conflicts_with(writeA));
+    EXPECT_TRUE(writeA.conflicts_with(readA));
+    EXPECT_TRUE(writeA.conflicts_with(writeA));
+    EXPECT_FALSE(writeA.conflicts_with(writeB));
+}
+
+TEST(SystemRegistry, ParallelUpdateKeepsConflictingSystemsInRegistrationOrder)
+{
+    std::atomic<int> clock = 0;
+    SystemRegistry systems;
+    systems.set_worker_threads(4);
+
+    auto& writer = systems.add<TimedSystem<0>>(clock, SystemAccess().write<ComponentA>(), std::chrono::milliseconds(20));
+    auto& reader = systems.add<TimedSystem<1>>(clock, SystemAccess().read<ComponentA>(), std::chrono::milliseconds(20));
+    auto& rewriter = systems.add<TimedSystem<2>>(clock, SystemAccess().write<ComponentA>());
+    auto& unrelated = systems.add<TimedSystem<3>>(clock, SystemAccess().write<ComponentB>());
+
+    systems.update_all(Time::seconds(1.f / 60.f));
+
+    EXPECT_GT(reader.started, writer.finished);
+    EXPECT_GT(rewriter.started, reader.finished);
+    EXPECT_GE(unrelated.finished, 0);
+}
+
+TEST(SystemRegistry, ParallelUpdateRunsNonConflictingSystemsConcurrently)
+{
+    std::atomic<int> inside = 0;
+    SystemRegistry systems;
+    systems.set_worker_threads(2);
+
+    auto& first = systems.add<RendezvousSystem<0>>(inside, 2);
+    auto& second = systems.add<RendezvousSystem<1>>(inside, 2);
+
+    systems.update_all(Time::seconds(1.f / 60.f));
+
+    EXPECT_TRUE(first.metOthers);
+    EXPECT_TRUE(second.metOthers);
+}
+
+TEST(SystemRegistry, UndeclaredSystemsAreSerialBarriersOnTheCallingThread)
+{
+    std::atomic<int> clock = 0;
+    SystemRegistry systems;
+    systems.set_worker_threads(4);
+
+    auto& before = systems.add<TimedSystem<0>>(clock, SystemAccess().write<ComponentA>(), std::chrono::milliseconds(20));
+    auto& barrier = systems.add<TimedSystem<1>>(clock, std::nullopt);
+    auto& after = systems.add<TimedSystem<2>>(clock, SystemAccess().write<ComponentB>());
+
+    systems.update_all(Time::seconds(1.f / 60.f));
+
+    EXPECT_GT(barrier.started, before.finished);
+    EXPECT_GT(after.started, barrier.finished);
+    EXPECT_EQ(barrier.thread, std::this_thread::get_id());
+}
+
+TEST(SystemRegistry, ParallelUpdateRethrowsAndSkipsDependents)
+{
+    std::atomic<int> clock = 0;
+    SystemRegistry systems;
+    systems.set_worker_threads(2);
+
+    systems.add<ThrowingSystem>();
+    auto& dependent = systems.add<TimedSystem<0>>(clock, SystemAccess().read<ComponentA>());
+    systems.add<TimedSystem<1>>(clock, SystemAccess().write<ComponentB>());
+
+    ASSERT_THROW(systems.update_all(Time::seconds(1.f / 60.f)), std::runtime_error);
+    EXPECT_EQ(dependent.started, -1);
+
+    // The registry stays usable afterwards
+    systems.remove<ThrowingSystem>();
+    ASSERT_NO_THROW(systems.update_all(Time::seconds(1.f / 60.f)));
+    EXPECT_GE(dependent.started, 0);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "draft/components/transform_component.hpp"
+#include "draft/components/world_transform_component.hpp"
+#include "draft/ecs/entity.hpp"
+#include "draft/ecs/relationship_components.hpp"
+#include "draft/ecs/scene.hpp"
+
+#include <numbers>
+
+using namespace Draft;
+
+namespace {
+    constexpr float HALF_PI = std::numbers::pi_v<float> / 2.f;
+
+    void expect_pose(Entity entity, Vector2f position, float rotation){
+        auto& world = entity.get_component<WorldTransformComponent>();
+        EXPECT_NEAR(world.position.x, position.x, 1e-4f);
+        EXPECT_NEAR(world.position.y, position.y, 1e-4f);
+        EXPECT_NEAR(world.rotation, rotation, 1e-4f);
+
+        Vector3f origin = world.matrix * Vector3f(0.f, 0.f, 1.f);
+        EXPECT_NEAR(origin.x, position.x, 1e-4f);
+        EXPECT_NEAR(origin.y, position.y, 1e-4f);
+    }
+}
+
+TEST(WorldTransformSystem, RootWorldTransformMatchesLocal)
+{
+    Scene scene;
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>(TransformComponent{{3.f, 4.f}, 0.5f});
+
+    ASSERT_TRUE(entity.has_component<WorldTransformComponent>());
+    scene.update_world_transforms();
+    expect_pose(entity, {3.f, 4.f}, 0.5f);
+}
+
+TEST(WorldTransformSystem, ChildComposesWithParentPose)
+{
+    Scene scene;
+    Entity parent = scene.create_entity();
+    parent.add_component<TransformComponent>(TransformComponent{{10.f, 0.f}, HALF_PI});
+
+    Entity child = scene.create_entity();
+    child.add_component<TransformComponent>(TransformComponent{{1.f, 0.f}, 0.25f});
+    child.add_component<ChildComponent>(ChildComponent{parent});
+
+    scene.update_world_transforms();
+    expect_pose(child, {10.f, 1.f}, HALF_PI + 0.25f);
+}
+
+TEST(WorldTransformSystem, DirectlyWrittenParentMovesWholeSubtree)
+{
+    Scene scene;
+    Entity root = scene.create_entity();
+    root.add_component<TransformComponent>(TransformComponent{{0.f, 0.f}, 0.f});
+
+    Entity child = scene.create_entity();
+    child.add_component<TransformComponent>(TransformComponent{{1.f, 0.f}, 0.f});
+    child.add_component<ChildComponent>(ChildComponent{root});
+
+    Entity grandchild = scene.create_entity();
+    grandchild.add_component<TransformComponent>(TransformComponent{{0.f, 2.f}, 0.f});
+    grandchild.add_component<ChildComponent>(ChildComponent{child});
+
+    scene.update_world_transforms();
+    expect_pose(grandchild, {1.f, 2.f}, 0.f);
+
+    // Plain field write, no patch()
+    root.get_component<TransformComponent>().position = {5.f, 5.f};
+    scene.update(Time::seconds(1.f / 60.f));
+
+    expect_pose(child, {6.f, 5.f}, 0.f);
+    expect_pose(grandchild, {6.f, 7.f}, 0.f);
+}
+
+TEST(WorldTransformSystem, PatchedChildOnlyRecomputesItsOwnSubtree)
+{
+    Scene scene;
+    Entity root = scene.create_entity();
+    root.add_component<TransformComponent>(TransformComponent{{1.f, 0.f}, 0.f});
+
+    Entity a = scene.create_entity();
+    a.add_component<TransformComponent>(TransformComponent{{0.f, 1.f}, 0.f});
+    a.add_component<ChildComponent>(ChildComponent{root});
+
+    Entity b = scene.create_entity();
+    b.add_component<TransformComponent>(TransformComponent{{0.f, -1.f}, 0.f});
+    b.add_component<ChildComponent>(ChildComponent{root});
+
+    scene.update_world_transforms();
+
+    // Corrupt b's cached pose, an untouched sibling must not be recomputed
+    b.get_component<WorldTransformComponent>().position = {99.f, 99.f};
+    a.modify_component<TransformComponent>([](TransformComponent& t){ t.position = {0.f, 3.f}; });
+    scene.update_world_transforms();
+
+    expect_pose(a, {1.f, 3.f}, 0.f);
+    EXPECT_EQ(b.get_component<WorldTransformComponent>().position, Vector2f(99.f, 99.f));
+}
+
+TEST(WorldTransformSystem, ReparentingAndUnparentingRefreshThePose)
+{
+    Scene scene;
+    Entity first = scene.create_entity();
+    first.add_component<TransformComponent>(TransformComponent{{10.f, 0.f}, 0.f});
+
+    Entity second = scene.create_entity();
+    second.add_component<TransformComponent>(TransformComponent{{0.f, 10.f}, 0.f});
+
+    Entity child = scene.create_entity();
+    child.add_component<TransformComponent>(TransformComponent{{1.f, 1.f}, 0.f});
+    child.add_component<ChildComponent>(ChildComponent{first});
+
+    scene.update_world_transforms();
+    expect_pose(child, {11.f, 1.f}, 0.f);
+
+    child.remove_component<ChildComponent>();
+    child.add_component<ChildComponent>(ChildComponent{second});
+    scene.update_world_transforms();
+    expect_pose(child, {1.f, 11.f}, 0.f);
+
+    child.remove_component<ChildComponent>();
+    scene.update_world_transforms();
+    expect_pose(child, {1.f, 1.f}, 0.f);
+}
+
+TEST(WorldTransformSystem, TransformlessAncestorCountsAsIdentity)
+{
+    Scene scene;
+    Entity root = scene.create_entity();
+    root.add_component<TransformComponent>(TransformComponent{{2.f, 0.f}, 0.f});
+
+    Entity group = scene.create_entity(); // No TransformComponent
+    group.add_component<ChildComponent>(ChildComponent{root});
+
+    Entity leaf = scene.create_entity();
+    leaf.add_component<TransformComponent>(TransformComponent{{0.f, 3.f}, 0.f});
+    leaf.add_component<ChildComponent>(ChildComponent{group});
+
+    scene.update_world_transforms();
+    expect_pose(leaf, {2.f, 3.f}, 0.f);
+
+    root.get_component<TransformComponent>().position = {4.f, 0.f};
+    scene.update_world_transforms();
+    expect_pose(leaf, {4.f, 3.f}, 0.f);
+}
+
+TEST(WorldTransformSystem, RemovingTransformRemovesWorldTransform)
+{
+    Scene scene;
+    Entity entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+
+    entity.remove_component<TransformComponent>();
+    EXPECT_FALSE(entity.has_component<WorldTransformComponent>());
+    EXPECT_NO_THROW(scene.update_world_transforms());
+}
@@ -8,6 +8,8 @@
 
 #include "GLFW/glfw3.h"
 
+#include <stdexcept>
+
 using namespace Draft;
 
 // Real hardware input can't be driven in a test (see keyboard.test.cpp/mouse.test.cpp), so this
@@ -87,6 +89,49 @@ TEST_F(InputManagerTest, UnknownActionReportsNotPressed)
     EXPECT_TRUE(input.get_bindings("Missing").empty());
 }
 
+TEST_F(InputManagerTest, StringIdQueriesSeeTheSameActionsAsNames)
+{
+    GlfwKeyboard keyboard(*window);
+    GlfwMouse mouse(*window);
+    InputManager input(keyboard, mouse);
+
+    input.bind_default("Jump", {InputSource::Keyboard, Keyboard::SPACE});
+
+    EXPECT_TRUE(input.has_action("Jump"_sid));
+    EXPECT_FALSE(input.has_action("Missing"_sid));
+    ASSERT_EQ(input.get_bindings("Jump"_sid).size(), 1u);
+    EXPECT_EQ(input.get_bindings("Jump"_sid)[0].code, Keyboard::SPACE);
+    EXPECT_FALSE(input.is_pressed("Jump"_sid));
+    EXPECT_FALSE(input.is_just_pressed("Jump"_sid));
+
+    // Saved under the interned name, not the id
+    EXPECT_TRUE(input.save_bindings().contains("Jump"));
+}
+
+TEST_F(InputManagerTest, NamesSharingAnIdStayDistinct)
+{
+    GlfwKeyboard keyboard(*window);
+    GlfwMouse mouse(*window);
+    InputManager input(keyboard, mouse);
+
+    // "declinate" and "macallums" hash to the same StringId
+    ASSERT_EQ(StringId("declinate"), StringId("macallums"));
+    input.bind_default("declinate", {InputSource::Keyboard, Keyboard::SPACE});
+
+    EXPECT_FALSE(input.has_action("macallums"));
+    EXPECT_FALSE(input.is_pressed("macallums"));
+    EXPECT_FALSE(input.is_just_pressed("macallums"));
+    EXPECT_TRUE(input.get_bindings("macallums").empty());
+    EXPECT_TRUE(input.get_default_bindings("macallums").empty());
+
+    input.remove_binding("macallums", {InputSource::Keyboard, Keyboard::SPACE});
+    ASSERT_EQ(input.get_bindings("declinate").size(), 1u);
+
+    EXPECT_THROW(input.bind_default("macallums", {InputSource::Keyboard, Keyboard::UP}), std::logic_error);
+    EXPECT_THROW(input.set_bindings("macallums", {}), std::logic_error);
+    EXPECT_EQ(input.get_bindings("declinate")[0].code, Keyboard::SPACE);
+}
+
 TEST_F(InputManagerTest, AddAndRemoveBindingMutateTheCurrentSetOnly)
 {
     GlfwKeyboard keyboard(*window);
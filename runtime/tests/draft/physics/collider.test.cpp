@@ -8,6 +8,8 @@
 #include "draft/physics/rigid_body.hpp"
 #include "draft/physics/body_def.hpp"
 
+#include <vector>
+
 TEST(Collider, DefaultConstructor)
 {
     Draft::Collider collider;
@@ -131,6 +133,70 @@ TEST(Collider, TestPoint)
     ASSERT_FALSE(collider.test_point({0.f, 0.f}));
 }
 
+TEST(Collider, TransformChangesReshapeTheExistingFixtures)
+{
+    Draft::World world({0.f, 0.f});
+    Draft::BodyDef bodyDef;
+    bodyDef.type = Draft::BodyType::DYNAMIC;
+    Draft::RigidBody* body = world.create_rigid_body(bodyDef);
+
+    Draft::Collider collider;
+    Draft::PolygonShape box;
+    box.set_as_box(0.5f, 0.5f);
+    collider.add_shape(box);
+    collider.add_shape(box);
+    collider.attach(body);
+
+    std::vector<Draft::Fixture*> before;
+    for(auto& fixture : body->get_fixture_list())
+        before.push_back(fixture.get());
+
+    float mass = body->get_mass();
+
+    // Twice the size and off to the side: same fixtures, new geometry and mass
+    collider.set_scale(2.f);
+    collider.set_position({5.f, 0.f});
+
+    ASSERT_EQ(body->get_fixture_list().size(), before.size());
+    for(size_t i = 0; i < before.size(); i++)
+        EXPECT_EQ(body->get_fixture_list()[i].get(), before[i]);
+
+    EXPECT_NEAR(body->get_mass(), mass * 4.f, 1e-4f);
+    EXPECT_TRUE(before[0]->test_point({5.9f, 0.9f}));
+    EXPECT_FALSE(before[0]->test_point({0.f, 0.f}));
+
+    world.destroy_body(body);
+}
+
+TEST(Collider, RepeatedTransformChangesDoNotDrift)
+{
+    Draft::Collider collider;
+    Draft::PolygonShape triangle;
+    triangle.add_vertex({0.f, 0.f});
+    triangle.add_vertex({1.f, 0.f});
+    triangle.add_vertex({0.f, 1.f});
+    collider.add_shape(triangle);
+
+    // Each change used to undo the last one through an inverted matrix, compounding its error
+    for(int i = 0; i < 1000; i++){
+        collider.set_scale({1.f + (i % 7) * 0.37f, 1.f + (i % 5) * 0.61f});
+        collider.set_rotation(i * 0.13f);
+        collider.set_origin({(i % 3) * 0.5f, (i % 11) * 0.25f});
+        collider.set_position({i * 3.f, -i * 2.f});
+    }
+
+    collider.set_position({0.f, 0.f});
+    collider.set_origin({0.f, 0.f});
+    collider.set_rotation(0.f);
+    collider.set_scale(1.f);
+
+    auto* polygon = static_cast<const Draft::PolygonShape*>(collider.get_shapes()[0].get());
+    for(size_t i = 0; i < triangle.get_vertex_count(); i++){
+        EXPECT_NEAR(polygon->get_vertex(i).x, triangle.get_vertex(i).x, 1e-5f);
+        EXPECT_NEAR(polygon->get_vertex(i).y, triangle.get_vertex(i).y, 1e-5f);
+    }
+}
+
 // Regression: the old engine's Collider had no user-declared destructor, so destroying an
 // attached Collider while its RigidBody stayed alive never destroyed the corresponding box2d
 // fixtures
@@ -5,12 +5,19 @@
 #include "draft/physics/rigid_body.hpp"
 #include "draft/physics/body_def.hpp"
 #include "draft/physics/shapes/circle_shape.hpp"
+#include "draft/physics/shapes/edge_shape.hpp"
+#include "draft/physics/shapes/polygon_shape.hpp"
 #include "draft/physics/fixture_def.hpp"
 #include "draft/rendering/render_window.hpp"
+#include "draft/util/thread_pool.hpp"
 
 #include "GLFW/glfw3.h"
 #include "glad/gl.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 TEST(World, Gravity)
 {
     Draft::World world({0.f, -9.8f});
@@ -86,6 +93,344 @@ TEST(World, GetBodyLooksUpByB2Handle)
     ASSERT_TRUE(hit);
 }
 
+TEST(World, StaleHandlesResolveToNothing)
+{
+    Draft::World world({0.f, 0.f});
+    Draft::BodyDef def;
+
+    Draft::RigidBody* body = world.create_rigid_body(def);
+    Draft::BodyHandle handle = body->get_handle();
+    ASSERT_FALSE(handle.is_null());
+    EXPECT_EQ(world.get_body(handle), body);
+
+    world.destroy_body(handle);
+    EXPECT_EQ(world.get_body(handle), nullptr);
+    EXPECT_EQ(world.get_body(Draft::BodyHandle{}), nullptr);
+
+    // The slot is reused, the old handle still doesn't see the new body
+    Draft::RigidBody* replacement = world.create_rigid_body(def);
+    EXPECT_EQ(replacement->get_handle().index, handle.index);
+    EXPECT_NE(replacement->get_handle(), handle);
+    EXPECT_EQ(world.get_body(handle), nullptr);
+
+    // Destroying through a stale handle is a no-op
+    world.destroy_body(handle);
+    EXPECT_EQ(world.get_body_count(), 1u);
+}
+
+TEST(World, CreateAndDestroyHundredThousandBodiesInRandomOrder)
+{
+    constexpr size_t count = 100000;
+    Draft::World world({0.f, 0.f});
+    Draft::BodyDef def;
+    std::mt19937 rng(42);
+
+    std::vector<Draft::BodyHandle> handles;
+    handles.reserve(count);
+    for(size_t i = 0; i < count; i++)
+        handles.push_back(world.create_rigid_body(def)->get_handle());
+
+    ASSERT_EQ(world.get_body_count(), count);
+
+    // Destroy a random half, then refill it so every freed slot gets reused
+    std::shuffle(handles.begin(), handles.end(), rng);
+    std::vector<Draft::BodyHandle> stale(handles.begin(), handles.begin() + count / 2);
+    handles.erase(handles.begin(), handles.begin() + count / 2);
+
+    for(Draft::BodyHandle handle : stale)
+        world.destroy_body(handle);
+
+    ASSERT_EQ(world.get_body_count(), count - count / 2);
+
+    for(size_t i = 0; i < count / 2; i++)
+        handles.push_back(world.create_rigid_body(def)->get_handle());
+
+    ASSERT_EQ(world.get_body_count(), count);
+
+    for(Draft::BodyHandle handle : stale)
+        ASSERT_EQ(world.get_body(handle), nullptr);
+
+    for(Draft::BodyHandle handle : handles){
+        Draft::RigidBody* body = world.get_body(handle);
+        ASSERT_NE(body, nullptr);
+        ASSERT_EQ(body->get_handle(), handle);
+    }
+
+    // Then tear everything down, again in random order
+    std::shuffle(handles.begin(), handles.end(), rng);
+    for(Draft::BodyHandle handle : handles)
+        world.get_body(handle)->destroy();
+
+    EXPECT_EQ(world.get_body_count(), 0u);
+}
+
+namespace {
+    // A static 10x1 floor with its top at y = 0, and a unit ball dropped onto it from y = 2
+    struct DropScene {
+        Draft::World world{{0.f, -10.f}};
+        Draft::RigidBody* ground = nullptr;
+        Draft::RigidBody* ball = nullptr;
+
+        DropScene(bool sensorGround = false){
+            Draft::BodyDef groundDef;
+            groundDef.position = {0.f, -0.5f};
+            ground = world.create_rigid_body(groundDef);
+
+            Draft::PolygonShape box;
+            box.set_as_box(5.f, 0.5f);
+            Draft::FixtureDef groundFixture;
+            groundFixture.shape = &box;
+            groundFixture.isSensor = sensorGround;
+            ground->create_fixture(groundFixture);
+
+            Draft::BodyDef ballDef;
+            ballDef.type = Draft::BodyType::DYNAMIC;
+            ballDef.position = {0.f, 2.f};
+            ball = world.create_rigid_body(ballDef);
+
+            Draft::CircleShape circle;
+            circle.set_radius(0.5f);
+            Draft::FixtureDef ballFixture;
+            ballFixture.shape = &circle;
+            ballFixture.density = 1.f;
+            ball->create_fixture(ballFixture);
+        }
+
+        size_t count(Draft::ContactEventType type) const {
+            size_t total = 0;
+            for(const Draft::ContactEvent& event : world.get_contact_events())
+                total += event.type == type;
+
+            return total;
+        }
+    };
+}
+
+TEST(World, ContactEventsFollowABallLandingAndLeaving)
+{
+    DropScene scene;
+    const Draft::Time dt = Draft::Time::seconds(1.f/60.f);
+
+    // Nothing touches while it's falling
+    scene.world.step(dt, 8, 3);
+    ASSERT_TRUE(scene.world.get_contact_events().empty());
+
+    int steps = 0;
+    while(scene.count(Draft::ContactEventType::BEGIN_CONTACT) == 0 && steps++ < 120)
+        scene.world.step(dt, 8, 3);
+
+    ASSERT_LT(steps, 120);
+    const Draft::ContactEvent& begin = scene.world.get_contact_events().front();
+    EXPECT_EQ(begin.type, Draft::ContactEventType::BEGIN_CONTACT);
+    EXPECT_TRUE((begin.bodyA == scene.ground && begin.bodyB == scene.ball) || (begin.bodyA == scene.ball && begin.bodyB == scene.ground));
+    EXPECT_EQ(begin.fixtureA->get_body(), begin.bodyA);
+    EXPECT_EQ(begin.fixtureB->get_body(), begin.bodyB);
+    EXPECT_NEAR(begin.point.y, 0.f, 0.1f);
+    EXPECT_NEAR(Draft::Math::abs(begin.normal.y), 1.f, 0.001f);
+
+    // Resting on the floor: the solver keeps reporting the contact, but it only begins once
+    scene.world.step(dt, 8, 3);
+    EXPECT_EQ(scene.count(Draft::ContactEventType::BEGIN_CONTACT), 0u);
+    ASSERT_EQ(scene.count(Draft::ContactEventType::IMPULSE), 1u);
+    EXPECT_GT(scene.world.get_contact_events().front().normalImpulse, 0.f);
+
+    // Lifting the ball away ends it
+    scene.ball->set_transform({0.f, 10.f}, 0.f);
+    scene.world.step(dt, 8, 3);
+    EXPECT_EQ(scene.count(Draft::ContactEventType::END_CONTACT), 1u);
+    EXPECT_EQ(scene.count(Draft::ContactEventType::IMPULSE), 0u);
+}
+
+TEST(World, SensorEventsPutTheSensorFirst)
+{
+    DropScene scene(true);
+    const Draft::Time dt = Draft::Time::seconds(1.f/60.f);
+
+    std::vector<Draft::ContactEventType> seen;
+    for(int i = 0; i < 120; i++){
+        scene.world.step(dt, 8, 3);
+
+        for(const Draft::ContactEvent& event : scene.world.get_contact_events()){
+            // Sensors are overlapped, never solved
+            ASSERT_NE(event.type, Draft::ContactEventType::BEGIN_CONTACT);
+            ASSERT_NE(event.type, Draft::ContactEventType::IMPULSE);
+            EXPECT_EQ(event.bodyA, scene.ground);
+            EXPECT_TRUE(event.fixtureA->is_sensor());
+            seen.push_back(event.type);
+        }
+    }
+
+    // The ball falls straight through the floor
+    EXPECT_EQ(seen, (std::vector<Draft::ContactEventType>{Draft::ContactEventType::SENSOR_BEGIN, Draft::ContactEventType::SENSOR_END}));
+}
+
+TEST(World, DestroyingATouchingBodyRecordsNoEvent)
+{
+    DropScene scene;
+    const Draft::Time dt = Draft::Time::seconds(1.f/60.f);
+
+    for(int i = 0; i < 120; i++)
+        scene.world.step(dt, 8, 3);
+
+    ASSERT_TRUE(scene.ball->is_touching(*scene.ground));
+    size_t before = scene.world.get_contact_events().size();
+
+    // Box2d ends the contact right away, an event for it would point at a dead body
+    scene.world.destroy_body(scene.ball);
+    EXPECT_EQ(scene.world.get_contact_events().size(), before);
+}
+
+namespace {
+    // A row of unit boxes at x = 0, 3, 6, ..., every other one in category 2 instead of 1
+    Draft::World& box_row(Draft::World& world, int count){
+        Draft::PolygonShape box;
+        box.set_as_box(0.5f, 0.5f);
+
+        for(int i = 0; i < count; i++){
+            Draft::BodyDef def;
+            def.position = {i * 3.f, 0.f};
+            Draft::RigidBody* body = world.create_rigid_body(def);
+
+            Draft::FixtureDef fixtureDef;
+            fixtureDef.shape = &box;
+            fixtureDef.filter.categoryBits = i % 2 == 0 ? 0x0001 : 0x0002;
+            body->create_fixture(fixtureDef);
+        }
+
+        return world;
+    }
+}
+
+TEST(World, RaycastBatchFindsTheClosestHitPerRay)
+{
+    Draft::World world({0.f, 0.f});
+    box_row(world, 4);
+
+    // Down onto box 0, down onto box 1, through the whole row, and at nothing
+    std::vector<Draft::RayQuery> rays = {
+        {{0.f, 5.f}, {0.f, -5.f}},
+        {{3.f, 5.f}, {3.f, -5.f}},
+        {{-5.f, 0.f}, {20.f, 0.f}},
+        {{0.f, 10.f}, {10.f, 10.f}}
+    };
+    std::vector<Draft::QueryHit> hits(rays.size());
+    world.raycast_batch(rays, hits);
+
+    ASSERT_NE(hits[0].fixture, nullptr);
+    EXPECT_NEAR(hits[0].point.y, 0.5f, 0.01f);
+    EXPECT_NEAR(hits[0].normal.y, 1.f, 0.001f);
+    EXPECT_NEAR(hits[0].fraction, 0.45f, 0.01f);
+
+    ASSERT_NE(hits[1].fixture, nullptr);
+    EXPECT_NEAR(hits[1].fixture->get_body()->get_position().x, 3.f, 0.001f);
+
+    ASSERT_NE(hits[2].fixture, nullptr);
+    EXPECT_NEAR(hits[2].point.x, -0.5f, 0.01f);
+
+    EXPECT_EQ(hits[3].fixture, nullptr);
+    EXPECT_FLOAT_EQ(hits[3].fraction, 1.f);
+
+    // Filtered down to category 2, the sideways ray passes box 0 and stops at box 1
+    world.raycast_batch(rays, hits, Draft::QueryFilter{.maskBits = 0x0002});
+    EXPECT_EQ(hits[0].fixture, nullptr);
+    ASSERT_NE(hits[2].fixture, nullptr);
+    EXPECT_NEAR(hits[2].point.x, 2.5f, 0.01f);
+
+    std::vector<Draft::QueryHit> tooShort(1);
+    EXPECT_THROW(world.raycast_batch(rays, tooShort), std::invalid_argument);
+}
+
+TEST(World, RaycastBatchGivesTheSameResultsAcrossThreads)
+{
+    Draft::World world({0.f, 0.f});
+    box_row(world, 32);
+
+    std::vector<Draft::RayQuery> rays;
+    for(int i = 0; i < 1000; i++)
+        rays.push_back({{i * 0.1f - 5.f, 5.f}, {i * 0.1f - 5.f, -5.f}});
+
+    std::vector<Draft::QueryHit> serial(rays.size());
+    std::vector<Draft::QueryHit> threaded(rays.size());
+    Draft::ThreadPool pool(3);
+
+    world.raycast_batch(rays, serial);
+    world.raycast_batch(rays, threaded, {}, &pool);
+
+    for(size_t i = 0; i < rays.size(); i++){
+        ASSERT_EQ(serial[i].fixture, threaded[i].fixture);
+        ASSERT_EQ(serial[i].fraction, threaded[i].fraction);
+    }
+}
+
+TEST(World, OverlapBatchSplitsResultsPerBox)
+{
+    Draft::World world({0.f, 0.f});
+    box_row(world, 4);
+
+    // Boxes 0 and 1, all four, and the gap between box 0 and box 1
+    std::vector<Draft::FloatRect> boxes = {
+        Draft::FloatRect(-1.f, -1.f, 5.f, 2.f),
+        Draft::FloatRect(-1.f, -1.f, 12.f, 2.f),
+        Draft::FloatRect(0.75f, -1.f, 1.5f, 2.f)
+    };
+    std::vector<Draft::Fixture*> results(boxes.size() * 2, nullptr);
+    std::vector<size_t> counts(boxes.size());
+    world.overlap_batch(boxes, results, counts);
+
+    EXPECT_EQ(counts[0], 2u);
+    EXPECT_NE(results[0], nullptr);
+    EXPECT_NE(results[1], nullptr);
+    EXPECT_NE(results[0], results[1]);
+
+    // More than fit in its share of results
+    EXPECT_EQ(counts[1], 4u);
+    EXPECT_NE(results[2], nullptr);
+    EXPECT_NE(results[3], nullptr);
+
+    EXPECT_EQ(counts[2], 0u);
+    EXPECT_EQ(results[4], nullptr);
+
+    world.overlap_batch(boxes, results, counts, Draft::QueryFilter{.maskBits = 0x0001});
+    EXPECT_EQ(counts[0], 1u);
+    EXPECT_EQ(counts[1], 2u);
+}
+
+TEST(World, ShapeCastBatchStopsAtTheFirstFixtureInTheWay)
+{
+    Draft::World world({0.f, 0.f});
+    box_row(world, 4);
+
+    Draft::CircleShape circle;
+    circle.set_radius(0.5f);
+    Draft::PolygonShape square;
+    square.set_as_box(0.25f, 0.25f);
+
+    // A ball dropped onto box 0, a square slid along the row, and a ball passing over everything
+    std::vector<Draft::ShapeCastQuery> casts = {
+        {&circle, {0.f, 4.f}, 0.f, {0.f, -8.f}},
+        {&square, {4.5f, 0.f}, 0.f, {4.f, 0.f}},
+        {&circle, {-2.f, 4.f}, 0.f, {20.f, 0.f}}
+    };
+    std::vector<Draft::QueryHit> hits(casts.size());
+    world.shape_cast_batch(casts, hits);
+
+    // The ball's bottom meets the box's top after 3 of the 8 units
+    ASSERT_NE(hits[0].fixture, nullptr);
+    EXPECT_NEAR(hits[0].fixture->get_body()->get_position().x, 0.f, 0.001f);
+    EXPECT_NEAR(hits[0].fraction, 3.f / 8.f, 0.01f);
+
+    // Box 1 is behind the square, it reaches box 2 after 0.75 of its 4 units
+    ASSERT_NE(hits[1].fixture, nullptr);
+    EXPECT_NEAR(hits[1].fixture->get_body()->get_position().x, 6.f, 0.001f);
+    EXPECT_NEAR(hits[1].fraction, 0.75f / 4.f, 0.01f);
+
+    EXPECT_EQ(hits[2].fixture, nullptr);
+
+    Draft::EdgeShape edge;
+    std::vector<Draft::ShapeCastQuery> unsupported = {{&edge, {0.f, 4.f}, 0.f, {0.f, -8.f}}};
+    EXPECT_THROW(world.shape_cast_batch(unsupported, std::span<Draft::QueryHit>(hits).first(1)), std::invalid_argument);
+}
+
 class WorldDebugRenderTest : public ::testing::Test {
 protected:
     static Draft::RenderWindow* window;
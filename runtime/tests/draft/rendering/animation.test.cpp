@@ -242,6 +242,18 @@ TEST_F(AnimationTest, ParsesFrameTagsWithNameRangeDirectionColorAndUserData)
     EXPECT_FALSE(anim.has_tag("does_not_exist"));
 }
 
+TEST_F(AnimationTest, TagsLookUpByStringIdToo)
+{
+    Animation anim = load("full.json", FULL_JSON, "walk.png");
+
+    ASSERT_TRUE(anim.has_tag("walk"_sid));
+    EXPECT_EQ(&anim.get_tag("walk"_sid), &anim.get_tag("walk"));
+    EXPECT_FLOAT_EQ(anim.get_frame("walk"_sid, 150.f).bounds.x, anim.get_frame("walk", 150.f).bounds.x);
+
+    EXPECT_FALSE(anim.has_tag("does_not_exist"_sid));
+    EXPECT_THROW(anim.get_frame("does_not_exist"_sid, 0.f), std::runtime_error);
+}
+
 TEST_F(AnimationTest, GetFrameByTagLoopsWithinThatTagsOwnDuration)
 {
     Animation anim = load("full.json", FULL_JSON, "walk.png");
@@ -39,7 +39,7 @@ TEST(Mesh, IndexedConstructorSetsIsIndexed)
     EXPECT_TRUE(mesh.is_indexed());
     EXPECT_FALSE(mesh.is_uv_mapped());
     EXPECT_EQ(mesh.get_indices().size(), 3u);
-    EXPECT_EQ(mesh.get_indices()[2], 2);
+    EXPECT_EQ(mesh.get_indices()[2], 2u);
 }
 
 TEST(Mesh, UvMappedConstructorSetsIsUvMapped)
@@ -80,6 +80,26 @@ TEST(Mesh, FullyIndexedUvColorMappedConstructorSetsAllThreeFlags)
     EXPECT_EQ(mesh.get_colors().size(), 3u);
 }
 
+TEST(Mesh, SeparateArraysAreInterleavedWithDefaultsForUnmappedAttributes)
+{
+    std::vector<Vector3f> verts{{0, 0, 0}, {1, 0, 0}};
+    std::vector<Vector2f> uvs{{0.25f, 0.5f}, {1, 0}};
+    Mesh mesh(verts, uvs);
+
+    const auto& data = mesh.get_vertex_data();
+    ASSERT_EQ(data.size(), 2u);
+    EXPECT_FLOAT_EQ(data[0].texCoord.x, 0.25f);
+    EXPECT_FLOAT_EQ(data[1].position.x, 1.f);
+    EXPECT_FLOAT_EQ(data[1].color.r, 1.f);
+}
+
+TEST(Mesh, IndicesAreStoredSixteenBitsWideOnlyWhenEveryIndexFits)
+{
+    EXPECT_TRUE(MeshIndices(std::vector<std::uint32_t>{0, 1, 65535}).is_short());
+    EXPECT_FALSE(MeshIndices(std::vector<std::uint32_t>{0, 1, 65536}).is_short());
+    EXPECT_EQ(MeshIndices(std::vector<std::uint32_t>{0, 1, 65536})[2], 65536u);
+}
+
 // DrawableMesh issues real GL calls (builds a VertexArray), so its tests share one hidden
 // RenderWindow/GL context instead of creating one per test - same pattern as texture.test.cpp.
 class DrawableMeshTest : public ::testing::Test {
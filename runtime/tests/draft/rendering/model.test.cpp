@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <thread>
 
 using namespace Draft;
 
@@ -20,7 +21,7 @@ namespace Draft {
             return Model::compute_local_matrix(translation, rotation, scale, matrix);
         }
 
-        static std::vector<int> read_indices(const unsigned char* data, int componentType, size_t count){
+        static MeshIndices read_indices(const unsigned char* data, int componentType, size_t count){
             return Model::read_indices(data, componentType, count);
         }
 
@@ -80,7 +81,8 @@ TEST(ModelReadIndices, ReadsUnsignedByteIndices)
     unsigned char bytes[] = { 0, 1, 2, 255 };
     auto indices = ModelTestAccess::read_indices(bytes, GL_UNSIGNED_BYTE, 4);
     ASSERT_EQ(indices.size(), 4u);
-    EXPECT_EQ(indices[3], 255);
+    EXPECT_TRUE(indices.is_short());
+    EXPECT_EQ(indices[3], 255u);
 }
 
 TEST(ModelReadIndices, ReadsUnsignedShortIndices)
@@ -88,7 +90,8 @@ TEST(ModelReadIndices, ReadsUnsignedShortIndices)
     uint16_t values[] = { 0, 1, 2, 65535 };
     auto indices = ModelTestAccess::read_indices(reinterpret_cast<const unsigned char*>(values), GL_UNSIGNED_SHORT, 4);
     ASSERT_EQ(indices.size(), 4u);
-    EXPECT_EQ(indices[3], 65535);
+    EXPECT_TRUE(indices.is_short());
+    EXPECT_EQ(indices[3], 65535u);
 }
 
 TEST(ModelReadIndices, ReadsUnsignedIntIndicesBeyondUnsignedShortRange)
@@ -96,7 +99,8 @@ TEST(ModelReadIndices, ReadsUnsignedIntIndicesBeyondUnsignedShortRange)
     uint32_t values[] = { 0, 1, 100000 };
     auto indices = ModelTestAccess::read_indices(reinterpret_cast<const unsigned char*>(values), GL_UNSIGNED_INT, 3);
     ASSERT_EQ(indices.size(), 3u);
-    EXPECT_EQ(indices[2], 100000);
+    EXPECT_FALSE(indices.is_short());
+    EXPECT_EQ(indices[2], 100000u);
 }
 
 namespace {
@@ -193,6 +197,61 @@ TEST(ModelLoad, IndexedQuadWithMissingTexcoordLoadsWithoutError)
     fs.remove("model_quad.gltf");
 }
 
+TEST(ModelLoad, DecodeRunsOffThreadIntoInterleavedShortIndexedMeshes)
+{
+    HostFileSystem fs;
+    std::vector<float> positions = {
+        0.f, 0.f, 0.f,
+        1.f, 0.f, 0.f,
+        1.f, 1.f, 0.f,
+        0.f, 1.f, 0.f
+    };
+    std::vector<uint32_t> indices = { 0, 1, 2, 0, 2, 3 };
+
+    fs.write_bytes("model_decode.bin", positions.data(), positions.size() * sizeof(float));
+    fs.write_bytes("model_decode_indices.bin", indices.data(), indices.size() * sizeof(uint32_t));
+
+    const std::string json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [{"mesh": 0}],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "mode": 4}]}],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3", "min": [0,0,0], "max": [1,1,0]},
+            {"bufferView": 1, "componentType": 5125, "count": 6, "type": "SCALAR"}
+        ],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 48},
+            {"buffer": 1, "byteOffset": 0, "byteLength": 24}
+        ],
+        "buffers": [
+            {"uri": "model_decode.bin", "byteLength": 48},
+            {"uri": "model_decode_indices.bin", "byteLength": 24}
+        ]
+    })";
+    fs.write_string("model_decode.gltf", json);
+
+    // No GL context is current on the worker, decode() must not need one
+    ModelData data;
+    std::thread worker([&](){ data = Model::decode(fs.open("model_decode.gltf")); });
+    worker.join();
+
+    fs.remove("model_decode.bin");
+    fs.remove("model_decode_indices.bin");
+    fs.remove("model_decode.gltf");
+
+    ASSERT_EQ(data.meshes.size(), 1u);
+    const Mesh& mesh = data.meshes[0];
+    ASSERT_EQ(mesh.get_vertex_data().size(), 4u);
+    EXPECT_FLOAT_EQ(mesh.get_vertex_data()[2].position.y, 1.f);
+
+    // 32-bit source indices that all fit are narrowed for upload
+    ASSERT_TRUE(mesh.is_indexed());
+    EXPECT_TRUE(mesh.get_indices().is_short());
+    EXPECT_EQ(mesh.get_indices()[5], 3u);
+}
+
 TEST(ModelLoad, MultiPrimitiveMeshAppliesTheSameNodeTransformToEveryPrimitive)
 {
     glfwInit();
@@ -1,13 +1,21 @@
 #define GLFW_INCLUDE_NONE
 
 #include <gtest/gtest.h>
+#include "draft/asset/asset_manager.hpp"
 #include "draft/rendering/shader.hpp"
+#include "draft/rendering/shader_cache.hpp"
 #include "draft/rendering/render_window.hpp"
+#include "draft/util/files/asset_file_system.hpp"
+#include "draft/util/files/memory_file_provider.hpp"
 #include "draft/util/files/virtual_file_system.hpp"
 
 #include "GLFW/glfw3.h"
 #include "glad/gl.h"
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 using namespace Draft;
 
 namespace {
@@ -161,3 +169,87 @@ TEST_F(ShaderTest, ConstructionFromBrokenSourceThrowsInsteadOfExiting)
     fs.remove("test_shader_vertex5.glsl");
     fs.remove("test_shader_broken_fragment.glsl");
 }
+
+TEST_F(ShaderTest, DeferredLinkResolvesOnWaitAndBehavesLikeImmediate)
+{
+    VirtualFileSystem fs;
+    fs.write_string("test_shader_vertex6.glsl", VALID_VERTEX_SRC);
+    fs.write_string("test_shader_fragment6.glsl", VALID_FRAGMENT_SRC);
+
+    Shader shader(fs.open("test_shader_vertex6.glsl"), fs.open("test_shader_fragment6.glsl"), ShaderLinkMode::Deferred);
+    EXPECT_TRUE(shader.wait());
+    EXPECT_TRUE(shader.is_ready());
+    EXPECT_NE(shader.get_shader_handle(), 0u);
+    EXPECT_TRUE(shader.has_uniform("testFloat"));
+
+    fs.remove("test_shader_vertex6.glsl");
+    fs.remove("test_shader_fragment6.glsl");
+}
+
+TEST_F(ShaderTest, DeferredLinkOfBrokenSourceReportsFailureInsteadOfThrowing)
+{
+    VirtualFileSystem fs;
+    fs.write_string("test_shader_vertex7.glsl", VALID_VERTEX_SRC);
+    fs.write_string("test_shader_broken_fragment7.glsl", BROKEN_FRAGMENT_SRC);
+
+    Shader shader(fs.open("test_shader_vertex7.glsl"), fs.open("test_shader_broken_fragment7.glsl"), ShaderLinkMode::Deferred);
+    EXPECT_FALSE(shader.wait());
+    EXPECT_EQ(shader.get_shader_handle(), 0u);
+    EXPECT_NO_THROW(shader.bind());
+    shader.unbind();
+
+    fs.remove("test_shader_vertex7.glsl");
+    fs.remove("test_shader_broken_fragment7.glsl");
+}
+
+TEST_F(ShaderTest, AssetLoadOfBrokenSourceFailsInsteadOfHandingOutProgramZero)
+{
+    MemoryFileProvider files;
+    files.write_string("test_shader_asset/vertex.glsl", VALID_VERTEX_SRC);
+    files.write_string("test_shader_asset/fragment.glsl", BROKEN_FRAGMENT_SRC);
+
+    std::vector<std::unique_ptr<FileProvider>> providers;
+    providers.push_back(std::make_unique<MemoryFileProvider>());
+    AssetManager assets(AssetFileSystem(std::move(providers)));
+
+    EXPECT_THROW(assets.get<Shader>("test_shader_asset"), std::runtime_error);
+
+    // Batched loads record the failure and leave the key unloaded
+    assets.queue<Shader>("test_shader_asset");
+    assets.load();
+    ASSERT_EQ(assets.get_load_errors().size(), 1u);
+    EXPECT_EQ(assets.get_load_errors()[0].key, "test_shader_asset");
+
+    files.remove("test_shader_asset/vertex.glsl");
+    files.remove("test_shader_asset/fragment.glsl");
+}
+
+TEST_F(ShaderTest, BinaryCacheStoresOnFirstLinkAndRestoresOnSecond)
+{
+    int formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if(formats == 0)
+        GTEST_SKIP() << "Driver exposes no program binary formats";
+
+    VirtualFileSystem fs;
+    fs.write_string("test_shader_vertex8.glsl", VALID_VERTEX_SRC);
+    fs.write_string("test_shader_fragment8.glsl", VALID_FRAGMENT_SRC);
+
+    auto cache = std::make_shared<ShaderBinaryCache>(fs.open("test_shader_cache"));
+    ShaderBinaryCache::set_default(cache);
+    std::string key = cache->make_key(VALID_VERTEX_SRC, VALID_FRAGMENT_SRC);
+
+    {
+        Shader shader(fs.open("test_shader_vertex8.glsl"), fs.open("test_shader_fragment8.glsl"));
+        EXPECT_TRUE(cache->load(key).has_value());
+    }
+
+    Shader restored(fs.open("test_shader_vertex8.glsl"), fs.open("test_shader_fragment8.glsl"));
+    EXPECT_NE(restored.get_shader_handle(), 0u);
+    EXPECT_TRUE(restored.has_uniform("testFloat"));
+
+    ShaderBinaryCache::set_default(nullptr);
+    fs.remove("test_shader_cache/" + key + ".bin");
+    fs.remove("test_shader_vertex8.glsl");
+    fs.remove("test_shader_fragment8.glsl");
+}